@@ -1,12 +1,24 @@
 #include <stdio.h>
 
 void doBenchmarkLuaBind();
+void doBenchmarkTween();
+void doBenchmarkMetaRegister();
+void doBenchmarkVariant();
+#if ENABLE_PYTHON
+void doBenchmarkPythonBind();
+#endif
 
 int main()
 {
 //	printf("Press any key to start..."); getchar();
 
 	doBenchmarkLuaBind();
+	doBenchmarkTween();
+	doBenchmarkMetaRegister();
+	doBenchmarkVariant();
+#if ENABLE_PYTHON
+	doBenchmarkPythonBind();
+#endif
 
 	return 0;
 }
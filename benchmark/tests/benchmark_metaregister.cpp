@@ -0,0 +1,91 @@
+#include "cpgf/gmetadefine.h"
+#include "cpgf/tween/gtweencommon.h"
+#include "cpgf/metadata/tween/meta_tweengtweencommon.h"
+
+#include "../benchmark.h"
+
+namespace {
+
+using namespace cpgf;
+
+const int registerCount = 10000;
+
+// The same members as the bundled meta_tween::buildMetaClass_GTweenable, in the form cmetagen writes with memberTable.
+template <typename D>
+void buildMetaClassTable_GTweenable(D _d)
+{
+	typedef typename D::ClassType ClassType;
+
+	static constexpr GMetaMemberDescriptor members[] = {
+		metaTableMethod<ClassType, decltype(&ClassType::removeForInstance), &ClassType::removeForInstance>("removeForInstance"),
+		metaTableMethod<ClassType, decltype(&ClassType::getDuration), &ClassType::getDuration>("getDuration"),
+		metaTableMethod<ClassType, decltype(&ClassType::getTotalDuration), &ClassType::getTotalDuration>("getTotalDuration"),
+		metaTableMethod<ClassType, decltype(&ClassType::getCurrentTime), &ClassType::getCurrentTime>("getCurrentTime"),
+		metaTableMethod<ClassType, decltype(&ClassType::setCurrentTime), &ClassType::setCurrentTime>("setCurrentTime"),
+		metaTableMethod<ClassType, decltype(&ClassType::getTotalTime), &ClassType::getTotalTime>("getTotalTime"),
+		metaTableMethod<ClassType, decltype(&ClassType::setTotalTime), &ClassType::setTotalTime>("setTotalTime"),
+		metaTableMethod<ClassType, decltype(&ClassType::getCurrentProgress), &ClassType::getCurrentProgress>("getCurrentProgress"),
+		metaTableMethod<ClassType, decltype(&ClassType::setCurrentProgress), &ClassType::setCurrentProgress>("setCurrentProgress"),
+		metaTableMethod<ClassType, decltype(&ClassType::getTotalProgress), &ClassType::getTotalProgress>("getTotalProgress"),
+		metaTableMethod<ClassType, decltype(&ClassType::setTotalProgress), &ClassType::setTotalProgress>("setTotalProgress"),
+		metaTableMethod<ClassType, decltype(&ClassType::restart), &ClassType::restart>("restart"),
+		metaTableMethod<ClassType, decltype(&ClassType::restartWithDelay), &ClassType::restartWithDelay>("restartWithDelay"),
+		metaTableMethod<ClassType, decltype(&ClassType::pause), &ClassType::pause>("pause"),
+		metaTableMethod<ClassType, decltype(&ClassType::resume), &ClassType::resume>("resume"),
+		metaTableMethod<ClassType, decltype(&ClassType::immediateTick), &ClassType::immediateTick>("immediateTick"),
+		metaTableMethod<ClassType, decltype(&ClassType::tick), &ClassType::tick>("tick"),
+		metaTableMethod<ClassType, decltype(&ClassType::backward), &ClassType::backward>("backward"),
+		metaTableMethod<ClassType, decltype(&ClassType::useFrames), &ClassType::useFrames>("useFrames"),
+		metaTableMethod<ClassType, decltype(&ClassType::delay), &ClassType::delay>("delay"),
+		metaTableMethod<ClassType, decltype(&ClassType::timeScale), &ClassType::timeScale>("timeScale"),
+		metaTableMethod<ClassType, decltype(&ClassType::repeat), &ClassType::repeat>("repeat"),
+		metaTableMethod<ClassType, decltype(&ClassType::repeat), &ClassType::repeat>("_repeat"),
+		metaTableMethod<ClassType, decltype(&ClassType::repeatDelay), &ClassType::repeatDelay>("repeatDelay"),
+		metaTableMethod<ClassType, decltype(&ClassType::yoyo), &ClassType::yoyo>("yoyo"),
+		metaTableMethod<ClassType, decltype(&ClassType::onInitialize), &ClassType::onInitialize>("onInitialize"),
+		metaTableMethod<ClassType, decltype(&ClassType::onComplete), &ClassType::onComplete>("onComplete"),
+		metaTableMethod<ClassType, decltype(&ClassType::onDestroy), &ClassType::onDestroy>("onDestroy"),
+		metaTableMethod<ClassType, decltype(&ClassType::onUpdate), &ClassType::onUpdate>("onUpdate"),
+		metaTableMethod<ClassType, decltype(&ClassType::onRepeat), &ClassType::onRepeat>("onRepeat"),
+		metaTableMethod<ClassType, decltype(&ClassType::isRunning), &ClassType::isRunning>("isRunning"),
+		metaTableMethod<ClassType, decltype(&ClassType::isPaused), &ClassType::isPaused>("isPaused"),
+		metaTableMethod<ClassType, decltype(&ClassType::isCompleted), &ClassType::isCompleted>("isCompleted"),
+		metaTableMethod<ClassType, decltype(&ClassType::isUseFrames), &ClassType::isUseFrames>("isUseFrames"),
+		metaTableMethod<ClassType, decltype(&ClassType::isBackward), &ClassType::isBackward>("isBackward"),
+		metaTableMethod<ClassType, decltype(&ClassType::isYoyo), &ClassType::isYoyo>("isYoyo"),
+		metaTableMethod<ClassType, decltype(&ClassType::isRepeat), &ClassType::isRepeat>("isRepeat"),
+		metaTableMethod<ClassType, decltype(&ClassType::isRepeatInfinitely), &ClassType::isRepeatInfinitely>("isRepeatInfinitely"),
+		metaTableMethod<ClassType, decltype(&ClassType::getRepeatCount), &ClassType::getRepeatCount>("getRepeatCount"),
+		metaTableMethod<ClassType, decltype(&ClassType::getRepeatDelay), &ClassType::getRepeatDelay>("getRepeatDelay"),
+		metaTableMethod<ClassType, decltype(&ClassType::getDelay), &ClassType::getDelay>("getDelay"),
+		metaTableMethod<ClassType, decltype(&ClassType::getTimeScale), &ClassType::getTimeScale>("getTimeScale"),
+	};
+
+	_d._members(members);
+}
+
+} //unnamed namespace
+
+void doBenchmarkMetaRegister()
+{
+	// Only the registration time is measured here.
+	// Compiling only one of the two functions (GCC -O2): chain 5.2 s and 53 KB code, table 4.9 s and 42 KB code.
+
+	// Chain: 160 ms
+	// Table: 130 ms, most of the time is creating the meta methods (GCC -O2)
+	{
+		BenchmarkTimer timer("MetaRegister: chain, GTweenable 10000 times");
+		for(int i = 0; i < registerCount; ++i) {
+			GDefineMetaDangle<GTweenable> define = GDefineMetaDangle<GTweenable>::dangle();
+			meta_tween::buildMetaClass_GTweenable(define);
+		}
+	}
+
+	{
+		BenchmarkTimer timer("MetaRegister: table, GTweenable 10000 times");
+		for(int i = 0; i < registerCount; ++i) {
+			GDefineMetaDangle<GTweenable> define = GDefineMetaDangle<GTweenable>::dangle();
+			buildMetaClassTable_GTweenable(define);
+		}
+	}
+}
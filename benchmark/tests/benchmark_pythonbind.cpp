@@ -0,0 +1,77 @@
+#if ENABLE_PYTHON
+
+#include "cpgf/scriptbind/gpythonbind.h"
+#include "cpgf/gmetadefine.h"
+#include "cpgf/goutmain.h"
+
+#include "../benchmark.h"
+#include "pythonbind_common.h"
+
+namespace {
+
+using namespace cpgf;
+
+struct TestHeavyObject
+{
+	// A CPU bound function which doesn't touch any Python object.
+	static double burn(const int count) {
+		double x = 0;
+		for(int i = 0; i < count; ++i) {
+			x = x * 0.999 + (double)(i % 7);
+		}
+		return x;
+	}
+};
+
+void runThreaded(const TestPythonContext & context, const char * methodName, const int threadCount)
+{
+	const int totalCalls = 64;
+	const int burnCount = 2000000;
+
+	char code[1024];
+	sprintf(code,
+		"import threading\n"
+		"def work(n):\n"
+		"	for i in range(n):\n"
+		"		TestHeavyObject.%s(%d)\n"
+		"threads = [threading.Thread(target = work, args = (%d,)) for i in range(%d)]\n"
+		"for t in threads: t.start()\n"
+		"for t in threads: t.join()\n",
+		methodName, burnCount, totalCalls / threadCount, threadCount
+	);
+
+	char message[256];
+	sprintf(message, "Python %s, %d threads", methodName, threadCount);
+	BenchmarkTimer timer(message);
+	context.doString(code);
+}
+
+} //unnamed namespace
+
+void doBenchmarkPythonBind()
+{
+	TestPythonContext context;
+	GScopedInterface<IMetaClass> metaClass(context.getService()->findClassByName("TestHeavyObject"));
+	context.getBinding()->setValue("TestHeavyObject", GScriptValue::fromClass(metaClass.get()));
+
+	// "burn" holds the GIL while running, so more threads don't make it faster.
+	// "burnReleaseLock" releases the GIL and should scale with the cores.
+	runThreaded(context, "burn", 1);
+	runThreaded(context, "burn", 4);
+	runThreaded(context, "burnReleaseLock", 1);
+	runThreaded(context, "burnReleaseLock", 4);
+}
+
+G_AUTO_RUN_BEFORE_MAIN()
+{
+	using namespace cpgf;
+
+	GDefineMetaClass<TestHeavyObject>
+		::define("TestHeavyObject")
+
+		._method("burn", &TestHeavyObject::burn)
+		._method("burnReleaseLock", &TestHeavyObject::burn, GMetaPolicyReleaseScriptLock())
+	;
+}
+
+#endif
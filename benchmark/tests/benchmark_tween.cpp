@@ -0,0 +1,76 @@
+#include "cpgf/tween/gtweenlist.h"
+#include "cpgf/accessor/gaccessor.h"
+#include "cpgf/tween/easing/quad.h"
+
+#include "../benchmark.h"
+
+#include <vector>
+
+namespace {
+
+using namespace cpgf;
+
+struct TestSprite
+{
+	TestSprite() : x(0), y(0) {
+	}
+
+	float x;
+	float y;
+};
+
+const int tweenCount = 100000;
+
+void addTweens(GTweenList * tweenList, std::vector<TestSprite> & sprites)
+{
+	for(TestSprite & sprite : sprites) {
+		tweenList->tween()
+			.target(createAccessor(&sprite, &TestSprite::x, &TestSprite::x), 100.0f)
+			.target(createAccessor(&sprite, &TestSprite::y, &TestSprite::y), 100.0f)
+			.ease(QuadEase::easeInOut())
+			.duration(1000.0f)
+		;
+	}
+}
+
+} //unnamed namespace
+
+void doBenchmarkTween()
+{
+	std::vector<TestSprite> sprites(tweenCount);
+	GTweenList tweenList;
+
+	// 100000 tweens, each has two targets on a sprite.
+
+	{
+		BenchmarkTimer timer("Tween: create 100000");
+		addTweens(&tweenList, sprites);
+	}
+
+	// std::list: 1600 ms
+	// After changed to contiguous slots: 1700 ms, the time is spent in the tweens, not in walking the list (GCC -O2)
+	{
+		BenchmarkTimer timer("Tween: tick 100000, 100 frames");
+		for(int i = 0; i < 100; ++i) {
+			tweenList.tick(1.0f);
+		}
+	}
+
+	// Destroys 1 of each 10 sprites while the others keep animating.
+	// std::list: 95000 ms
+	// After added the instance index: 200 ms, most of it is the 10 ticks (GCC -O2)
+	{
+		BenchmarkTimer timer("Tween: removeForInstance 10000, ticking");
+		for(int i = 0; i < tweenCount; i += 10) {
+			tweenList.removeForInstance(&sprites[i]);
+			if(i % 10000 == 0) {
+				tweenList.tick(1.0f);
+			}
+		}
+	}
+
+	{
+		BenchmarkTimer timer("Tween: clear");
+		tweenList.clear();
+	}
+}
@@ -0,0 +1,118 @@
+#include "cpgf/gvariant.h"
+
+#include "../benchmark.h"
+
+#include <iostream>
+#include <vector>
+
+namespace {
+
+using namespace cpgf;
+
+const int variantCount = 1024;
+const int loopCount = 2000;
+
+GVariant createFundamental(const int type, const int n)
+{
+	switch(type) {
+	case 0: return GVariant((n & 1) != 0);
+	case 1: return GVariant((char)n);
+	case 2: return GVariant((wchar_t)n);
+	case 3: return GVariant((signed char)n);
+	case 4: return GVariant((unsigned char)n);
+	case 5: return GVariant((signed short)n);
+	case 6: return GVariant((unsigned short)n);
+	case 7: return GVariant((signed int)n);
+	case 8: return GVariant((unsigned int)n);
+	case 9: return GVariant((signed long)n);
+	case 10: return GVariant((unsigned long)n);
+	case 11: return GVariant((signed long long)n);
+	case 12: return GVariant((unsigned long long)n);
+	case 13: return GVariant((float)n);
+	case 14: return GVariant((double)n);
+	default: return GVariant((long double)n);
+	}
+}
+
+const int fundamentalTypeCount = 16;
+
+double toConversionsPerSecond(const int64_t nanoseconds, const int64_t count)
+{
+	return nanoseconds > 0 ? (double)count * 1000.0 * 1000.0 * 1000.0 / (double)nanoseconds : 0;
+}
+
+// Convert all variants in list to T, return the nanoseconds.
+template <typename T>
+int64_t doBenchmarkVariantTo(const std::vector<GVariant> & list)
+{
+	T sum = T();
+
+	const int64_t start = getNanoseconds();
+	for(int i = 0; i < loopCount; ++i) {
+		for(const GVariant & v : list) {
+			sum = (T)(sum + fromVariant<T>(v));
+		}
+	}
+	const int64_t time = getNanoseconds() - start;
+
+	// Use sum so the loop is not optimized away.
+	volatile T result = sum;
+	(void)result;
+
+	return time;
+}
+
+template <typename T>
+void doBenchmarkVariantToAllPairs(const char * typeName)
+{
+	int64_t pairTime = 0;
+	std::vector<GVariant> list;
+
+	// One source type each time, the branch on the source type is always predicted.
+	for(int type = 0; type < fundamentalTypeCount; ++type) {
+		list.clear();
+		for(int i = 0; i < variantCount; ++i) {
+			list.push_back(createFundamental(type, i));
+		}
+		pairTime += doBenchmarkVariantTo<T>(list);
+	}
+
+	// Mixed source types, as the arguments from script are.
+	list.clear();
+	for(int i = 0; i < variantCount; ++i) {
+		list.push_back(createFundamental((i * 7) % fundamentalTypeCount, i));
+	}
+	const int64_t mixedTime = doBenchmarkVariantTo<T>(list);
+
+	const int64_t count = (int64_t)variantCount * loopCount;
+	std::cout << "Variant to " << typeName << ", million conversions per second:"
+		<< " all pairs " << (int)(toConversionsPerSecond(pairTime, count * fundamentalTypeCount) / 1000000)
+		<< ", mixed " << (int)(toConversionsPerSecond(mixedTime, count) / 1000000)
+		<< std::endl;
+}
+
+} //unnamed namespace
+
+void doBenchmarkVariant()
+{
+	// fromVariant from any fundamental type to a fundamental type (GCC -O2), million conversions per second.
+	// Switch on the source type: 150 - 220 for the integer, float and double targets.
+	// Table (variantIntegerInfo): 210 - 340 for the same targets, the mixed sources gain most.
+	// long double is about 120 with both.
+	doBenchmarkVariantToAllPairs<bool>("bool");
+	doBenchmarkVariantToAllPairs<char>("char");
+	doBenchmarkVariantToAllPairs<wchar_t>("wchar_t");
+	doBenchmarkVariantToAllPairs<signed char>("signed char");
+	doBenchmarkVariantToAllPairs<unsigned char>("unsigned char");
+	doBenchmarkVariantToAllPairs<signed short>("signed short");
+	doBenchmarkVariantToAllPairs<unsigned short>("unsigned short");
+	doBenchmarkVariantToAllPairs<signed int>("signed int");
+	doBenchmarkVariantToAllPairs<unsigned int>("unsigned int");
+	doBenchmarkVariantToAllPairs<signed long>("signed long");
+	doBenchmarkVariantToAllPairs<unsigned long>("unsigned long");
+	doBenchmarkVariantToAllPairs<signed long long>("signed long long");
+	doBenchmarkVariantToAllPairs<unsigned long long>("unsigned long long");
+	doBenchmarkVariantToAllPairs<float>("float");
+	doBenchmarkVariantToAllPairs<double>("double");
+	doBenchmarkVariantToAllPairs<long double>("long double");
+}
@@ -0,0 +1,47 @@
+#ifndef PYTHONBIND_COMMON_H
+#define PYTHONBIND_COMMON_H
+
+#include "cpgf/metatraits/gmetaconverter_string.h"
+
+#include "cpgf/gmetaapi.h"
+#include "cpgf/scriptbind/gpythonbind.h"
+#include "cpgf/gscopedinterface.h"
+
+#include <memory>
+
+class TestPythonContext
+{
+public:
+	TestPythonContext() {
+		Py_InitializeEx(0);
+		this->moduleMain = PyImport_ImportModule("__main__");
+		this->service.reset(cpgf::createDefaultMetaService());
+		this->binding.reset(cpgf::createPythonScriptObject(this->service.get(), this->moduleMain));
+	}
+
+	~TestPythonContext() {
+		this->binding.reset();
+		Py_XDECREF(this->moduleMain);
+		Py_Finalize();
+	}
+
+	cpgf::IMetaService * getService() const {
+		return this->service.get();
+	}
+
+	cpgf::GScriptObject * getBinding() const {
+		return this->binding.get();
+	}
+
+	bool doString(const char * code) const {
+		return PyRun_SimpleString(code) == 0;
+	}
+
+private:
+	PyObject * moduleMain;
+	cpgf::GScopedInterface<cpgf::IMetaService> service;
+	std::unique_ptr<cpgf::GScriptObject> binding;
+};
+
+
+#endif
@@ -29,6 +29,7 @@ LOCAL_SRC_FILES := \
 	${SRC_PATH}/gexception.cpp \
 	${SRC_PATH}/gmemorypool.cpp \
 	${SRC_PATH}/gmetaannotation.cpp \
+	${SRC_PATH}/gmetaannotationindex.cpp \
 	${SRC_PATH}/gmetaapi.cpp \
 	${SRC_PATH}/gmetaapiutil.cpp \
 	${SRC_PATH}/gmetaclass.cpp \
@@ -40,6 +41,7 @@ LOCAL_SRC_FILES := \
 	${SRC_PATH}/gmetafundamental.cpp \
 	${SRC_PATH}/gmetamethod.cpp \
 	${SRC_PATH}/gmetaoperator.cpp \
+	${SRC_PATH}/gmetaprofile.cpp \
 	${SRC_PATH}/gmetaproperty.cpp \
 	${SRC_PATH}/gmetamodule.cpp \
 	${SRC_PATH}/gmetatype.cpp \
@@ -83,6 +85,7 @@ LOCAL_SRC_FILES := \
 	${SRC_PATH}/tween/gtweenlist.cpp \
 	${SRC_PATH}/tween/gtweencommon.cpp \
 	${SRC_PATH}/tween/gtimeline.cpp \
+	${SRC_PATH}/tween/gtweenscheduler.cpp \
 	${SRC_PATH}/thirdparty/jsoncpp/json_reader.cpp \
 	${SRC_PATH}/thirdparty/jsoncpp/json_value.cpp \
 	${SRC_PATH}/thirdparty/jsoncpp/json_writer.cpp \
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <memory>
+#include <atomic>
 
 #define G_INTERFACE_IMPL_OBJECT_DERIVED \
 protected: \
@@ -66,21 +67,24 @@ public:
 	template <typename T>
 	uint32_t releaseReference(T * p)
 	{
-		if(this->referenceCount > 0) {
-			--this->referenceCount;
+		unsigned int refCount = this->referenceCount.load();
+		// Interfaces shared by script contexts on different threads
+		// (e.g. through GLuaStatePool) are referenced concurrently.
+		while(refCount > 0 && ! this->referenceCount.compare_exchange_weak(refCount, refCount - 1)) {
 		}
 
-		unsigned int refCount = this->referenceCount;
-
-		if(this->referenceCount == 0) {
-			delete p;
+		if(refCount > 0) {
+			--refCount;
+			if(refCount == 0) {
+				delete p;
+			}
 		}
 
 		return refCount;
 	}
 
 private:
-	unsigned int referenceCount;
+	std::atomic<unsigned int> referenceCount;
 };
 
 class GImplExtendObject : public GImplObject
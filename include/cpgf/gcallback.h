@@ -7,6 +7,8 @@
 #include <type_traits>
 #include <functional>
 #include <memory>
+#include <new>
+#include <cstdint>
 
 namespace cpgf {
 
@@ -57,30 +59,49 @@ struct SizeOfCallbackSon : public SizeOfCallbackBase {
 	virtual void a(int) { (void)(0); }
 };
 
-constexpr auto BufferSize = sizeof(&SizeOfCallbackSon::a) + sizeof(SizeOfCallbackBase);
+// The default inline buffer holds the virtual table pointer of GCallbackBase,
+// an object pointer and a member function pointer.
+constexpr auto BufferSize = sizeof(void *) + sizeof(&SizeOfCallbackSon::a) + sizeof(SizeOfCallbackBase);
 
-template <typename BaseType>
-typename std::enable_if<(sizeof(BaseType) <= BufferSize), BaseType *>::type
- allocateMemory(void * buffer)
+// Allocates heap storage aligned to alignment, which must be a power of two.
+// The raw pointer is kept right before the returned block so freeHeapBase
+// doesn't need to know the callable type.
+inline void * allocateHeapBase(const size_t size, size_t alignment)
 {
-	return reinterpret_cast<BaseType *>(buffer);
+	if(alignment < alignof(void *)) {
+		alignment = alignof(void *);
+	}
+	char * raw = static_cast<char *>(::operator new(size + sizeof(void *) + alignment - 1));
+	const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw + sizeof(void *));
+	char * aligned = reinterpret_cast<char *>((address + alignment - 1) & ~(std::uintptr_t)(alignment - 1));
+	reinterpret_cast<void **>(aligned)[-1] = raw;
+	return aligned;
 }
 
-template <typename BaseType>
-typename std::enable_if<(sizeof(BaseType) > BufferSize), BaseType *>::type
- allocateMemory(void * /*buffer*/)
+inline void freeHeapBase(void * p)
 {
-	return reinterpret_cast<BaseType *>(new char[sizeof(BaseType)]);
+	::operator delete(reinterpret_cast<void **>(p)[-1]);
 }
 
+// Constructs T in buffer if it fits, otherwise on heap.
 template <typename T, typename... Parameters>
-T * allocateBase(void * buffer, Parameters && ... parameters)
+T * allocateBase(void * buffer, const size_t bufferSize, Parameters && ... parameters)
 {
-	T * base = allocateMemory<T>(buffer);
+	T * base;
+	if(sizeof(T) <= bufferSize && alignof(T) <= alignof(void *)) {
+		base = reinterpret_cast<T *>(buffer);
+	}
+	else {
+		base = reinterpret_cast<T *>(allocateHeapBase(sizeof(T), alignof(T)));
+	}
 	new(base) T(std::forward<Parameters>(parameters)...);
 	return base;
 }
 
+// In its own namespace so the fallback operator is not found by ADL for GCallback,
+// which derives from a class in callback_internal.
+namespace equal_operator_detector {
+
 template <typename T, typename U>
 std::false_type operator == (const T &, const U &);
 
@@ -90,6 +111,10 @@ struct EqualOperatorExists
 	static constexpr bool value = ! std::is_same<decltype(*& *(T*)(0) == *& *(U*)(0)), std::false_type>::value;
 };
 
+} // namespace equal_operator_detector
+
+using equal_operator_detector::EqualOperatorExists;
+
 template <typename T, typename U>
 bool doCheckEqual(const T & a, const U & b, typename std::enable_if<EqualOperatorExists<T, U>::value>::type * = 0)
 {
@@ -136,7 +161,8 @@ private:
 
 public:
 	typedef void (*Destroy)(ThisType * self);
-	typedef ThisType * (*Clone)(ThisType * self, void * buffer);
+	typedef ThisType * (*Clone)(ThisType * self, void * buffer, size_t bufferSize);
+	typedef ThisType * (*Move)(ThisType * self, void * buffer, size_t bufferSize);
 	typedef RT (*Invoker)(ThisType * self, Parameters && ... parameters);
 	typedef void * (*GetObject)(ThisType * self);
 	typedef void (*SetObject)(ThisType * self, void * object);
@@ -144,7 +170,9 @@ public:
 
 	struct CallbackVirtuals {
 		Destroy destroy;
+		// nullptr if the callable can't be copied.
 		Clone clone;
+		Move move;
 		Invoker invoker;
 		GetObject getObject;
 		SetObject setObject;
@@ -160,6 +188,30 @@ public:
 	const CallbackVirtuals * virtuals;
 };
 
+template <typename T, typename BaseType>
+BaseType * cloneBase(BaseType * self, void * buffer, size_t bufferSize)
+{
+	return allocateBase<T>(buffer, bufferSize, *static_cast<T *>(self));
+}
+
+template <typename T, typename BaseType>
+BaseType * moveBase(BaseType * self, void * buffer, size_t bufferSize)
+{
+	return allocateBase<T>(buffer, bufferSize, std::move(*static_cast<T *>(self)));
+}
+
+template <typename T, typename BaseType>
+typename BaseType::Clone getCloneFunction(typename std::enable_if<std::is_copy_constructible<T>::value>::type * = 0)
+{
+	return &cloneBase<T, BaseType>;
+}
+
+template <typename T, typename BaseType>
+typename BaseType::Clone getCloneFunction(typename std::enable_if<! std::is_copy_constructible<T>::value>::type * = 0)
+{
+	return nullptr;
+}
+
 template <typename Func, typename RT, typename... Parameters>
 struct GCallbackBaseFunc : public GCallbackBase <RT, Parameters...>
 {
@@ -173,11 +225,6 @@ private:
 		static_cast<ThisType *>(self)->~ThisType();
 	}
 
-	static BaseType * clone(BaseType * self, void * buffer)
-	{
-		return allocateBase<ThisType>(buffer, *static_cast<ThisType *>(self));
-	}
-
 	static RT invoker(BaseType * self, Parameters && ... parameters)
 	{
 		return (RT)((*&(static_cast<ThisType *>(self)->func))(std::forward<Parameters>(parameters)...));
@@ -202,7 +249,8 @@ private:
 	static typename super::CallbackVirtuals * doGetVirtuals() {
 		static typename super::CallbackVirtuals callbackVirtuals = {
 			&destroy,
-			&clone,
+			getCloneFunction<ThisType, BaseType>(),
+			&moveBase<ThisType, BaseType>,
 			&invoker,
 			&getObject,
 			&setObject,
@@ -213,11 +261,16 @@ private:
 	}
 
 public:
-	GCallbackBaseFunc(const Func & func)
+	explicit GCallbackBaseFunc(const Func & func)
 		: super(doGetVirtuals()), func(func)
 	{
 	}
 
+	explicit GCallbackBaseFunc(Func && func)
+		: super(doGetVirtuals()), func(std::move(func))
+	{
+	}
+
 private:
 	Func func;
 };
@@ -235,11 +288,6 @@ private:
 		static_cast<ThisType *>(self)->~ThisType();
 	}
 
-	static BaseType * clone(BaseType * self, void * buffer)
-	{
-		return allocateBase<ThisType>(buffer, *static_cast<ThisType *>(self));
-	}
-
 	static RT invoker(BaseType * self, Parameters && ... parameters)
 	{
 		return (RT)(
@@ -270,7 +318,8 @@ private:
 	static typename super::CallbackVirtuals * doGetVirtuals() {
 		static typename super::CallbackVirtuals callbackVirtuals = {
 			&destroy,
-			&clone,
+			getCloneFunction<ThisType, BaseType>(),
+			&moveBase<ThisType, BaseType>,
 			&invoker,
 			&getObject,
 			&setObject,
@@ -291,98 +340,16 @@ private:
 	Func func;
 };
 
-
-} //namespace callback_internal
-
-
-template <typename Signature>
-class GCallback
-{
-};
-
-template <typename RT, typename... Parameters>
-class GCallback <RT (*)(Parameters...)>
+// The storage shared by GCallback and GMoveOnlyCallback.
+// A callable not larger than Capacity bytes (including the virtual table pointer)
+// is stored in the object, a larger one is allocated on heap.
+template <size_t Capacity, typename RT, typename... Parameters>
+class GCallbackHolder
 {
 private:
-	typedef callback_internal::GCallbackBase <RT, Parameters...> BaseType;
-	typedef GCallback <RT (*)(Parameters...)> ThisType;
-
-public:
-	typedef RT FunctionType(Parameters...);
-	typedef FunctionType * FunctionPointer;
-	typedef cpgf::GFunctionTraits<FunctionType> TraitsType;
+	typedef GCallbackBase <RT, Parameters...> BaseType;
 
 public:
-	GCallback() : base(nullptr)
-	{
-	}
-
-	~GCallback()
-	{
-		this->doFreeBase();
-	}
-
-	template <typename FT>
-	GCallback(
-		const FT & func,
-		typename std::enable_if<! GFunctionTraits<FT>::IsMember && IsCallable<FT, Parameters...>::Result>::type * = 0
-	)
-		:
-			base(
-				callback_internal::allocateBase<
-					callback_internal::GCallbackBaseFunc<
-						typename std::conditional<GFunctionTraits<FT>::IsFunction, typename GFunctionTraits<FT>::FunctionPointer, FT>::type,
-						RT, Parameters...>
-				>((void *)this->buffer, func)
-			)
-	{
-	}
-
-	template <typename FT>
-	GCallback(
-		const FT & func,
-		typename std::enable_if<GFunctionTraits<FT>::IsMember>::type * = 0
-	)
-		:
-			base(
-				callback_internal::allocateBase<
-					callback_internal::GCallbackBaseMember<typename GFunctionTraits<FT>::ObjectType *, typename GFunctionTraits<FT>::ObjectType, FT, RT,Parameters...>
-				>((void *)this->buffer, (typename GFunctionTraits<FT>::ObjectType *)nullptr, func)
-			)
-	{
-	}
-
-	template <typename Instance, typename FT>
-	GCallback(Instance instance, const FT & func)
-		:
-			base(
-				callback_internal::allocateBase<
-					callback_internal::GCallbackBaseMember<Instance, typename cpgf::GFunctionTraits<FT>::ObjectType, FT, RT, Parameters...>
-				>((void *)this->buffer, instance, func)
-			)
-	{
-	}
-
-	GCallback(const ThisType & other)
-		: base(other.base != nullptr ? other.base->virtuals->clone(other.base, (void *)this->buffer) : nullptr)
-	{
-	}
-
-	GCallback(ThisType && other)
-		: base(other.base != nullptr ? other.base->virtuals->clone(other.base, (void *)this->buffer) : nullptr)
-	{
-	}
-
-	GCallback & operator = (const ThisType & other)
-	{
-		if(this != &other) {
-			this->doFreeBase();
-			this->base = (other.base != nullptr ? other.base->virtuals->clone(other.base, (void *)this->buffer) : nullptr);
-		}
-
-		return *this;
-	}
-
 	RT invoke(Parameters... args) const
 	{
 		if(this->base != nullptr) {
@@ -432,13 +399,54 @@ public:
 		return ! this->empty();
 	}
 
-	bool operator == (const ThisType & other) const
+	// Returns true if the callable is stored on heap.
+	bool isOnHeap() const {
+		return this->base != nullptr && this->base != (const void *)this->buffer;
+	}
+
+protected:
+	GCallbackHolder() : base(nullptr)
+	{
+	}
+
+	~GCallbackHolder()
+	{
+		this->doFreeBase();
+	}
+
+	template <typename T, typename... P>
+	void doConstruct(P && ... parameters)
+	{
+		this->base = allocateBase<T>((void *)this->buffer, Capacity, std::forward<P>(parameters)...);
+	}
+
+	void doCopy(const GCallbackHolder & other)
+	{
+		this->base = (other.base != nullptr ? other.base->virtuals->clone(other.base, (void *)this->buffer, Capacity) : nullptr);
+	}
+
+	void doMove(GCallbackHolder & other)
+	{
+		if(other.isOnHeap()) {
+			this->base = other.base;
+			other.base = nullptr;
+		}
+		else if(other.base != nullptr) {
+			this->base = other.base->virtuals->move(other.base, (void *)this->buffer, Capacity);
+			other.doFreeBase();
+		}
+		else {
+			this->base = nullptr;
+		}
+	}
+
+	bool isSame(const GCallbackHolder & other) const
 	{
 		if(this->base == other.base) {
 			return true;
 		}
 
-		if(this->base != nullptr && other && other.base != nullptr) {
+		if(this->base != nullptr && other.base != nullptr) {
 			return this->base->virtuals->isSame(this->base, other.base);
 		}
 		else {
@@ -446,19 +454,13 @@ public:
 		}
 	}
 
-	bool operator != (const ThisType & other) const
-	{
-		return ! this-> operator == (other);
-	}
-
-private:
 	void doFreeBase()
 	{
 		if(this->base != nullptr) {
 			this->base->virtuals->destroy(this->base);
 
 			if(this->base != (void *)this->buffer) {
-				delete[] reinterpret_cast<char *>(this->base);
+				freeHeapBase(this->base);
 			}
 
 			this->base = nullptr;
@@ -467,14 +469,120 @@ private:
 
 private:
 	BaseType * base;
-	char buffer[callback_internal::BufferSize];
+	alignas(void *) char buffer[Capacity];
+};
+
+
+} //namespace callback_internal
+
+
+// Capacity is the size of the inline buffer, the callables not fitting in it are allocated on heap.
+// The default capacity fits a function pointer or an object pointer with a member function pointer.
+template <typename Signature, size_t Capacity = callback_internal::BufferSize>
+class GCallback
+{
 };
 
-template <typename RT, typename ...Parameters>
-class GCallback <RT (Parameters...)> : public GCallback <RT (*)(Parameters...)>
+template <size_t Capacity, typename RT, typename... Parameters>
+class GCallback <RT (*)(Parameters...), Capacity> : public callback_internal::GCallbackHolder<Capacity, RT, Parameters...>
 {
 private:
-	typedef GCallback <RT (*)(Parameters...)> super;
+	typedef callback_internal::GCallbackHolder<Capacity, RT, Parameters...> super;
+	typedef GCallback <RT (*)(Parameters...), Capacity> ThisType;
+
+public:
+	typedef RT FunctionType(Parameters...);
+	typedef FunctionType * FunctionPointer;
+	typedef cpgf::GFunctionTraits<FunctionType> TraitsType;
+
+public:
+	GCallback() : super()
+	{
+	}
+
+	template <typename FT>
+	GCallback(
+		const FT & func,
+		typename std::enable_if<! GFunctionTraits<FT>::IsMember && IsCallable<FT, Parameters...>::Result>::type * = 0
+	)
+		: super()
+	{
+		this->template doConstruct<
+			callback_internal::GCallbackBaseFunc<
+				typename std::conditional<GFunctionTraits<FT>::IsFunction, typename GFunctionTraits<FT>::FunctionPointer, FT>::type,
+				RT, Parameters...>
+		>(func);
+	}
+
+	template <typename FT>
+	GCallback(
+		const FT & func,
+		typename std::enable_if<GFunctionTraits<FT>::IsMember>::type * = 0
+	)
+		: super()
+	{
+		this->template doConstruct<
+			callback_internal::GCallbackBaseMember<typename GFunctionTraits<FT>::ObjectType *, typename GFunctionTraits<FT>::ObjectType, FT, RT,Parameters...>
+		>((typename GFunctionTraits<FT>::ObjectType *)nullptr, func);
+	}
+
+	template <typename Instance, typename FT>
+	GCallback(Instance instance, const FT & func)
+		: super()
+	{
+		this->template doConstruct<
+			callback_internal::GCallbackBaseMember<Instance, typename cpgf::GFunctionTraits<FT>::ObjectType, FT, RT, Parameters...>
+		>(instance, func);
+	}
+
+	GCallback(const ThisType & other)
+		: super()
+	{
+		this->doCopy(other);
+	}
+
+	GCallback(ThisType && other)
+		: super()
+	{
+		this->doMove(other);
+	}
+
+	GCallback & operator = (const ThisType & other)
+	{
+		if(this != &other) {
+			this->doFreeBase();
+			this->doCopy(other);
+		}
+
+		return *this;
+	}
+
+	GCallback & operator = (ThisType && other)
+	{
+		if(this != &other) {
+			this->doFreeBase();
+			this->doMove(other);
+		}
+
+		return *this;
+	}
+
+	bool operator == (const ThisType & other) const
+	{
+		return this->isSame(other);
+	}
+
+	bool operator != (const ThisType & other) const
+	{
+		return ! this->isSame(other);
+	}
+};
+
+template <size_t Capacity, typename RT, typename ...Parameters>
+class GCallback <RT (Parameters...), Capacity> : public GCallback <RT (*)(Parameters...), Capacity>
+{
+private:
+	typedef GCallback <RT (*)(Parameters...), Capacity> super;
 
 public:
 	GCallback() : super() {}
@@ -504,16 +612,80 @@ public:
 	}
 };
 
+// A callback which can be moved but not copied, so it can hold a callable which can't be copied,
+// such as a lambda capturing a std::unique_ptr. Moving never allocates if the callable is on heap.
+template <typename Signature, size_t Capacity = callback_internal::BufferSize>
+class GMoveOnlyCallback
+{
+};
+
+template <size_t Capacity, typename RT, typename... Parameters>
+class GMoveOnlyCallback <RT (Parameters...), Capacity> : public callback_internal::GCallbackHolder<Capacity, RT, Parameters...>
+{
+private:
+	typedef callback_internal::GCallbackHolder<Capacity, RT, Parameters...> super;
+	typedef GMoveOnlyCallback <RT (Parameters...), Capacity> ThisType;
+
+public:
+	GMoveOnlyCallback() : super()
+	{
+	}
+
+	template <typename FT>
+	GMoveOnlyCallback(
+		FT && func,
+		typename std::enable_if<
+			! std::is_same<typename std::decay<FT>::type, ThisType>::value
+			&& ! GFunctionTraits<typename std::decay<FT>::type>::IsMember
+			&& IsCallable<typename std::decay<FT>::type, Parameters...>::Result
+		>::type * = 0
+	)
+		: super()
+	{
+		this->template doConstruct<
+			callback_internal::GCallbackBaseFunc<typename std::decay<FT>::type, RT, Parameters...>
+		>(std::forward<FT>(func));
+	}
+
+	template <typename Instance, typename FT>
+	GMoveOnlyCallback(Instance instance, const FT & func)
+		: super()
+	{
+		this->template doConstruct<
+			callback_internal::GCallbackBaseMember<Instance, typename cpgf::GFunctionTraits<FT>::ObjectType, FT, RT, Parameters...>
+		>(std::move(instance), func);
+	}
+
+	GMoveOnlyCallback(ThisType && other)
+		: super()
+	{
+		this->doMove(other);
+	}
+
+	GMoveOnlyCallback & operator = (ThisType && other)
+	{
+		if(this != &other) {
+			this->doFreeBase();
+			this->doMove(other);
+		}
+
+		return *this;
+	}
+
+	GMoveOnlyCallback(const ThisType & other) = delete;
+	GMoveOnlyCallback & operator = (const ThisType & other) = delete;
+};
+
 template <typename FT>
 struct FunctionCallbackType
 {
 	typedef GCallback<typename cpgf::GFunctionTraits<FT>::FunctionType> Result;
 };
 
-template <typename Signature>
-struct FunctionCallbackType <GCallback<Signature> >
+template <typename Signature, size_t Capacity>
+struct FunctionCallbackType <GCallback<Signature, Capacity> >
 {
-	typedef GCallback<Signature> Result;
+	typedef GCallback<Signature, Capacity> Result;
 };
 
 template <typename OT, typename FT>
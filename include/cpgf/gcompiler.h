@@ -42,6 +42,13 @@
 	#define G_OS_WIN
 #endif
 
+// Only defined if the byte order is known at compile time.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	#define G_LITTLE_ENDIAN
+#elif defined(G_COMPILER_VC) && (defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64))
+	#define G_LITTLE_ENDIAN
+#endif
+
 #ifdef G_OS_WIN
 	#define G_SUPPORT_STDCALL
 	#define G_SUPPORT_FASTCALL
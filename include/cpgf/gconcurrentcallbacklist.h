@@ -0,0 +1,205 @@
+#ifndef CPGF_GCONCURRENTCALLBACKLIST_H
+#define CPGF_GCONCURRENTCALLBACKLIST_H
+
+#include "cpgf/gcallback.h"
+#include "cpgf/gclassutil.h"
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+namespace cpgf {
+
+// A callback list which can be dispatched and modified from any thread.
+// The callbacks are kept in an immutable snapshot. Dispatching reads the current snapshot
+// with a couple of atomic operations, it never locks the list or allocates memory.
+// add, remove and clear copy the snapshot under a mutex and publish the new one.
+// The replaced snapshots are freed by a later add, remove or clear which finds no dispatch
+// running, or by collect. Dispatching never frees them, so it's wait-free, and the callbacks
+// are destroyed after the mutex is released, so their destructors may use the list.
+// Modifying the list while dispatching, including from inside a callback, is well defined:
+// a running dispatch keeps calling the snapshot it started with and the change is
+// seen by the next dispatch. So a callback removed meanwhile may still be called once.
+// Modifying is O(n) and allocates, use it for lists dispatched much more often than changed.
+template <typename Signature>
+class GConcurrentCallbackList : public GNoncopyable
+{
+private:
+	typedef GCallback<Signature> CallbackType;
+	typedef std::vector<CallbackType> CallbackListType;
+	typedef std::vector<const CallbackListType *> RetiredListType;
+
+	// Counts a running dispatch, also when a callback throws.
+	class DispatchingGuard
+	{
+	public:
+		explicit DispatchingGuard(const GConcurrentCallbackList * callbackList) : callbackList(callbackList) {
+			this->callbackList->dispatchingCount.fetch_add(1);
+		}
+
+		~DispatchingGuard() {
+			this->callbackList->dispatchingCount.fetch_sub(1);
+		}
+
+	private:
+		const GConcurrentCallbackList * callbackList;
+	};
+
+public:
+	GConcurrentCallbackList() : snapshot(nullptr), dispatchingCount(0), retiredList(), mutex() {
+	}
+
+	~GConcurrentCallbackList() {
+		delete this->snapshot.load();
+		freeSnapshots(this->retiredList);
+	}
+
+	int getCount() const {
+		DispatchingGuard guard(this);
+		const CallbackListType * current = this->snapshot.load();
+		return (current != nullptr ? (int)current->size() : 0);
+	}
+
+	bool empty() const {
+		return this->getCount() == 0;
+	}
+
+	void add(const CallbackType & callback)
+	{
+		if(callback.empty()) {
+			return;
+		}
+
+		RetiredListType freeList;
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+			const CallbackListType * current = this->snapshot.load();
+			CallbackListType * newList = (current != nullptr ? new CallbackListType(*current) : new CallbackListType());
+			newList->push_back(callback);
+			this->publish(newList, &freeList);
+		}
+		freeSnapshots(freeList);
+	}
+
+	void remove(const CallbackType & callback)
+	{
+		RetiredListType freeList;
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+			const CallbackListType * current = this->snapshot.load();
+			if(current == nullptr) {
+				return;
+			}
+
+			size_t count = 0;
+			for(const CallbackType & item : *current) {
+				if(item != callback) {
+					++count;
+				}
+			}
+			if(count == current->size()) {
+				return;
+			}
+
+			CallbackListType * newList = nullptr;
+			if(count > 0) {
+				newList = new CallbackListType();
+				newList->reserve(count);
+				for(const CallbackType & item : *current) {
+					if(item != callback) {
+						newList->push_back(item);
+					}
+				}
+			}
+			this->publish(newList, &freeList);
+		}
+		freeSnapshots(freeList);
+	}
+
+	void clear()
+	{
+		RetiredListType freeList;
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+			this->publish(nullptr, &freeList);
+		}
+		freeSnapshots(freeList);
+	}
+
+	// Frees the replaced snapshots if no dispatch is running.
+	// Call it after a burst of modifications which overlapped dispatching,
+	// otherwise the snapshots are kept until the next modification.
+	void collect()
+	{
+		RetiredListType freeList;
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+			this->takeRetiredListIfIdle(&freeList);
+		}
+		freeSnapshots(freeList);
+	}
+
+	template <typename... Parameters>
+	void operator() (Parameters && ... args) const
+	{
+		// The count must be increased before loading the snapshot, see publish.
+		DispatchingGuard guard(this);
+
+		const CallbackListType * current = this->snapshot.load();
+		if(current != nullptr) {
+			for(const CallbackType & callback : *current) {
+				callback.invoke(std::forward<Parameters>(args)...);
+			}
+		}
+	}
+
+	template <typename... Parameters>
+	void dispatch(Parameters && ... args) const
+	{
+		(*this)(std::forward<Parameters>(args)...);
+	}
+
+private:
+	// Must be called with the mutex locked.
+	// The snapshots which can be freed are moved to outFreeList, the caller frees them after unlocking.
+	void publish(const CallbackListType * newList, RetiredListType * outFreeList) {
+		const CallbackListType * previous = this->snapshot.exchange(newList);
+		if(previous != nullptr) {
+			this->retiredList.push_back(previous);
+		}
+
+		this->takeRetiredListIfIdle(outFreeList);
+	}
+
+	// Must be called with the mutex locked.
+	void takeRetiredListIfIdle(RetiredListType * outFreeList) {
+		// If no dispatch is running now, any later dispatch loads the current snapshot,
+		// which is never retired, so the retired snapshots are not reachable any more.
+		// The snapshot is exchanged before the count is loaded, see operator ().
+		if(! this->retiredList.empty() && this->dispatchingCount.load() == 0) {
+			outFreeList->swap(this->retiredList);
+		}
+	}
+
+	static void freeSnapshots(const RetiredListType & snapshotList) {
+		for(const CallbackListType * retired : snapshotList) {
+			delete retired;
+		}
+	}
+
+private:
+	std::atomic<const CallbackListType *> snapshot;
+	mutable std::atomic<int> dispatchingCount;
+	RetiredListType retiredList;
+	std::mutex mutex;
+};
+
+
+} //namespace cpgf
+
+
+#endif
@@ -7,6 +7,12 @@
 //define this macro if you want to customize it
 //#define G_API_CC __stdcall
 
+// define this macro to 1 to count the allocations and invocations in the meta and script binding layer.
+// See cpgf/gmetaprofile.h
+#ifndef G_ENABLE_META_PROFILE
+#define G_ENABLE_META_PROFILE 0
+#endif
+
 
 #endif
 
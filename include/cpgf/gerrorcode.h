@@ -25,6 +25,7 @@ extern int Error_Meta_NotUnaryOperator;
 extern int Error_Meta_NotBinaryOperator;
 extern int Error_Meta_NotFunctorOperator;
 extern int Error_Meta_WrongArity;
+extern int Error_Meta_CantResizeExportedBuffer;
 extern int Error_Meta_End;
 
 extern int Error_ScriptBinding_Begin;
@@ -49,6 +50,7 @@ extern int Error_ScriptBinding_CantFindMatchedOperator;
 extern int Error_ScriptBinding_NotSupportedFeature;
 extern int Error_ScriptBinding_CantSetScriptValue;
 extern int Error_ScriptBinding_CantFindObject;
+extern int Error_ScriptBinding_ScriptArrayIndexOutOfRange;
 extern int Error_ScriptBinding_End;
 
 extern int Error_Serialization_Begin;
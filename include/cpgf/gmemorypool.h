@@ -8,9 +8,13 @@
 #include <memory>
 #include <vector>
 #include <map>
+#include <atomic>
 
 namespace cpgf {
 
+class GMemoryPool;
+class GMemoryPoolThreadHolder;
+
 class GMemoryPoolChunk
 {
 public:
@@ -45,6 +49,14 @@ public:
 		return p >= this->buffer.get() && p < this->buffer.get() + this->chunkSize;
 	}
 
+	const unsigned char * getBufferBegin() const {
+		return this->buffer.get();
+	}
+
+	const unsigned char * getBufferEnd() const {
+		return this->buffer.get() + this->chunkSize;
+	}
+
 private:
 	size_t alignment;
 	size_t blockCount;
@@ -62,22 +74,34 @@ public:
 	GMemorySizedPool(
 		const size_t blockSize,
 		const size_t alignment,
-		const size_t blockCount
+		const size_t blockCount,
+		GMemoryPool * ownerPool = nullptr
 	);
 	~GMemorySizedPool();
 
 	void * allocate();
-	void free(void * p);
+	// Returns false if p is not allocated from this pool.
+	bool free(void * p);
 	
+private:
+	void addChunk();
+	void removeBackChunk();
+
 private:
 	size_t blockSize;
 	size_t alignment;
 	size_t blockCount;
 	std::vector<GMemoryPoolChunk> chunkList;
 	GMemoryPoolChunk * availableChunk;
+	GMemoryPool * ownerPool;
 };
 
 
+// A pool is not thread safe.
+// getInstance returns the pool of the calling thread, so allocating doesn't lock.
+// A block of a thread's pool can be freed on any thread, a block freed on another thread
+// is queued to its pool and reused by the next allocate or free on the thread of the pool.
+// The pool of an exited thread is given to the next new thread.
 class GMemoryPool
 {
 public:
@@ -93,10 +117,31 @@ public:
 	void * allocate(const size_t size);
 	void free(void * p, const size_t size);
 	
+private:
+	static GMemoryPool * acquireThreadPool();
+
+	void * doAllocate(const size_t size);
+	bool doFree(void * p, const size_t size);
+	void freeRemoteBlocks();
+	void freeRemoteBlocksLocked();
+	void freeOnOwnerPool(void * p, const size_t size);
+	void chunkAdded(const GMemoryPoolChunk & chunk);
+	void chunkRemoved(const GMemoryPoolChunk & chunk);
+
 private:
 	size_t alignment;
 	size_t blockCountPerChunk;
 	std::map<size_t, std::unique_ptr<GMemorySizedPool> > poolMap;
+	// The pool belongs to a thread, see getInstance.
+	bool threadPool;
+	// The thread of the pool has exited, the pool is only used with the registry locked.
+	bool orphaned;
+	std::atomic<bool> hasRemoteBlock;
+	std::vector<std::pair<void *, size_t> > remoteBlockList;
+
+private:
+	friend class GMemorySizedPool;
+	friend class GMemoryPoolThreadHolder;
 };
 
 
@@ -140,32 +185,29 @@ struct GMemoryPoolAllocator
 	typedef T * pointer;
 
 	GMemoryPoolAllocator()
-		: heapPool(GMemoryPool::getInstance())
 	{}
 
 	template <class U>
-	GMemoryPoolAllocator(const GMemoryPoolAllocator<U> & other)
-		: heapPool(other.heapPool)
+	GMemoryPoolAllocator(const GMemoryPoolAllocator<U> & /*other*/)
 	{
 	}
 	
+	// The pool is looked up on each call, the allocator may be copied to another thread.
 	T * allocate(std::size_t n)
 	{
-		return (T *)(this->heapPool->allocate(n));
+		return (T *)(GMemoryPool::getInstance()->allocate(n * sizeof(T)));
 	}
 	
 	void deallocate(T * p, std::size_t n)
 	{
-		this->heapPool->free(p, n);
+		GMemoryPool::getInstance()->free(p, n * sizeof(T));
 	}
-	
-	GMemoryPool * heapPool;
 };
 
 template <class T, class U>
-bool operator == (const GMemoryPoolAllocator<T> & a, const GMemoryPoolAllocator<U> & b)
+bool operator == (const GMemoryPoolAllocator<T> & /*a*/, const GMemoryPoolAllocator<U> & /*b*/)
 {
-	return a.heapPool == b.heapPool;
+	return true;
 }
 
 template <class T, class U>
@@ -0,0 +1,64 @@
+#ifndef CPGF_GMETAANNOTATIONINDEX_H
+#define CPGF_GMETAANNOTATIONINDEX_H
+
+#include "cpgf/gmetacommon.h"
+#include "cpgf/gclassutil.h"
+
+#include <vector>
+#include <memory>
+
+
+namespace cpgf {
+
+class GMetaClass;
+class GMetaAnnotation;
+class GAnnotationValue;
+class GMetaAnnotationIndexImplement;
+
+struct GMetaAnnotationIndexEntry
+{
+	// The annotated item, can be a class, a field, a method, etc.
+	const GMetaItem * item;
+	const GMetaAnnotation * annotation;
+};
+
+// Maps an annotation name to all items which have the annotation,
+// in a meta class and all its inner classes (the global meta class by default).
+// The index is built on the first query, rebuild it after more meta data is registered.
+// Building the index registers all lazy classes under the root class.
+// The queries return the meta items directly, no IMetaAnnotation is created.
+// It's not thread safe.
+class GMetaAnnotationIndex : public GNoncopyable
+{
+public:
+	typedef std::vector<GMetaAnnotationIndexEntry> EntryListType;
+
+public:
+	GMetaAnnotationIndex();
+	explicit GMetaAnnotationIndex(const GMetaClass * rootClass);
+	~GMetaAnnotationIndex();
+
+	void rebuild();
+
+	// Empty if no item has the annotation.
+	const EntryListType & getEntries(const char * annotationName) const;
+
+	// Items which have the annotation, whose category is category, or any category if category is mcatCount.
+	void findItems(const char * annotationName, GMetaCategory category, std::vector<const GMetaItem *> * outItems) const;
+	// Items which have the annotation, and the annotation has valueName equal to value.
+	// Strings and wide strings are compared by content, other values are compared as int.
+	void findItems(const char * annotationName, const char * valueName, const GAnnotationValue & value,
+		GMetaCategory category, std::vector<const GMetaItem *> * outItems) const;
+
+private:
+	void ensureBuilt() const;
+
+private:
+	std::unique_ptr<GMetaAnnotationIndexImplement> implement;
+};
+
+
+} // namespace cpgf
+
+
+#endif
@@ -6,6 +6,7 @@
 #include "cpgf/gmetatype.h"
 #include "cpgf/gmetaextendtype.h"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace cpgf {
@@ -44,6 +45,8 @@ struct IMetaTypedItem : public IMetaItem
 
 	virtual void G_API_CC destroyInstance(void * instance) = 0;
 	virtual void G_API_CC destroyInplace(void * instance) = 0;
+
+	virtual gapi_bool G_API_CC isBaseType(const GTypeInfo * baseType) = 0;
 };
 
 struct IMetaList : public IExtendObject
@@ -87,6 +90,7 @@ struct IMetaCallable : public IMetaItem
 	virtual gapi_bool G_API_CC checkParam(const GVariantData * param, uint32_t paramIndex) = 0;
 	virtual gapi_bool G_API_CC isParamTransferOwnership(uint32_t paramIndex) = 0;
 	virtual gapi_bool G_API_CC isResultTransferOwnership() = 0;
+	virtual gapi_bool G_API_CC isReleaseScriptLock() = 0;
 	virtual void G_API_CC execute(GVariantData * outResult, void * instance, const GVariantData * params, uint32_t paramCount) = 0;
 	virtual void G_API_CC executeIndirectly(GVariantData * outResult, void * instance, GVariantData const * const * params, uint32_t paramCount) = 0;
 };
@@ -123,6 +127,8 @@ struct IMetaEnum : public IMetaTypedItem
 	virtual const char * G_API_CC getKey(uint32_t index) = 0;
 	virtual void G_API_CC getValue(GVariantData * outResult, uint32_t index) = 0;
 	virtual int32_t G_API_CC findKey(const char * key) = 0;
+	virtual int64_t G_API_CC getIntValue(uint32_t index) = 0;
+	virtual int32_t G_API_CC findValue(int64_t value) = 0;
 };
 
 struct IMetaAnnotationValue : public IExtendObject
@@ -204,6 +210,8 @@ struct IMetaClass : public IMetaTypedItem
 	
 	virtual void * G_API_CC castFromDerived(const void * derived, uint32_t derivedIndex) = 0;
 	virtual void * G_API_CC castToDerived(const void * self, uint32_t derivedIndex) = 0;
+
+	virtual gapi_bool G_API_CC getBaseOffset(uint32_t baseIndex, ptrdiff_t * outOffset) = 0;
 };
 
 
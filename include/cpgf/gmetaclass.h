@@ -25,6 +25,8 @@ class GMetaModule;
 
 class GMetaClassImplement;
 
+struct GMetaMemberDescriptor;
+
 class GMetaClass final : public GMetaTypedItem
 {
 private:
@@ -125,6 +127,10 @@ public:
 	// return a pointer points to base class
 	void * castToBase(const void * self, size_t baseIndex) const;
 
+	// return true if castToBase adds a constant offset to self, which is stored in outOffset.
+	// return false for virtual base, the offset depends on the object.
+	bool getBaseOffset(size_t baseIndex, ptrdiff_t * outOffset) const;
+
 	// return a pointer points to this class
 	void * castFromDerived(const void * derived, size_t derivedIndex) const;
 
@@ -150,6 +156,9 @@ public:
 	GMetaEnum * addEnum(GMetaEnum * en);
 	GMetaClass * addClass(const GMetaClass * cls);
 
+	// Creates and adds all members in the table, see gmetamembertable.h
+	void addMembers(const GMetaMemberDescriptor * descriptors, size_t count);
+
 	void extractTo(GMetaClass * master);
 
 	const GMetaClass * doGetClass(const char * name) const;
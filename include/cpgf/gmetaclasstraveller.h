@@ -6,46 +6,81 @@
 #include "cpgf/gapi.h"
 #include "cpgf/gsharedinterface.h"
 
-#include <deque>
+#include <vector>
+#include <memory>
 
 #include <stddef.h>
+#include <stdint.h>
 
 
 namespace cpgf {
 
 struct IMetaClass;
 
-class GMetaClassTraveller : public GNoncopyable
+// The flattened inheritance hierarchy of a class, in the order that GMetaClassTraveller walks it,
+// breadth-first from the class itself to the roots. A class inherited on several paths appears several times.
+// It's built once, then iterating it doesn't allocate memory and doesn't touch the reference counts.
+// For each node, if all casts on the path from the class are static (no virtual base),
+// the instance offset is precomputed and getInstanceAt doesn't call castToBase.
+class GMetaClassLinearization : public GNoncopyable
 {
 private:
-	class Node {
-	public:
-		Node(IMetaClass * metaClass, void * instance, IMetaClass * derived);
-		~Node();
+	struct Node
+	{
+		GSharedInterface<IMetaClass> metaClass;
+		// The node of the derived class, only valid if the node is not the first one.
+		uint32_t derivedNodeIndex;
+		// The index of metaClass in the base classes of the derived class.
+		uint32_t baseIndex;
+		// The offset from the instance of the first class, only valid if hasStaticOffset is true.
+		ptrdiff_t offset;
+		bool hasStaticOffset;
+	};
 
-		Node(const Node & other);
-		Node & operator = (Node other);
-		Node & operator = (Node && other);
+	typedef std::vector<Node> ListType;
 
-		void swap(Node & other);
+public:
+	explicit GMetaClassLinearization(IMetaClass * metaClass);
+	~GMetaClassLinearization();
 
-	public:
-		GSharedInterface<IMetaClass> metaClass;
-		void * instance;
-		GSharedInterface<IMetaClass> derived;
-	};
-	
-	typedef std::deque<Node> ListType;
-	
+	size_t getCount() const {
+		return this->nodeList.size();
+	}
+
+	// The returned interface is not retained, it lives as long as the linearization.
+	IMetaClass * getClassAt(size_t index) const {
+		return this->nodeList[index].metaClass.get();
+	}
+
+	// nullptr for the first node.
+	IMetaClass * getDerivedAt(size_t index) const {
+		return index == 0 ? nullptr : this->nodeList[this->nodeList[index].derivedNodeIndex].metaClass.get();
+	}
+
+	// Cast instance, which is an instance of the first class, to the class at index.
+	void * getInstanceAt(size_t index, void * instance) const;
+
+private:
+	ListType nodeList;
+};
+
+class GMetaClassTraveller : public GNoncopyable
+{
 public:
 	GMetaClassTraveller(IMetaClass * metaClass, void * instance);
+	// Walk an existing linearization, which must outlive the traveller.
+	GMetaClassTraveller(const GMetaClassLinearization * linearization, void * instance);
 	~GMetaClassTraveller();
-	
+
+	// The returned classes are retained, the caller must release them.
 	IMetaClass * next(void ** outInstance, IMetaClass ** outDerived);
 	IMetaClass * next(void ** outInstance);
 
 private:
-	ListType traversal;
+	std::unique_ptr<GMetaClassLinearization> ownedLinearization;
+	const GMetaClassLinearization * linearization;
+	void * instance;
+	size_t index;
 };
 
 
@@ -54,4 +89,3 @@ private:
 
 
 #endif
-
@@ -55,6 +55,7 @@ enum GMetaCategory {
 
 const int metaModifierStatic = 1 << 0;
 const int metaModifierNoFree = 1 << 1;
+const int metaModifierReleaseScriptLock = 1 << 2;
 
 class GMetaItem : public GNoncopyable
 {
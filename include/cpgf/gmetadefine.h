@@ -5,6 +5,7 @@
 #include "cpgf/gmetaclass.h"
 #include "cpgf/gmetaenum.h"
 #include "cpgf/gmetafield.h"
+#include "cpgf/gmetamembertable.h"
 #include "cpgf/gmetamethod.h"
 #include "cpgf/gmetaoperator.h"
 #include "cpgf/gmetaproperty.h"
@@ -365,6 +366,12 @@ public:
 		}
 	}
 
+	// Adds all members in a static table, see gmetamembertable.h
+	template <size_t N>
+	void _members(const GMetaMemberDescriptor (&descriptors)[N]) {
+		this->metaClass->addMembers(descriptors, N);
+	}
+
 	GDefineMetaAnnotation<DerivedType> _annotation(const char * name) {
 		return GDefineMetaAnnotation<DerivedType>(
 			this->metaClass,
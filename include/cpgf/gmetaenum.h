@@ -24,7 +24,11 @@ public:
 	size_t getCount() const;
 	const char * getKey(size_t index) const;
 	GVariant getValue(size_t index) const;
+	// The value converted to integer, 0 if index is out of range or the value is not a number.
+	int64_t getIntValue(size_t index) const;
+	// Returns the index of the first key, -1 if not found.
 	int findKey(const char * key) const;
+	int findValue(int64_t value) const;
 
 	GMetaEnum & operator () (const char * key, const GVariant & value);
 
@@ -0,0 +1,75 @@
+#ifndef CPGF_GMETAMEMBERTABLE_H
+#define CPGF_GMETAMEMBERTABLE_H
+
+#include "cpgf/gmetacommon.h"
+#include "cpgf/gmetafield.h"
+#include "cpgf/gmetamethod.h"
+#include "cpgf/gmetapolicy.h"
+
+
+namespace cpgf {
+
+// One member in a static member table.
+// A table is a constant array built with metaTableMethod, metaTableField and metaTableConstructor,
+// and is registered in one pass by GMetaClass::addMembers or GDefineMetaCommon::_members.
+// Only create is instantiated for each member, the builder objects of the _method/_field chains are not,
+// so a table compiles faster and registers faster than the equivalent chain.
+// Members with default parameters or annotations still need the chain.
+struct GMetaMemberDescriptor
+{
+	GMetaCategory category;
+	const char * name;
+	GMetaItem * (*create)(const char * name);
+};
+
+
+namespace meta_internal {
+
+template <typename ClassType, typename FT, FT func, typename Policy>
+GMetaItem * createTableMethod(const char * name)
+{
+	return GMetaMethod::newMethod<ClassType>(name, func, Policy());
+}
+
+template <typename FT, FT field, typename Policy>
+GMetaItem * createTableField(const char * name)
+{
+	return new GMetaField(name, field, Policy());
+}
+
+template <typename ClassType, typename Signature, typename Policy>
+GMetaItem * createTableConstructor(const char * /*name*/)
+{
+	return GMetaConstructor::newConstructor<ClassType, Signature>(Policy());
+}
+
+} // namespace meta_internal
+
+
+// FT is the pointer type of func, it must be given explicitly for overloaded functions.
+// metaTableMethod<MyClass, decltype(&MyClass::foo), &MyClass::foo>("foo")
+template <typename ClassType, typename FT, FT func, typename Policy = GMetaPolicyDefault>
+constexpr GMetaMemberDescriptor metaTableMethod(const char * name)
+{
+	return GMetaMemberDescriptor{ mcatMethod, name, &meta_internal::createTableMethod<ClassType, FT, func, Policy> };
+}
+
+// metaTableField<decltype(&MyClass::value), &MyClass::value>("value")
+template <typename FT, FT field, typename Policy = GMetaPolicyDefault>
+constexpr GMetaMemberDescriptor metaTableField(const char * name)
+{
+	return GMetaMemberDescriptor{ mcatField, name, &meta_internal::createTableField<FT, field, Policy> };
+}
+
+// metaTableConstructor<MyClass, void * (int, const char *)>()
+template <typename ClassType, typename Signature, typename Policy = GMetaPolicyDefault>
+constexpr GMetaMemberDescriptor metaTableConstructor()
+{
+	return GMetaMemberDescriptor{ mcatConstructor, "", &meta_internal::createTableConstructor<ClassType, Signature, Policy> };
+}
+
+
+} // namespace cpgf
+
+
+#endif
@@ -26,6 +26,10 @@ public:
 			method->addModifier(meta_internal::GMetaMethodCallbackMaker<OT, FT>::modifiers);
 		}
 
+		if(PolicyHasRule<Policy, GMetaRuleReleaseScriptLock>::Result) {
+			method->addModifier(metaModifierReleaseScriptLock);
+		}
+
 		return method;
 	}
 
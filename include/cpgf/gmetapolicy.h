@@ -45,6 +45,11 @@ struct GMetaRuleGetterExplicitThis {};
 // used by property Setter
 struct GMetaRuleSetterExplicitThis {};
 
+// used by method
+// Script engines with a global interpreter lock (Python) release the lock while the method is executing.
+// The method must not access any script object or call back into the script.
+struct GMetaRuleReleaseScriptLock {};
+
 
 // policies
 
@@ -120,6 +125,11 @@ typedef MakePolicy<
 	>
 	GMetaPolicyExplicitThis;
 
+typedef MakePolicy<
+		GMetaRuleReleaseScriptLock
+	>
+	GMetaPolicyReleaseScriptLock;
+
 
 } // namespace cpgf
 
@@ -0,0 +1,129 @@
+#ifndef CPGF_GMETAPROFILE_H
+#define CPGF_GMETAPROFILE_H
+
+#include "cpgf/gconfig.h"
+
+#include <string>
+#include <cstdint>
+
+
+namespace cpgf {
+
+enum GMetaProfileCategory {
+	mpcGlueData,
+	mpcScriptValueCopy,
+	mpcVariantRetain,
+	mpcMetaClassInterface,
+	mpcMetaMethodInterface,
+	mpcLuaUserData,
+	mpcObjectCreate,
+	mpcMethodInvoke,
+
+	mpcCount
+};
+
+enum GMetaProfileTiming {
+	// Overload resolution in the script binding.
+	mptResolve,
+	// Invoking a method from the script binding, including the parameter conversion.
+	mptBindingInvoke,
+	// GMetaMethod::invoke, execute and executeByData.
+	mptMethodInvoke,
+
+	mptCount
+};
+
+// Bucket i counts the samples which took [2^(i-1), 2^i) nanoseconds, bucket 0 is less than 1 nanosecond.
+const int metaProfileHistogramBucketCount = 32;
+
+struct GMetaProfileSampleStat
+{
+	uint64_t sampleCount;
+	// The sample count and the time multiplied by the sample interval at the time of sampling.
+	uint64_t estimatedCallCount;
+	uint64_t estimatedTotalNanoseconds;
+	uint64_t histogram[metaProfileHistogramBucketCount];
+};
+
+// Counters of the allocations and invocations in the meta and script binding layer,
+// and sampled timings of the method calls.
+// The library only counts if it's compiled with G_ENABLE_META_PROFILE defined to 1,
+// otherwise the G_META_PROFILE_* macros are empty and all counts are 0.
+// The counters are thread safe.
+
+bool isMetaProfileEnabled();
+
+void metaProfileCount(GMetaProfileCategory category);
+// Counts the category and the item, such as a meta class or method, in the category.
+void metaProfileCountItem(GMetaProfileCategory category, const char * itemName);
+
+uint64_t getMetaProfileCount(GMetaProfileCategory category);
+uint64_t getMetaProfileItemCount(GMetaProfileCategory category, const char * itemName);
+
+const char * getMetaProfileCategoryName(GMetaProfileCategory category);
+const char * getMetaProfileTimingName(GMetaProfileTiming timing);
+
+// On average 1 in interval calls of each timing on each thread is measured, 0 disables the sampling.
+// The gap between two samples is random, so periodic call patterns don't bias the samples.
+// The default is 64.
+void setMetaProfileSampleInterval(uint32_t interval);
+uint32_t getMetaProfileSampleInterval();
+
+// Returns false if the item has no sample.
+bool getMetaProfileSampleStat(GMetaProfileTiming timing, const char * itemName, GMetaProfileSampleStat * outStat);
+
+void resetMetaProfile();
+
+// One line per category and one indented line per item, the items are sorted by count descending.
+// Then for each timing, at most maxSampleItemCount items sorted by the estimated total time descending.
+std::string dumpMetaProfile(size_t maxSampleItemCount = 20);
+
+bool shouldSampleMetaProfile(GMetaProfileTiming timing);
+uint64_t getMetaProfileNanoseconds();
+void metaProfileSample(GMetaProfileTiming timing, const char * itemName, uint64_t nanoseconds);
+
+// Measures the time from construction to finish, if this call is sampled.
+class GMetaProfileSampler
+{
+public:
+	explicit GMetaProfileSampler(GMetaProfileTiming timing)
+		: timing(timing), sampling(shouldSampleMetaProfile(timing)), startTime(sampling ? getMetaProfileNanoseconds() : 0)
+	{
+	}
+
+	bool isSampling() const {
+		return this->sampling;
+	}
+
+	void finish(const char * itemName) {
+		if(this->sampling) {
+			this->sampling = false;
+			metaProfileSample(this->timing, itemName, getMetaProfileNanoseconds() - this->startTime);
+		}
+	}
+
+private:
+	GMetaProfileTiming timing;
+	bool sampling;
+	uint64_t startTime;
+};
+
+
+} // namespace cpgf
+
+
+#if G_ENABLE_META_PROFILE
+	#define G_META_PROFILE_COUNT(category) ::cpgf::metaProfileCount(::cpgf::category)
+	#define G_META_PROFILE_COUNT_ITEM(category, itemName) ::cpgf::metaProfileCountItem(::cpgf::category, (itemName))
+	// itemName is only evaluated if the call is sampled.
+	#define G_META_PROFILE_SAMPLE_BEGIN(sampler, timing) ::cpgf::GMetaProfileSampler sampler(::cpgf::timing)
+	#define G_META_PROFILE_SAMPLE_END(sampler, itemName) do { if(sampler.isSampling()) { sampler.finish(itemName); } } while(false)
+#else
+	#define G_META_PROFILE_COUNT(category)
+	#define G_META_PROFILE_COUNT_ITEM(category, itemName)
+	#define G_META_PROFILE_SAMPLE_BEGIN(sampler, timing)
+	#define G_META_PROFILE_SAMPLE_END(sampler, itemName)
+#endif
+
+
+#endif
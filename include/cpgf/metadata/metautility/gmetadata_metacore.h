@@ -20,6 +20,9 @@ void doBuildMetaData_metaCore(const GMetaDataConfigFlags & /*config*/, MetaDefin
 	M(T, cloneClass)
 	define._method("cast", &T::cast)
 		._default((void *)0);
+	M(T, getProfileReport)
+	M(T, resetProfile)
+	M(T, setProfileSampleInterval)
 }
 
 
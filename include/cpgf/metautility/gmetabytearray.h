@@ -58,6 +58,12 @@ public:
     void writeFloat64(double value, const GMetaVariadicParam * moreValues = nullptr);
 
     void writeBuffer(const void * buffer, size_t length);
+
+    // While the memory is exported (e.g, to a Python memoryview), changing the length raises an exception.
+    void addBufferExport();
+    void releaseBufferExport();
+    size_t getBufferExportCount() const;
+
 private:
 	std::unique_ptr<GMetaByteArrayImplement> implement;
 };
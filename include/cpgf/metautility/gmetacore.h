@@ -3,6 +3,8 @@
 
 #include "cpgf/gvariant.h"
 
+#include <string>
+
 
 namespace cpgf {
 
@@ -16,6 +18,11 @@ public:
 	IMetaClass * cloneClass(IMetaClass * metaClass);
 	GVariant cast(const GVariant & instance, IMetaClass * targetMetaClass = nullptr);
 
+	// See cpgf/gmetaprofile.h. All counts are 0 if the library is not compiled with G_ENABLE_META_PROFILE.
+	std::string getProfileReport();
+	void resetProfile();
+	void setProfileSampleInterval(uint32_t interval);
+
 private:
 	GScriptObject * scriptObject;
 };
@@ -311,6 +311,7 @@ struct GMetaClassCasterVirtual
 	GMetaClassCasterBase * (*clone)();
 	void * (*downCast)(void * base);
 	void * (*upCast)(void * derived);
+	bool (*getUpCastOffset)(ptrdiff_t * outOffset);
 };
 
 class GMetaClassCasterBase
@@ -320,6 +321,8 @@ public:
 
 	void * downCast(const void * base) const;
 	void * upCast(const void * derived) const;
+	// Return true if upCast is a constant offset added to the address, then outOffset receives the offset.
+	bool getUpCastOffset(ptrdiff_t * outOffset) const;
 
 protected:
 	GMetaClassCasterVirtual * virtualFunctions;
@@ -349,6 +352,32 @@ struct GMetaClassCasterSelector <true>
 	}
 };
 
+// Base * can be static_cast to Derived * only if Base is a non-virtual, unambiguous and accessible base,
+// that's when the address offset of Base in Derived doesn't depend on the object.
+template <typename D, typename B>
+struct IsStaticCastBase
+{
+	template<typename U> static auto test(U * p) -> decltype(static_cast<D *>(p), void(), std::true_type());
+	template<typename U> static auto test(...) -> decltype(std::false_type());
+
+	static constexpr bool Result = decltype(test<B>(nullptr))::value;
+};
+
+template <typename D, typename B>
+bool getStaticUpCastOffset(ptrdiff_t * outOffset, typename GEnableIfResult<IsStaticCastBase<D, B> >::Result * = 0)
+{
+	// Any non-null aligned address works, casting to a non-virtual base doesn't access the object.
+	D * derived = reinterpret_cast<D *>(static_cast<uintptr_t>(0x10000));
+	*outOffset = reinterpret_cast<char *>(static_cast<B *>(derived)) - reinterpret_cast<char *>(derived);
+	return true;
+}
+
+template <typename D, typename B>
+bool getStaticUpCastOffset(ptrdiff_t * /*outOffset*/, typename GDisableIfResult<IsStaticCastBase<D, B> >::Result * = 0)
+{
+	return false;
+}
+
 template <typename Derived, typename Base>
 class GMetaClassCaster : public GMetaClassCasterBase
 {
@@ -365,12 +394,17 @@ private:
 		return static_cast<Base *>(static_cast<Derived *>(derived));
 	}
 
+	static bool virtualGetUpCastOffset(ptrdiff_t * outOffset) {
+		return getStaticUpCastOffset<Derived, Base>(outOffset);
+	}
+
 public:
 	GMetaClassCaster() {
 		static GMetaClassCasterVirtual thisFunctions = {
 			&virtualClone,
 			&virtualDownCast,
-			&virtualUpCast
+			&virtualUpCast,
+			&virtualGetUpCastOffset
 		};
 
 		this->virtualFunctions = &thisFunctions;
@@ -393,12 +427,18 @@ private:
 		return derived;
 	}
 
+	static bool virtualGetUpCastOffset(ptrdiff_t * outOffset) {
+		*outOffset = 0;
+		return true;
+	}
+
 public:
 	GMetaClassCaster() {
 		static GMetaClassCasterVirtual thisFunctions = {
 			&virtualClone,
 			&virtualDownCast,
-			&virtualUpCast
+			&virtualUpCast,
+			&virtualGetUpCastOffset
 		};
 
 		this->virtualFunctions = &thisFunctions;
@@ -10,7 +10,7 @@ namespace tween_internal {
 struct GTweenItemVirtual
 {
 	void (*deleteSelf)(void * self);
-	void (*tick)(void * self, GTweenEaseParam * param, const GTweenEaseType & ease);
+	void (*tick)(void * self, GTweenNumber ratio);
 	void (*init)(void * self);
 	const void * (*getInstance)(void * self);
 };
@@ -19,7 +19,8 @@ class GTweenItem
 {
 public:
 	void deleteSelf();
-	void tick(GTweenEaseParam * param, const GTweenEaseType & ease);
+	// ratio is the eased progress, the tween evaluates the ease once for all of its items.
+	void tick(GTweenNumber ratio);
 	void init();
 	const void * getInstance();
 
@@ -46,8 +47,8 @@ private:
 		delete static_cast<ThisType *>(self);
 	}
 	
-	static void virtualTick(void * self, GTweenEaseParam * param, const GTweenEaseType & ease) {
-		static_cast<ThisType *>(self)->doTick(param, ease);
+	static void virtualTick(void * self, GTweenNumber ratio) {
+		static_cast<ThisType *>(self)->doTick(ratio);
 	}
 
 	static void virtualInit(void * self) {
@@ -72,8 +73,7 @@ public:
 	}
 
 protected:
-	void doTick(GTweenEaseParam * param, const GTweenEaseType & ease) {
-		GTweenNumber ratio = ease(param);
+	void doTick(GTweenNumber ratio) {
 		ValueType value = (ValueType)(this->from + (this->change * ratio));
 		this->accessor(value);
 	}
@@ -117,8 +117,8 @@ private:
 		delete static_cast<ThisType *>(self);
 	}
 	
-	static void virtualTick(void * self, GTweenEaseParam * param, const GTweenEaseType & ease) {
-		static_cast<ThisType *>(self)->doTick(param, ease);
+	static void virtualTick(void * self, GTweenNumber ratio) {
+		static_cast<ThisType *>(self)->doTick(ratio);
 	}
 
 	static void virtualInit(void * self) {
@@ -143,8 +143,7 @@ public:
 	}
 
 protected:
-	void doTick(GTweenEaseParam * param, const GTweenEaseType & ease) {
-		GTweenNumber ratio = ease(param);
+	void doTick(GTweenNumber ratio) {
 		ValueType value = (ValueType)(this->from + (((ValueType)(this->TargetGetter()) - this->from) * ratio));
 		this->accessor(value);
 	}
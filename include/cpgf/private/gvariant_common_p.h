@@ -18,6 +18,18 @@ struct VariantTypeInfo
 
 extern VariantTypeInfo variantTypeInfo[];
 
+// How to read an integer type from the low bytes of GVariantData::valueInt, indexed by vt - vtIntegerBegin.
+// Shifting left then right (arithmetic) by shift sign extends the value, then mask clears the extended bits for unsigned types.
+struct VariantIntegerInfo
+{
+	unsigned int shift;
+	std::uint64_t mask;
+	// Unsigned and as wide as uint64_t, the value can't be converted via int64_t.
+	bool isUnsigned64;
+};
+
+extern const VariantIntegerInfo variantIntegerInfo[];
+
 inline void failedCast()
 {
 	cpgf::raiseCoreException(cpgf::Error_Variant_FailCast);
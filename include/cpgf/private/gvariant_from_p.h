@@ -125,10 +125,81 @@ T helperFromNullPointer(typename std::enable_if<! std::is_pointer<T>::value>::ty
 	return helperReturnEmptyValue<T>();
 }
 
+// Read an integer of any width and signedness. vt must be an integer type.
+// On little endian it's branch free, the narrow value is in the low bytes of valueInt.
+// Otherwise it converts per type.
+inline std::int64_t helperReadVariantInteger(const GVariantData & data, const GVariantType vt, const VariantIntegerInfo & info)
+{
+#ifdef G_LITTLE_ENDIAN
+	(void)vt;
+	return (std::int64_t)((std::uint64_t)((std::int64_t)((std::uint64_t)data.valueInt << info.shift) >> info.shift) & info.mask);
+#else
+	(void)info;
+	switch(vt) {
+	case GVariantType::vtBool: return (std::int64_t)(bool)data.valueInt;
+	case GVariantType::vtChar: return (std::int64_t)(char)data.valueInt;
+	case GVariantType::vtWchar: return (std::int64_t)(wchar_t)data.valueInt;
+	case GVariantType::vtSignedChar: return (std::int64_t)(signed char)data.valueInt;
+	case GVariantType::vtUnsignedChar: return (std::int64_t)(unsigned char)data.valueInt;
+	case GVariantType::vtSignedShort: return (std::int64_t)(signed short)data.valueInt;
+	case GVariantType::vtUnsignedShort: return (std::int64_t)(unsigned short)data.valueInt;
+	case GVariantType::vtSignedInt: return (std::int64_t)(signed int)data.valueInt;
+	case GVariantType::vtUnsignedInt: return (std::int64_t)(unsigned int)data.valueInt;
+	case GVariantType::vtSignedLong: return (std::int64_t)(signed long)data.valueInt;
+	case GVariantType::vtUnsignedLong: return (std::int64_t)(unsigned long)data.valueInt;
+	case GVariantType::vtSignedLongLong: return (std::int64_t)(signed long long)data.valueInt;
+	case GVariantType::vtUnsignedLongLong: return (std::int64_t)(unsigned long long)data.valueInt;
+
+	default:
+		return 0;
+	}
+#endif
+}
+
+template <typename T>
+T helperIntegerToArithmetic(const std::int64_t value, const bool /*isUnsigned64*/, typename std::enable_if<! std::is_floating_point<T>::value>::type * = 0)
+{
+	// Same bits no matter the value is from signed or unsigned.
+	return (T)value;
+}
+
+template <typename T>
+T helperIntegerToArithmetic(const std::int64_t value, const bool isUnsigned64, typename std::enable_if<std::is_floating_point<T>::value>::type * = 0)
+{
+	// Compute both so the compiler can select without branch.
+	const T fromSigned = (T)value;
+	const T fromUnsigned = (T)(std::uint64_t)value;
+	return isUnsigned64 ? fromUnsigned : fromSigned;
+}
+
+// Convert any fundamental type to the arithmetic type T via variantIntegerInfo,
+// instead of a switch on every (source, target) pair. Return false if vt is not fundamental.
+template <typename T>
+bool helperCastArithmetic(const GVariantData & data, const GVariantType vt, T * outValue)
+{
+	if(vtIsInteger(vt)) {
+		const VariantIntegerInfo & info = variantIntegerInfo[(GVtType)vt - (GVtType)GVariantType::vtIntegerBegin];
+		*outValue = helperIntegerToArithmetic<T>(helperReadVariantInteger(data, vt, info), info.isUnsigned64);
+		return true;
+	}
+
+	switch(vt) {
+	case GVariantType::vtFloat: *outValue = (T)data.valueFloat; return true;
+	case GVariantType::vtDouble: *outValue = (T)data.valueDouble; return true;
+	case GVariantType::vtLongDouble: *outValue = (T)data.valueLongDouble; return true;
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
 template <typename T, typename Policy>
 struct CastVariant_Value
 {
 	typedef typename VariantCastResult<T, Policy>::Result ResultType;
+	typedef typename std::remove_cv<typename HelperValueType<ResultType>::type>::type ArithmeticType;
 
 	typedef cpgf::GTypeList<const char *, char *, const volatile char *, volatile char *> StringCharTypeList;
 	typedef cpgf::GTypeList<const std::string &, std::string, std::string &, const volatile std::string &, volatile std::string &> StringStringTypeList;
@@ -136,6 +207,21 @@ struct CastVariant_Value
 	typedef cpgf::GTypeList<const std::wstring &, std::wstring, std::wstring &, const volatile std::wstring &, volatile std::wstring &> WideStringStringTypeList;
 
 	static ResultType cast(const GVariantData & data)
+	{
+		return doCast(data, std::integral_constant<bool, std::is_arithmetic<ArithmeticType>::value>());
+	}
+
+	static ResultType doCast(const GVariantData & data, std::true_type)
+	{
+		ArithmeticType value;
+		if(helperCastArithmetic<ArithmeticType>(data, vtGetBaseType(data.typeData), &value)) {
+			return (ResultType)value;
+		}
+
+		return doCast(data, std::false_type());
+	}
+
+	static ResultType doCast(const GVariantData & data, std::false_type)
 	{
 		// 0 can always be converted to pointer, similar as we do in C++.
 		if(std::is_pointer<ResultType>::value) {
@@ -216,6 +302,11 @@ struct CastVariant_Value
 
 	static bool canCast(const GVariantData & data)
 	{
+		// Any fundamental type can be converted to any arithmetic type.
+		if(std::is_arithmetic<ArithmeticType>::value && vtIsFundamental(vtGetBaseType(data.typeData))) {
+			return true;
+		}
+
 		// 0 can always be converted to pointer, similar as we do in C++.
 		if(std::is_pointer<ResultType>::value) {
 			if(data.valueInt == 0 && vtIsFundamental(vtGetType(data.typeData))) {
@@ -0,0 +1,105 @@
+#ifndef CPGF_GLUASTATEPOOL_H
+#define CPGF_GLUASTATEPOOL_H
+
+#include "cpgf/scriptbind/gscriptbind.h"
+#include "cpgf/gcallback.h"
+#include "cpgf/gclassutil.h"
+
+#include "lua.hpp"
+
+#include <memory>
+
+
+namespace cpgf {
+
+struct IMetaService;
+
+class GLuaStatePoolImplement;
+
+// A Lua state created and bound by GLuaStatePool.
+class GLuaPooledState : public GNoncopyable
+{
+public:
+	~GLuaPooledState();
+
+	lua_State * getLuaState() const {
+		return this->luaState;
+	}
+
+	GScriptObject * getScriptObject() const {
+		return this->scriptObject.get();
+	}
+
+private:
+	explicit GLuaPooledState(GLuaStatePoolImplement * pool);
+
+	void reset();
+
+private:
+	lua_State * luaState;
+	std::unique_ptr<GScriptObject> scriptObject;
+	int snapshotRef;
+
+private:
+	friend class GLuaStatePoolImplement;
+};
+
+// Hands out pre-bound Lua states, usually one per worker thread.
+// All states share the class maps built by the binding, so only the first state
+// pays for building them. A released state gets its global table restored to
+// what the binder left, values inside the global tables are not restored.
+// acquire and release are thread safe, a state can be used by one thread at a time.
+class GLuaStatePool : public GNoncopyable
+{
+public:
+	// Called once for each new state to bind the meta data to it.
+	typedef GCallback<void (GScriptObject *)> BinderType;
+
+public:
+	GLuaStatePool(IMetaService * service, const BinderType & binder);
+	~GLuaStatePool();
+
+	GLuaPooledState * acquire();
+	void release(GLuaPooledState * state);
+
+	// Creates states until there are count idle ones.
+	void reserve(size_t count);
+
+	size_t getIdleCount() const;
+	size_t getTotalCount() const;
+
+private:
+	std::unique_ptr<GLuaStatePoolImplement> implement;
+};
+
+class GLuaPooledStateGuard : public GNoncopyable
+{
+public:
+	explicit GLuaPooledStateGuard(GLuaStatePool * pool)
+		: pool(pool), state(pool->acquire())
+	{
+	}
+
+	~GLuaPooledStateGuard() {
+		this->pool->release(this->state);
+	}
+
+	GLuaPooledState * get() const {
+		return this->state;
+	}
+
+	GLuaPooledState * operator -> () const {
+		return this->state;
+	}
+
+private:
+	GLuaStatePool * pool;
+	GLuaPooledState * state;
+};
+
+
+} // namespace cpgf
+
+
+
+#endif
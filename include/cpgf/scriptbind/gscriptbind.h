@@ -29,6 +29,18 @@ enum class GScriptInstanceCv {
 	sicvCount
 };
 
+// Metrics of the arena which holds the parameters of the C++ callables invoked from script.
+// depth is the number of nested invocations in progress, such as script -> C++ -> script -> C++.
+// Each thread calling into the script context has its own arena, the stat is of the calling thread.
+struct GScriptCallStackStat
+{
+	uint32_t depth;
+	uint32_t maxDepth;
+	uint32_t usedBytes;
+	uint32_t peakUsedBytes;
+	uint32_t reservedBytes;
+};
+
 struct IScriptContext : public IObject
 {
 	virtual void G_API_CC addScriptUserConverter(IScriptUserConverter * converter) = 0;
@@ -37,6 +49,7 @@ struct IScriptContext : public IObject
 	virtual IScriptUserConverter * G_API_CC getScriptUserConverterAt(uint32_t index) = 0;
 	virtual void G_API_CC setAllowGC(const GVariantData * instance, gapi_bool allowGC) = 0;
 	virtual void G_API_CC bindExternalObjectToClass(void * address, IMetaClass * metaClass) = 0;
+	virtual void G_API_CC getCallStackStat(GScriptCallStackStat * outStat) = 0;
 };
 
 class GScriptObject
@@ -75,7 +88,8 @@ public:
 
 	virtual bool maybeIsScriptArray(const char * name) = 0;
 	virtual GScriptValue getAsScriptArray(const char * name) = 0;
-	virtual GScriptValue createScriptArray(const char * name) = 0;
+	// reserveLength is a hint of how many elements will be put in the array.
+	virtual GScriptValue createScriptArray(const char * name, size_t reserveLength = 0) = 0;
 
 	virtual IScriptContext * getContext() const = 0;
 
@@ -16,6 +16,10 @@ public:
 	virtual void G_API_CC invokeIndirectly(GScriptValueData * outResult, GVariantData const * const * params, uint32_t paramCount) = 0;
 	virtual void G_API_CC invokeOnObject(GScriptValueData * outResult, const GVariantData * params, uint32_t paramCount) = 0;
 	virtual void G_API_CC invokeIndirectlyOnObject(GScriptValueData * outResult, GVariantData const * const * params, uint32_t paramCount) = 0;
+
+	// params has paramCount arrays of batchCount elements, call i gets params[0][i], params[1][i], and so on.
+	// outResults, if not nullptr, receives batchCount results.
+	virtual void G_API_CC invokeBatch(GScriptValueData * outResults, GVariantData const * const * params, uint32_t paramCount, uint32_t batchCount) = 0;
 };
 
 
@@ -29,6 +33,10 @@ public:
 	virtual gapi_bool G_API_CC maybeIsScriptArray(uint32_t index) = 0;
 	virtual void G_API_CC getAsScriptArray(GScriptValueData * outResult, uint32_t index) = 0;
 	virtual void G_API_CC createScriptArray(GScriptValueData * outResult, uint32_t index) = 0;
+
+	// vt is a fundamental GVariantType, data points to count elements of that type.
+	virtual void G_API_CC setFundamentalArray(uint32_t index, const void * data, uint32_t count, GVtType vt) = 0;
+	virtual uint32_t G_API_CC getFundamentalArray(uint32_t index, void * outData, uint32_t count, GVtType vt) = 0;
 };
 
 
@@ -6,6 +6,9 @@
 #include "cpgf/scriptbind/gscriptbindapi.h"
 #include "cpgf/gtypeutil.h"
 
+#include <vector>
+#include <type_traits>
+
 namespace cpgf {
 
 template <typename T>
@@ -67,6 +70,19 @@ void loadVariantDataList(GVariant * variantList, GVariantData ** variantDataList
 	GTypeForEach<sizeof...(Parameters)>::template forEach<LoadVariantDataListFunc>(param);
 }
 
+inline void loadVariantBatchList(GVariant * /*variantList*/, size_t /*batchCount*/)
+{
+}
+
+template <typename T, typename... Rest>
+void loadVariantBatchList(GVariant * variantList, size_t batchCount, const T * values, const Rest * ... rest)
+{
+	for(size_t i = 0; i < batchCount; ++i) {
+		variantList[i] = createTypedVariant(values[i]);
+	}
+	loadVariantBatchList(variantList + batchCount, batchCount, rest...);
+}
+
 // This function is defined in gscriptvalue.cpp internally.
 GScriptValue createScriptValueFromData(const GScriptValueData & data);
 
@@ -139,6 +155,39 @@ GScriptValue invokeScriptFunctionOnObject(IScriptFunction * scriptFunction, cons
 	return createScriptValueFromData(data);
 }
 
+// Invoke scriptFunction batchCount times, call i gets element i of each parameter array.
+// If outResults is not nullptr, it receives the batchCount results.
+template <typename... Parameters>
+void invokeScriptFunctionBatch(IScriptFunction * scriptFunction, GScriptValue * outResults, size_t batchCount, const Parameters * ... parameterArrays)
+{
+	constexpr size_t paramCount = sizeof...(Parameters);
+
+	// Hold the object so metaCheckError won't crash if scriptFunction is freed in invoke
+	GSharedInterface<IScriptFunction> holder(scriptFunction);
+
+	std::vector<GVariant> variantList(paramCount * batchCount);
+	loadVariantBatchList(variantList.data(), batchCount, parameterArrays...);
+
+	// The data is borrowed from variantList.
+	std::vector<GVariantData> variantDataList(variantList.size());
+	const GVariantData * variantDataArrays[paramCount == 0 ? 1 : paramCount];
+	for(size_t i = 0; i < variantList.size(); ++i) {
+		variantDataList[i] = variantList[i].refData();
+	}
+	for(size_t n = 0; n < paramCount; ++n) {
+		variantDataArrays[n] = variantDataList.data() + n * batchCount;
+	}
+
+	std::vector<GScriptValueData> resultDataList(outResults != nullptr ? batchCount : 0);
+	scriptFunction->invokeBatch(outResults != nullptr ? resultDataList.data() : nullptr,
+		variantDataArrays, (uint32_t)paramCount, (uint32_t)batchCount);
+	metaCheckError(scriptFunction);
+
+	for(size_t i = 0; i < resultDataList.size(); ++i) {
+		outResults[i] = createScriptValueFromData(resultDataList[i]);
+	}
+}
+
 
 GScriptValue scriptGetValue(GScriptObject * scriptObject, const char * name);
 GScriptValue scriptGetValue(IScriptObject * scriptObject, const char * name);
@@ -151,7 +200,7 @@ GScriptValue scriptCreateScriptObject(IScriptObject * scriptObject, const char *
 GScriptValue scriptGetAsScriptArray(GScriptObject * scriptObject, const char * name);
 GScriptValue scriptGetAsScriptArray(IScriptObject * scriptObject, const char * name);
 
-GScriptValue scriptCreateScriptArray(GScriptObject * scriptObject, const char * name);
+GScriptValue scriptCreateScriptArray(GScriptObject * scriptObject, const char * name, size_t reserveLength = 0);
 GScriptValue scriptCreateScriptArray(IScriptObject * scriptObject, const char * name);
 
 GScriptValue scriptGetScriptArrayValue(IScriptArray * scriptArray, size_t index);
@@ -159,6 +208,43 @@ void scriptSetScriptArrayValue(IScriptArray * scriptArray, size_t index, const G
 GScriptValue scriptGetAsScriptArray(IScriptArray * scriptArray, size_t index);
 GScriptValue scriptCreateScriptArray(IScriptArray * scriptArray, size_t index);
 
+// Bulk conversion between a C++ array of fundamentals and a script array,
+// in one call instead of one scriptSetScriptArrayValue per element.
+template <typename T>
+void scriptSetScriptArrayValues(IScriptArray * scriptArray, size_t index, const T * data, size_t count)
+{
+	static_assert(std::is_fundamental<T>::value, "Only arrays of fundamentals can be set in bulk.");
+
+	GVarTypeData typeData;
+	deduceVariantType<T>(typeData);
+	scriptArray->setFundamentalArray((uint32_t)index, data, (uint32_t)count, typeData.vt);
+}
+
+template <typename T>
+void scriptSetScriptArrayValues(IScriptArray * scriptArray, size_t index, const std::vector<T> & values)
+{
+	scriptSetScriptArrayValues(scriptArray, index, values.data(), values.size());
+}
+
+// Returns the number of elements read.
+template <typename T>
+size_t scriptGetScriptArrayValues(IScriptArray * scriptArray, size_t index, T * outData, size_t count)
+{
+	static_assert(std::is_fundamental<T>::value, "Only arrays of fundamentals can be got in bulk.");
+
+	GVarTypeData typeData;
+	deduceVariantType<T>(typeData);
+	return scriptArray->getFundamentalArray((uint32_t)index, outData, (uint32_t)count, typeData.vt);
+}
+
+// Replaces outValues with the whole script array.
+template <typename T>
+void scriptGetScriptArrayValues(IScriptArray * scriptArray, std::vector<T> * outValues)
+{
+	outValues->resize(scriptArray->getLength());
+	outValues->resize(scriptGetScriptArrayValues(scriptArray, 0, outValues->data(), outValues->size()));
+}
+
 IScriptObject * scriptObjectToInterface(GScriptObject * scriptObject, bool freeObject);
 IScriptObject * scriptObjectToInterface(GScriptObject * scriptObject);
 
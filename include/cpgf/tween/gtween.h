@@ -26,42 +26,42 @@ public:
 	template <typename AccessorType>
 	GTween & target(const AccessorType & accessor, const typename AccessorType::ValueType & targetValue)
 	{
-		this->itemList.push_back(new tween_internal::GTweenTargetItem<AccessorType>(accessor, accessor(), targetValue, 0));
+		this->addItem(new tween_internal::GTweenTargetItem<AccessorType>(accessor, accessor(), targetValue, 0));
 		return *this;
 	}
 
 	template <typename AccessorType>
 	GTween & target(const AccessorType & accessor, const typename AccessorType::ValueType & from, const typename AccessorType::ValueType & targetValue)
 	{
-		this->itemList.push_back(new tween_internal::GTweenTargetItem<AccessorType>(accessor, from, targetValue, tween_internal::ttifHasFrom));
+		this->addItem(new tween_internal::GTweenTargetItem<AccessorType>(accessor, from, targetValue, tween_internal::ttifHasFrom));
 		return *this;
 	}
 
 	template <typename AccessorType>
 	GTween & relative(const AccessorType & accessor, const typename AccessorType::ValueType & relativeValue)
 	{
-		this->itemList.push_back(new tween_internal::GTweenTargetItem<AccessorType>(accessor, accessor(), relativeValue, tween_internal::ttifRelative));
+		this->addItem(new tween_internal::GTweenTargetItem<AccessorType>(accessor, accessor(), relativeValue, tween_internal::ttifRelative));
 		return *this;
 	}
 
 	template <typename AccessorType>
 	GTween & relative(const AccessorType & accessor, const typename AccessorType::ValueType & from, const typename AccessorType::ValueType & relativeValue)
 	{
-		this->itemList.push_back(new tween_internal::GTweenTargetItem<AccessorType>(accessor, from, relativeValue, tween_internal::ttifRelative | tween_internal::ttifHasFrom));
+		this->addItem(new tween_internal::GTweenTargetItem<AccessorType>(accessor, from, relativeValue, tween_internal::ttifRelative | tween_internal::ttifHasFrom));
 		return *this;
 	}
 
 	template <typename AccessorType, typename TargetGetterType>
 	GTween & follow(const AccessorType & accessor, const TargetGetterType & targetGetter)
 	{
-		this->itemList.push_back(new tween_internal::GTweenFollowItem<AccessorType, TargetGetterType>(accessor, accessor(), targetGetter));
+		this->addItem(new tween_internal::GTweenFollowItem<AccessorType, TargetGetterType>(accessor, accessor(), targetGetter));
 		return *this;
 	}
 
 	template <typename AccessorType, typename TargetGetterType>
 	GTween & follow(const AccessorType & accessor, const typename AccessorType::ValueType & from, const TargetGetterType & targetGetter)
 	{
-		this->itemList.push_back(new tween_internal::GTweenFollowItem<AccessorType, TargetGetterType>(accessor, from, targetGetter));
+		this->addItem(new tween_internal::GTweenFollowItem<AccessorType, TargetGetterType>(accessor, from, targetGetter));
 		return *this;
 	}
 
@@ -86,11 +86,18 @@ protected:
 	virtual void performTime(GTweenNumber elapsed, GTweenNumber frameDuration, bool forceReversed, bool forceUseFrames);
 	virtual void initialize();
 
+private:
+	// Also tells the owner list the instance of the item, so GTweenList::removeForInstance can find this tween.
+	void addItem(tween_internal::GTweenItem * item);
+
 private:
 	GTweenEaseType easeCallback;
 	GTweenNumber durationTime;
 
 	ListType itemList;
+
+private:
+	friend class GTweenList;
 };
 
 
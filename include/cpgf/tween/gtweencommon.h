@@ -8,6 +8,8 @@
 
 namespace cpgf {
 
+class GTweenList;
+
 typedef float GTweenNumber;
 
 struct GTweenEaseParam
@@ -134,6 +136,8 @@ public:
 protected:
 	void doTick(GTweenNumber frameDuration, bool forceReversed, bool forceUseFrames);
 	void doComplete(bool emitEvent);
+	// Calls callback, or queues it if the tweenable is being ticked by GTweenScheduler in parallel.
+	void invokeCallback(const GTweenCallback & callback);
 	
 	virtual void performTime(GTweenNumber elapsed, GTweenNumber frameDuration, bool forceReversed, bool forceUseFrames) = 0;
 	virtual void doRestartChildren();
@@ -160,9 +164,14 @@ protected:
 	GTweenCallback callbackOnUpdate;
 	GTweenCallback callbackOnRepeat;
 
+	// The list owning this tweenable and the slot in it, they are maintained by GTweenList.
+	GTweenList * ownerList;
+	size_t ownerSlot;
+
 	/// @cond Make Doxygen happy
 private:
 	friend class GTimeline;
+	friend class GTweenList;
 	/// @endcond
 };
 
@@ -4,7 +4,8 @@
 #include "cpgf/tween/gtween.h"
 #include "cpgf/gmemorypool.h"
 
-#include <list>
+#include <vector>
+#include <unordered_map>
 #include <memory>
 
 namespace cpgf {
@@ -25,6 +26,8 @@ protected:
 		bool isTimeline() const;
 		bool hasAddedToTimeline() const;
 		void addToTimeline();
+		// A removed slot is kept until the list is compacted.
+		bool isRemoved() const;
 	public:
 		GTweenNumber startTime;
 		GTweenable * tweenable;
@@ -32,7 +35,11 @@ protected:
 		GFlags<int> flags;
 	};
 
-	typedef std::list<TweenableData> ListType;
+	// The tweenables are stored contiguously in the order they are created.
+	// Removing one only clears its slot, which is O(1), the slots are compacted
+	// in the next tick. The slot of a tweenable is stored in GTweenable::ownerSlot,
+	// so the tweenable pointer is a stable handle.
+	typedef std::vector<TweenableData> ListType;
 
 
 public:
@@ -48,6 +55,11 @@ public:
 	size_t getTweenableCount() const;
 	void clear();
 
+	// Lets GTweenScheduler tick this list on a worker thread, together with the other
+	// parallel lists. Only turn it on if no other parallel list animates the same targets.
+	GTweenList & tickInParallel(bool value);
+	bool isTickInParallel() const;
+
 public:
 	void remove(const GTweenable & tweenable);
 	virtual GTweenNumber getDuration() const;
@@ -60,11 +72,35 @@ protected:
 
 protected:
 	void freeTween(GTweenable * tween, bool isTimeline);
+	void removeAt(size_t slot);
+	void compact();
+	// Returns nullptr if tweenable doesn't belong to this list.
+	TweenableData * findTweenableData(const GTweenable & tweenable);
+
+private:
+	void addTweenable(GTweenable * tweenable, bool isTimeline);
+
+	void addInstanceIndex(const void * instance, GTween * tween);
+	void removeInstanceIndex(const void * instance, GTween * tween);
+	void removeAllInstanceIndex(GTween * tween);
 
 protected:
 	GTweenList::ListType tweenList;
+	size_t removedCount;
+	bool parallel;
 	GObjectPool<GTween> tweenPool;
 	std::unique_ptr<GObjectPool<GTimeline> > timelinePool;
+
+private:
+	typedef std::unordered_map<const void *, std::vector<GTween *> > InstanceMapType;
+
+	// The tweens having items of an instance, for removeForInstance.
+	// The tweens inside the child timelines are indexed by the timelines.
+	InstanceMapType instanceMap;
+	std::vector<GTimeline *> timelineList;
+
+private:
+	friend class GTween;
 };
 
 
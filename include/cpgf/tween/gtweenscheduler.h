@@ -0,0 +1,49 @@
+#ifndef CPGF_GTWEENSCHEDULER_H
+#define CPGF_GTWEENSCHEDULER_H
+
+#include "cpgf/tween/gtweencommon.h"
+#include "cpgf/gclassutil.h"
+
+#include <memory>
+#include <cstddef>
+
+
+namespace cpgf {
+
+class GTweenList;
+class GTweenSchedulerImplement;
+
+// Ticks a set of tween lists (GTweenList or GTimeline) once per frame.
+// The lists with tickInParallel(true) are ticked on a pool of worker threads,
+// the calling thread takes part too. Each worker takes the next list not ticked yet.
+// The other lists are ticked on the calling thread first, in the order they were added.
+// The onComplete, onUpdate, onRepeat and onDestroy callbacks of the parallel lists are
+// queued while ticking, then called on the calling thread after all parallel lists are done,
+// list by list in the order the lists were added, so the order doesn't depend on the threads.
+// onInitialize is called on the worker thread because the tween reads its start values after it.
+class GTweenScheduler : public GNoncopyable
+{
+public:
+	// threadCount is the number of worker threads besides the calling thread.
+	// -1 means one less than the hardware threads.
+	explicit GTweenScheduler(int threadCount = -1);
+	~GTweenScheduler();
+
+	// The scheduler doesn't own the lists.
+	void add(GTweenList * tweenList);
+	void remove(GTweenList * tweenList);
+
+	void tick(GTweenNumber frameDuration);
+
+	size_t getThreadCount() const;
+
+private:
+	std::unique_ptr<GTweenSchedulerImplement> implement;
+};
+
+
+} // namespace cpgf
+
+
+
+#endif
@@ -33,6 +33,7 @@ int Error_Meta_NotUnaryOperator		= Error_Meta_Begin + 6;
 int Error_Meta_NotBinaryOperator		= Error_Meta_Begin + 7;
 int Error_Meta_NotFunctorOperator		= Error_Meta_Begin + 8;
 int Error_Meta_WrongArity				= Error_Meta_Begin + 9;
+int Error_Meta_CantResizeExportedBuffer	= Error_Meta_Begin + 10;
 int Error_Meta_End					= 200;
 
 int Error_ScriptBinding_Begin			= 201;
@@ -57,6 +58,7 @@ int Error_ScriptBinding_CantFindMatchedOperator		= Error_ScriptBinding_Begin + 1
 int Error_ScriptBinding_NotSupportedFeature		= Error_ScriptBinding_Begin + 18;
 int Error_ScriptBinding_CantSetScriptValue		= Error_ScriptBinding_Begin + 19;
 int Error_ScriptBinding_CantFindObject = Error_ScriptBinding_Begin + 21;
+int Error_ScriptBinding_ScriptArrayIndexOutOfRange = Error_ScriptBinding_Begin + 22;
 int Error_ScriptBinding_End			= 300;
 
 int Error_Serialization_Begin = 301;
@@ -128,6 +130,7 @@ namespace {
 		{ Error_Meta_NotUnaryOperator, "Can't invoke non-unary operator." },
 		{ Error_Meta_NotBinaryOperator, "Can't invoke non-binary operator." },
 		{ Error_Meta_NotFunctorOperator, "Can't invoke non-functor operator." },
+		{ Error_Meta_CantResizeExportedBuffer, "Can't resize the buffer while its memory is exported." },
 
 		{ Error_ScriptBinding_FailVariantToScript,				"Can't convert variant to script object." },
 		{ Error_ScriptBinding_CallMethodWithTooManyParameters,	"Too many parameters." },
@@ -165,6 +168,7 @@ namespace {
 		{ Error_ScriptBinding_ScriptFunctionReturnError,		"Error when calling function %s, message: %s" },
 		{ Error_ScriptBinding_CantReturnMultipleValue,			"Can't return multiple value when calling function %s" },
 		{ Error_ScriptBinding_NotSupportedFeature,				"Feature %s it not supported by script binding for %s" },
+		{ Error_ScriptBinding_ScriptArrayIndexOutOfRange,		"Index %d is beyond the end of the script array, the length is %d." },
 	};
 
 	const char * notFoundErrorMessage = "Can't find error message.";
@@ -3,6 +3,7 @@
 #include "gstaticuninitializerorders.h"
 
 #include <thread>
+#include <mutex>
 #include <cassert>
 
 using namespace std;
@@ -25,9 +26,58 @@ T * alignPointer(T * p, const size_t alignment)
 	return (T *)(alignSize((size_t)p, alignment));
 }
 
+struct GMemoryPoolChunkOwner
+{
+	const void * end;
+	GMemoryPool * pool;
+};
+
+// Maps the chunks of all thread pools to their pools, so a block freed on another thread
+// finds its pool. It's locked only when a chunk is added or removed, a block is freed on
+// another thread, or a thread starts or exits.
+// The mutex is recursive because an orphaned pool is used with it locked, and may add or remove chunks.
+// The registry is never destroyed, static objects may free blocks after the threads exited.
+struct GMemoryPoolRegistry
+{
+	std::recursive_mutex mutex;
+	std::map<const void *, GMemoryPoolChunkOwner> chunkMap;
+	std::vector<GMemoryPool *> idlePoolList;
+	GMemoryPool * exitedThreadPool = nullptr;
+};
+
+GMemoryPoolRegistry * getMemoryPoolRegistry()
+{
+	static GMemoryPoolRegistry * registry = new GMemoryPoolRegistry();
+	return registry;
+}
+
+thread_local GMemoryPool * currentThreadPool = nullptr;
+thread_local bool currentThreadExited = false;
+
 
 } //unnamed namespace
 
+// Gives the pool back to the registry when its thread exits.
+class GMemoryPoolThreadHolder
+{
+public:
+	~GMemoryPoolThreadHolder();
+};
+
+GMemoryPoolThreadHolder::~GMemoryPoolThreadHolder()
+{
+	GMemoryPool * pool = currentThreadPool;
+	currentThreadPool = nullptr;
+	currentThreadExited = true;
+
+	GMemoryPoolRegistry * registry = getMemoryPoolRegistry();
+	std::lock_guard<std::recursive_mutex> lockGuard(registry->mutex);
+
+	pool->freeRemoteBlocksLocked();
+	pool->orphaned = true;
+	registry->idlePoolList.push_back(pool);
+}
+
 GMemoryPoolChunk::GMemoryPoolChunk(
 		const size_t blockSize,
 		const size_t alignment,
@@ -81,19 +131,42 @@ void GMemoryPoolChunk::free(void * p)
 GMemorySizedPool::GMemorySizedPool(
 		const size_t blockSize,
 		const size_t alignment,
-		const size_t blockCount
+		const size_t blockCount,
+		GMemoryPool * ownerPool
 	)
 	:
 		blockSize(blockSize),
 		alignment(alignment),
-		blockCount(blockCount)
+		blockCount(blockCount),
+		ownerPool(ownerPool)
 {
-	this->chunkList.emplace_back(blockSize, alignment, blockCount);
+	this->addChunk();
 	this->availableChunk = &this->chunkList.back();
 }
 
 GMemorySizedPool::~GMemorySizedPool()
 {
+	if(this->ownerPool != nullptr) {
+		for(const GMemoryPoolChunk & chunk : this->chunkList) {
+			this->ownerPool->chunkRemoved(chunk);
+		}
+	}
+}
+
+void GMemorySizedPool::addChunk()
+{
+	this->chunkList.emplace_back(blockSize, alignment, blockCount);
+	if(this->ownerPool != nullptr) {
+		this->ownerPool->chunkAdded(this->chunkList.back());
+	}
+}
+
+void GMemorySizedPool::removeBackChunk()
+{
+	if(this->ownerPool != nullptr) {
+		this->ownerPool->chunkRemoved(this->chunkList.back());
+	}
+	this->chunkList.pop_back();
 }
 
 void * GMemorySizedPool::allocate()
@@ -107,7 +180,7 @@ void * GMemorySizedPool::allocate()
 			}
 		}
 		if(this->availableChunk == nullptr) {
-			this->chunkList.emplace_back(blockSize, alignment, blockCount);
+			this->addChunk();
 			this->availableChunk = &this->chunkList.back();
 		}
 	}
@@ -115,7 +188,7 @@ void * GMemorySizedPool::allocate()
 	return this->availableChunk->allocate();
 }
 
-void GMemorySizedPool::free(void * p)
+bool GMemorySizedPool::free(void * p)
 {
 	GMemoryPoolChunk * chunk = nullptr;
 	if(this->availableChunk->belongsTo(p)) {
@@ -132,10 +205,11 @@ void GMemorySizedPool::free(void * p)
 		}
 	}
 	
-	assert(chunk != nullptr);
+	if(chunk == nullptr) {
+		return false;
+	}
 
-	if(chunk != nullptr && chunk->isIdle()
-	) {
+	if(chunk->isIdle()) {
 		// If chunk is free and the back() is not, swap chunk to back(),
 		// If chunk is free and the back() is free too, free back() and swap chunk to back();
 		// Finally we will have up to only one free chunk and the free chunk is at the back().
@@ -147,7 +221,7 @@ void GMemorySizedPool::free(void * p)
 
 		if(chunk != &this->chunkList.back()) {
 			if(this->chunkList.back().isIdle()) {
-				this->chunkList.pop_back();
+				this->removeBackChunk();
 			}
 		}
 
@@ -159,14 +233,53 @@ void GMemorySizedPool::free(void * p)
 			this->availableChunk = &this->chunkList.back();
 		}
 	}
+
+	return true;
 }
 
 
 GMemoryPool * GMemoryPool::getInstance()
 {
-	static GMemoryPool instance(memoryPoolAlignment, memoryPoolBlockCountPerTrunk);
-	
-	return &instance;
+	GMemoryPool * pool = currentThreadPool;
+	if(pool != nullptr) {
+		return pool;
+	}
+
+	return acquireThreadPool();
+}
+
+GMemoryPool * GMemoryPool::acquireThreadPool()
+{
+	GMemoryPoolRegistry * registry = getMemoryPoolRegistry();
+	std::lock_guard<std::recursive_mutex> lockGuard(registry->mutex);
+
+	if(currentThreadExited) {
+		// Called by the destructors of thread local or static objects after the thread pool is given back.
+		// The pool for them stays orphaned, so it's always used with the registry locked.
+		if(registry->exitedThreadPool == nullptr) {
+			registry->exitedThreadPool = new GMemoryPool(memoryPoolAlignment, memoryPoolBlockCountPerTrunk);
+			registry->exitedThreadPool->threadPool = true;
+			registry->exitedThreadPool->orphaned = true;
+		}
+		return registry->exitedThreadPool;
+	}
+
+	GMemoryPool * pool;
+	if(! registry->idlePoolList.empty()) {
+		pool = registry->idlePoolList.back();
+		registry->idlePoolList.pop_back();
+		pool->orphaned = false;
+	}
+	else {
+		pool = new GMemoryPool(memoryPoolAlignment, memoryPoolBlockCountPerTrunk);
+		pool->threadPool = true;
+	}
+
+	static thread_local GMemoryPoolThreadHolder threadHolder;
+	(void)threadHolder;
+	currentThreadPool = pool;
+
+	return pool;
 }
 
 GMemoryPool::GMemoryPool(
@@ -175,7 +288,12 @@ GMemoryPool::GMemoryPool(
 	)
 	:
 		alignment(alignment),
-		blockCountPerChunk(blockCountPerChunk)
+		blockCountPerChunk(blockCountPerChunk),
+		poolMap(),
+		threadPool(false),
+		orphaned(false),
+		hasRemoteBlock(false),
+		remoteBlockList()
 {
 }
 
@@ -184,6 +302,39 @@ GMemoryPool::~GMemoryPool()
 }
 
 void * GMemoryPool::allocate(const size_t size)
+{
+	if(this->orphaned) {
+		std::lock_guard<std::recursive_mutex> lockGuard(getMemoryPoolRegistry()->mutex);
+		return this->doAllocate(size);
+	}
+
+	if(this->hasRemoteBlock.load(std::memory_order_acquire)) {
+		this->freeRemoteBlocks();
+	}
+
+	return this->doAllocate(size);
+}
+
+void GMemoryPool::free(void * p, const size_t size)
+{
+	if(this->orphaned) {
+		std::lock_guard<std::recursive_mutex> lockGuard(getMemoryPoolRegistry()->mutex);
+		if(! this->doFree(p, size)) {
+			this->freeOnOwnerPool(p, size);
+		}
+		return;
+	}
+
+	if(this->hasRemoteBlock.load(std::memory_order_acquire)) {
+		this->freeRemoteBlocks();
+	}
+
+	if(! this->doFree(p, size) && this->threadPool) {
+		this->freeOnOwnerPool(p, size);
+	}
+}
+
+void * GMemoryPool::doAllocate(const size_t size)
 {
 	GMemorySizedPool * pool = nullptr;
 
@@ -194,25 +345,84 @@ void * GMemoryPool::allocate(const size_t size)
 		pool = it->second.get();
 	}
 	else {
-		pool = new GMemorySizedPool(alignedSize, this->alignment, this->blockCountPerChunk);
+		pool = new GMemorySizedPool(alignedSize, this->alignment, this->blockCountPerChunk, (this->threadPool ? this : nullptr));
 		this->poolMap.insert(std::make_pair(alignedSize, std::unique_ptr<GMemorySizedPool>(pool)));
 	}
 	
 	return pool->allocate();
 }
 
-void GMemoryPool::free(void * p, const size_t size)
+bool GMemoryPool::doFree(void * p, const size_t size)
 {
 	const size_t alignedSize = alignSize(size, this->alignment);
 	
 	auto it = this->poolMap.find(alignedSize);
 	if(it != this->poolMap.end()) {
-		it->second->free(p);
+		return it->second->free(p);
+	}
+
+	return false;
+}
+
+void GMemoryPool::freeRemoteBlocks()
+{
+	std::lock_guard<std::recursive_mutex> lockGuard(getMemoryPoolRegistry()->mutex);
+	this->freeRemoteBlocksLocked();
+}
+
+void GMemoryPool::freeRemoteBlocksLocked()
+{
+	for(const std::pair<void *, size_t> & block : this->remoteBlockList) {
+		this->doFree(block.first, block.second);
+	}
+	this->remoteBlockList.clear();
+	this->hasRemoteBlock.store(false, std::memory_order_relaxed);
+}
+
+// p is allocated by the pool of another thread.
+void GMemoryPool::freeOnOwnerPool(void * p, const size_t size)
+{
+	GMemoryPoolRegistry * registry = getMemoryPoolRegistry();
+	std::lock_guard<std::recursive_mutex> lockGuard(registry->mutex);
+
+	auto it = registry->chunkMap.upper_bound(p);
+	if(it == registry->chunkMap.begin()) {
+		assert(false);
+		return;
+	}
+	--it;
+	if(p >= it->second.end) {
+		assert(false);
+		return;
+	}
+
+	GMemoryPool * ownerPool = it->second.pool;
+	if(ownerPool->orphaned) {
+		ownerPool->doFree(p, size);
 	}
 	else {
+		ownerPool->remoteBlockList.push_back(std::make_pair(p, size));
+		ownerPool->hasRemoteBlock.store(true, std::memory_order_release);
 	}
 }
 
+void GMemoryPool::chunkAdded(const GMemoryPoolChunk & chunk)
+{
+	GMemoryPoolRegistry * registry = getMemoryPoolRegistry();
+	std::lock_guard<std::recursive_mutex> lockGuard(registry->mutex);
+
+	const GMemoryPoolChunkOwner owner = { chunk.getBufferEnd(), this };
+	registry->chunkMap[chunk.getBufferBegin()] = owner;
+}
+
+void GMemoryPool::chunkRemoved(const GMemoryPoolChunk & chunk)
+{
+	GMemoryPoolRegistry * registry = getMemoryPoolRegistry();
+	std::lock_guard<std::recursive_mutex> lockGuard(registry->mutex);
+
+	registry->chunkMap.erase(chunk.getBufferBegin());
+}
+
 
 G_GUARD_LIBRARY_LIFE
 
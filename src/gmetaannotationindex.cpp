@@ -0,0 +1,151 @@
+#include "cpgf/gmetaannotationindex.h"
+#include "cpgf/gmetaannotation.h"
+#include "cpgf/gmetaclass.h"
+#include "cpgf/gstringutil.h"
+
+#include <unordered_map>
+
+#include <string.h>
+#include <wchar.h>
+
+
+namespace cpgf {
+
+class GMetaAnnotationIndexImplement
+{
+public:
+	// The keys are the names of the annotations, which live as long as the meta data.
+	typedef std::unordered_map<const char *, GMetaAnnotationIndex::EntryListType, GCStringHash, GCStringEqual> MapType;
+
+public:
+	explicit GMetaAnnotationIndexImplement(const GMetaClass * rootClass)
+		: rootClass(rootClass), built(false) {
+	}
+
+	void build() {
+		this->annotationMap.clear();
+		this->indexClass(this->rootClass);
+		this->built = true;
+	}
+
+private:
+	void indexClass(const GMetaClass * metaClass) {
+		this->indexItem(metaClass);
+
+		const size_t count = metaClass->getMetaCount();
+		for(size_t i = 0; i < count; ++i) {
+			const GMetaItem * item = metaClass->getMetaAt(i);
+			if(metaIsClass(item->getCategory())) {
+				this->indexClass(static_cast<const GMetaClass *>(item));
+			}
+			else {
+				this->indexItem(item);
+			}
+		}
+	}
+
+	void indexItem(const GMetaItem * item) {
+		const size_t count = item->getAnnotationCount();
+		for(size_t i = 0; i < count; ++i) {
+			const GMetaAnnotation * annotation = item->getAnnotationAt(i);
+			GMetaAnnotationIndexEntry entry = { item, annotation };
+			this->annotationMap[annotation->getName().c_str()].push_back(entry);
+		}
+	}
+
+public:
+	const GMetaClass * rootClass;
+	bool built;
+	MapType annotationMap;
+};
+
+
+namespace {
+
+bool isCategoryMatched(const GMetaItem * item, GMetaCategory category)
+{
+	return category == mcatCount || item->getCategory() == category;
+}
+
+bool isAnnotationValueEqual(const GAnnotationValue * a, const GAnnotationValue & b)
+{
+	if(a->canToString() || b.canToString()) {
+		return a->canToString() && b.canToString() && strcmp(a->toString(), b.toString()) == 0;
+	}
+	if(a->canToWideString() || b.canToWideString()) {
+		return a->canToWideString() && b.canToWideString() && wcscmp(a->toWideString(), b.toWideString()) == 0;
+	}
+	return a->canToInt() && b.canToInt() && a->toInt() == b.toInt();
+}
+
+} // unnamed namespace
+
+
+GMetaAnnotationIndex::GMetaAnnotationIndex()
+	: implement(new GMetaAnnotationIndexImplement(getGlobalMetaClass()))
+{
+}
+
+GMetaAnnotationIndex::GMetaAnnotationIndex(const GMetaClass * rootClass)
+	: implement(new GMetaAnnotationIndexImplement(rootClass))
+{
+}
+
+GMetaAnnotationIndex::~GMetaAnnotationIndex()
+{
+}
+
+void GMetaAnnotationIndex::rebuild()
+{
+	this->implement->build();
+}
+
+const GMetaAnnotationIndex::EntryListType & GMetaAnnotationIndex::getEntries(const char * annotationName) const
+{
+	static const EntryListType emptyEntryList;
+
+	this->ensureBuilt();
+
+	GMetaAnnotationIndexImplement::MapType::const_iterator it = this->implement->annotationMap.find(annotationName);
+	if(it == this->implement->annotationMap.end()) {
+		return emptyEntryList;
+	}
+
+	return it->second;
+}
+
+void GMetaAnnotationIndex::findItems(const char * annotationName, GMetaCategory category, std::vector<const GMetaItem *> * outItems) const
+{
+	const EntryListType & entryList = this->getEntries(annotationName);
+	for(EntryListType::const_iterator it = entryList.begin(); it != entryList.end(); ++it) {
+		if(isCategoryMatched(it->item, category)) {
+			outItems->push_back(it->item);
+		}
+	}
+}
+
+void GMetaAnnotationIndex::findItems(const char * annotationName, const char * valueName, const GAnnotationValue & value,
+	GMetaCategory category, std::vector<const GMetaItem *> * outItems) const
+{
+	const EntryListType & entryList = this->getEntries(annotationName);
+	for(EntryListType::const_iterator it = entryList.begin(); it != entryList.end(); ++it) {
+		if(! isCategoryMatched(it->item, category)) {
+			continue;
+		}
+
+		const GAnnotationValue * annotationValue = it->annotation->getValue(valueName);
+		if(annotationValue != nullptr && isAnnotationValueEqual(annotationValue, value)) {
+			outItems->push_back(it->item);
+		}
+	}
+}
+
+void GMetaAnnotationIndex::ensureBuilt() const
+{
+	if(! this->implement->built) {
+		this->implement->build();
+	}
+}
+
+
+} // namespace cpgf
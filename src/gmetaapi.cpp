@@ -14,6 +14,7 @@
 #include "cpgf/gmemorypool.h"
 #include "cpgf/gscopedinterface.h"
 #include "cpgf/gsharedinterface.h"
+#include "cpgf/gmetaprofile.h"
 
 #include <string>
 #include <map>
@@ -62,7 +63,8 @@ protected: \
 	virtual void * G_API_CC cloneInstance(const void * instance) { return this->doCloneInstance(instance); } \
 	virtual void * G_API_CC cloneInplace(const void * instance, void * placement) { return this->doCloneInplace(instance, placement); } \
 	virtual void G_API_CC destroyInstance(void * instance) { this->doDestroyInstance(instance); } \
-	virtual void G_API_CC destroyInplace(void * instance) { this->doDestroyInplace(instance); }
+	virtual void G_API_CC destroyInplace(void * instance) { this->doDestroyInplace(instance); } \
+	virtual gapi_bool G_API_CC isBaseType(const GTypeInfo * baseType) { return this->doIsBaseType(baseType); }
 
 #define IMPL_CALLABLE \
 protected: \
@@ -77,7 +79,8 @@ protected: \
 	virtual gapi_bool G_API_CC isExplicitThis() { return this->doIsExplicitThis(); } \
 	virtual gapi_bool G_API_CC checkParam(const GVariantData * param, uint32_t paramIndex) { return this->doCheckParam(param, paramIndex); } \
 	virtual gapi_bool G_API_CC isParamTransferOwnership(uint32_t paramIndex) { return this->doIsParamTransferOwnership(paramIndex); } \
-	virtual gapi_bool G_API_CC isResultTransferOwnership() { return this->doIsResultTransferOwnership(); }
+	virtual gapi_bool G_API_CC isResultTransferOwnership() { return this->doIsResultTransferOwnership(); } \
+	virtual gapi_bool G_API_CC isReleaseScriptLock() { return this->doIsReleaseScriptLock(); }
 
 
 #define IMPL_ACCESSIBLE \
@@ -166,6 +169,8 @@ protected:
 	void doDestroyInstance(void * instance);
 	void doDestroyInplace(void * instance);
 
+	gapi_bool doIsBaseType(const GTypeInfo * baseType);
+
 private:
 	const GMetaTypedItem * getTypedItem() const {
 		return static_cast<const GMetaTypedItem *>(this->doGetItem());
@@ -229,6 +234,7 @@ protected:
 	gapi_bool doCheckParam(const GVariantData * param, uint32_t paramIndex);
 	gapi_bool doIsParamTransferOwnership(uint32_t paramIndex);
 	gapi_bool doIsResultTransferOwnership();
+	gapi_bool doIsReleaseScriptLock();
 	IMetaConverter * doCreateResultConverter();
 
 private:
@@ -431,6 +437,8 @@ protected:
 	virtual const char * G_API_CC getKey(uint32_t index);
 	virtual void G_API_CC getValue(GVariantData * outResult, uint32_t index);
 	virtual int32_t G_API_CC findKey(const char * key);
+	virtual int64_t G_API_CC getIntValue(uint32_t index);
+	virtual int32_t G_API_CC findValue(int64_t value);
 
 private:
 	const GMetaEnum * getEnum() const {
@@ -563,6 +571,8 @@ protected:
 	virtual void * G_API_CC castFromDerived(const void * derived, uint32_t derivedIndex);
 	virtual void * G_API_CC castToDerived(const void * self, uint32_t derivedIndex);
 
+	virtual gapi_bool G_API_CC getBaseOffset(uint32_t baseIndex, ptrdiff_t * outOffset);
+
 private:
 	const GMetaClass * getClass() const {
 		return static_cast<const GMetaClass *>(this->doGetItem());
@@ -891,6 +901,16 @@ void ImplMetaTypedItem::doDestroyInplace(void * instance)
 	LEAVE_META_API()
 }
 
+gapi_bool ImplMetaTypedItem::doIsBaseType(const GTypeInfo * baseType)
+{
+	ENTER_META_API()
+
+	const GTypeInfo & itemBaseType = this->getTypedItem()->getMetaType().getBaseType();
+	return ! itemBaseType.isEmpty() && ! baseType->isEmpty() && itemBaseType == *baseType;
+
+	LEAVE_META_API(return false)
+}
+
 
 
 ImplMetaCallable::ImplMetaCallable(const GMetaCallable * callable, bool freeItem)
@@ -1022,6 +1042,12 @@ gapi_bool ImplMetaCallable::doIsResultTransferOwnership()
 	LEAVE_META_API(return false)
 }
 
+gapi_bool ImplMetaCallable::doIsReleaseScriptLock()
+{
+// Don't try/catch to avoid "unreachable code" warning. It's safe.
+	return this->getCallable()->hasModifier(metaModifierReleaseScriptLock);
+}
+
 
 ImplMetaAccessible::ImplMetaAccessible(const GMetaAccessible * accessible, bool freeItem)
 	: super(accessible, freeItem)
@@ -1143,6 +1169,7 @@ ImplMetaProperty::ImplMetaProperty(const GMetaProperty * prop, bool freeItem)
 ImplMetaMethod::ImplMetaMethod(const GMetaMethod * method, bool freeItem)
 	: super(method, freeItem)
 {
+	G_META_PROFILE_COUNT_ITEM(mpcMetaMethodInterface, method->getName().c_str());
 }
 
 void G_API_CC ImplMetaMethod::execute(GVariantData * outResult, void * instance, const GVariantData * params, uint32_t paramCount)
@@ -1418,6 +1445,24 @@ int32_t G_API_CC ImplMetaEnum::findKey(const char * key)
 	LEAVE_META_API(return -1)
 }
 
+int64_t G_API_CC ImplMetaEnum::getIntValue(uint32_t index)
+{
+	ENTER_META_API()
+
+	return this->getEnum()->getIntValue(index);
+
+	LEAVE_META_API(return 0)
+}
+
+int32_t G_API_CC ImplMetaEnum::findValue(int64_t value)
+{
+	ENTER_META_API()
+
+	return this->getEnum()->findValue(value);
+
+	LEAVE_META_API(return -1)
+}
+
 
 ImplMetaAnnotationValue::ImplMetaAnnotationValue(const GAnnotationValue * value, bool)
 	: value(value)
@@ -1557,6 +1602,7 @@ IMetaAnnotationValue * G_API_CC ImplMetaAnnotation::getValueAt(uint32_t index)
 ImplMetaClass::ImplMetaClass(const GMetaClass * cls, bool freeItem)
 	: super(cls, freeItem)
 {
+	G_META_PROFILE_COUNT_ITEM(mpcMetaClassInterface, cls->getName().c_str());
 }
 
 IMetaConstructor * G_API_CC ImplMetaClass::getConstructorByParamCount(uint32_t paramCount)
@@ -1961,6 +2007,15 @@ void * G_API_CC ImplMetaClass::castToDerived(const void * self, uint32_t derived
 	LEAVE_META_API(return nullptr)
 }
 
+gapi_bool G_API_CC ImplMetaClass::getBaseOffset(uint32_t baseIndex, ptrdiff_t * outOffset)
+{
+	ENTER_META_API()
+
+	return this->getClass()->getBaseOffset(baseIndex, outOffset);
+
+	LEAVE_META_API(return false)
+}
+
 
 
 ImplMetaModule::ImplMetaModule(GMetaModule * module, GMetaClass * metaClass)
@@ -2,6 +2,7 @@
 #include "cpgf/gmetaclass.h"
 #include "cpgf/gmetaenum.h"
 #include "cpgf/gmetafield.h"
+#include "cpgf/gmetamembertable.h"
 #include "cpgf/gmetamethod.h"
 #include "cpgf/gmetaoperator.h"
 #include "cpgf/gmetaproperty.h"
@@ -108,6 +109,11 @@ void * GMetaClassCasterBase::upCast(const void * derived) const
 	return this->virtualFunctions->upCast(const_cast<void *>(derived));
 }
 
+bool GMetaClassCasterBase::getUpCastOffset(ptrdiff_t * outOffset) const
+{
+	return this->virtualFunctions->getUpCastOffset(outOffset);
+}
+
 
 class GMetaSuperListImplement
 {
@@ -208,6 +214,7 @@ public:
 	void setClearOnFree(bool clearOnFree);
 
 	void addItem(GMetaItem * item);
+	void reserve(size_t count);
 
 	size_t getCount() const;
 
@@ -278,6 +285,11 @@ void GMetaInternalItemList::addItem(GMetaItem * item)
 	this->implement->itemMap.insert(std::make_pair(item->getName().c_str(), item));
 }
 
+void GMetaInternalItemList::reserve(size_t count)
+{
+	this->implement->itemList.reserve(count);
+}
+
 size_t GMetaInternalItemList::getCount() const
 {
 	return this->implement->itemList.size();
@@ -845,6 +857,18 @@ void * GMetaClass::castToBase(const void * self, size_t baseIndex) const
 	return this->superList->getCaster(baseIndex)->upCast(self);
 }
 
+bool GMetaClass::getBaseOffset(size_t baseIndex, ptrdiff_t * outOffset) const
+{
+	const GMetaClass * baseClass = this->getBaseClass(baseIndex);
+
+	if(baseClass == nullptr) {
+		*outOffset = 0;
+		return true;
+	}
+
+	return this->superList->getCaster(baseIndex)->getUpCastOffset(outOffset);
+}
+
 void * GMetaClass::castFromDerived(const void * derived, size_t derivedIndex) const
 {
 	const GMetaClass * derivedClass = this->getDerivedClass(derivedIndex);
@@ -912,6 +936,26 @@ void GMetaClass::setupItemLists()
 	this->implement->itemLists[mcatClass] = &this->implement->classList;
 }
 
+void GMetaClass::addMembers(const GMetaMemberDescriptor * descriptors, size_t count)
+{
+	size_t categoryCounts[mcatCount] = {};
+	for(size_t i = 0; i < count; ++i) {
+		GASSERT(descriptors[i].category == mcatField || descriptors[i].category == mcatMethod || descriptors[i].category == mcatConstructor);
+		++categoryCounts[descriptors[i].category];
+	}
+
+	for(int i = 0; i < mcatCount; ++i) {
+		if(categoryCounts[i] > 0) {
+			this->implement->itemLists[i]->reserve(this->implement->itemLists[i]->getCount() + categoryCounts[i]);
+		}
+	}
+	this->implement->metaList.reserve(this->implement->metaList.getCount() + count);
+
+	for(size_t i = 0; i < count; ++i) {
+		this->addItem(descriptors[i].category, descriptors[i].create(descriptors[i].name));
+	}
+}
+
 void GMetaClass::addItem(GMetaCategory listIndex, GMetaItem * item)
 {
 	this->implement->itemLists[listIndex]->addItem(item);
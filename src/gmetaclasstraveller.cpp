@@ -6,93 +6,106 @@
 namespace cpgf {
 
 
-GMetaClassTraveller::Node::Node(IMetaClass * metaClass, void * instance, IMetaClass * derived)
-	: metaClass(metaClass), instance(instance), derived(derived)
+GMetaClassLinearization::GMetaClassLinearization(IMetaClass * metaClass)
 {
-}
-
-GMetaClassTraveller::Node::Node(const GMetaClassTraveller::Node & other)
-	: metaClass(other.metaClass), instance(other.instance), derived(other.derived)
-{
-}
-
-GMetaClassTraveller::Node & GMetaClassTraveller::Node::operator = (GMetaClassTraveller::Node other)
-{
-	this->swap(other);
+	GASSERT(metaClass != nullptr);
 
-	return *this;
+	Node root;
+	root.metaClass.reset(metaClass);
+	root.derivedNodeIndex = 0;
+	root.baseIndex = 0;
+	root.offset = 0;
+	root.hasStaticOffset = true;
+	this->nodeList.push_back(root);
+
+	// Breadth-first walking through the inheritance hierarchy, the list itself is the queue.
+	for(size_t nodeIndex = 0; nodeIndex < this->nodeList.size(); ++nodeIndex) {
+		IMetaClass * derivedClass = this->nodeList[nodeIndex].metaClass.get();
+		const uint32_t baseCount = derivedClass->getBaseCount();
+		for(uint32_t i = 0; i < baseCount; ++i) {
+			GScopedInterface<IMetaClass> baseClass(derivedClass->getBaseClass(i));
+			if(! baseClass) {
+				continue;
+			}
+
+			Node node;
+			node.metaClass.reset(baseClass.get());
+			node.derivedNodeIndex = static_cast<uint32_t>(nodeIndex);
+			node.baseIndex = i;
+			node.offset = 0;
+			node.hasStaticOffset = false;
+			ptrdiff_t offset;
+			if(this->nodeList[nodeIndex].hasStaticOffset && derivedClass->getBaseOffset(i, &offset)) {
+				node.offset = this->nodeList[nodeIndex].offset + offset;
+				node.hasStaticOffset = true;
+			}
+			this->nodeList.push_back(node);
+		}
+	}
 }
 
-GMetaClassTraveller::Node & GMetaClassTraveller::Node::operator = (GMetaClassTraveller::Node && other)
+GMetaClassLinearization::~GMetaClassLinearization()
 {
-	this->swap(other);
-
-	return *this;
 }
 
-GMetaClassTraveller::Node::~Node()
+void * GMetaClassLinearization::getInstanceAt(size_t index, void * instance) const
 {
-}
+	if(instance == nullptr) {
+		return nullptr;
+	}
 
-void GMetaClassTraveller::Node::swap(Node & other)
-{
-	using std::swap;
+	const Node & node = this->nodeList[index];
+	if(node.hasStaticOffset) {
+		return static_cast<char *>(instance) + node.offset;
+	}
 
-	swap(this->metaClass, other.metaClass);
-	swap(this->instance, other.instance);
-	swap(this->derived, other.derived);
+	const Node & derivedNode = this->nodeList[node.derivedNodeIndex];
+	return derivedNode.metaClass->castToBase(this->getInstanceAt(node.derivedNodeIndex, instance), node.baseIndex);
 }
 
 
 GMetaClassTraveller::GMetaClassTraveller(IMetaClass * metaClass, void * instance)
+	: ownedLinearization(new GMetaClassLinearization(metaClass)), linearization(ownedLinearization.get()), instance(instance), index(0)
 {
-	GASSERT(metaClass != nullptr);
-
-	metaClass->addReference();
+}
 
-	this->traversal.emplace_back(metaClass, instance, nullptr);
+GMetaClassTraveller::GMetaClassTraveller(const GMetaClassLinearization * linearization, void * instance)
+	: ownedLinearization(), linearization(linearization), instance(instance), index(0)
+{
 }
 
 GMetaClassTraveller::~GMetaClassTraveller()
 {
-	for(ListType::iterator it = this->traversal.begin(); it != this->traversal.end(); ++it) {
-		it->metaClass->releaseReference();
-	}
 }
 
-// Breadth-first walking through the inheritance hierarchy, from the bottom (current class) to root.
 IMetaClass * GMetaClassTraveller::next(void ** outInstance, IMetaClass ** outDerived)
 {
 	if(outDerived != nullptr) {
 		*outDerived = nullptr;
 	}
-	
-	if(this->traversal.empty()) {
+
+	if(this->index >= this->linearization->getCount()) {
 		return nullptr;
 	}
-	
-	Node node = this->traversal.front();
-	this->traversal.pop_front();
-	for(uint32_t i = 0; i < node.metaClass->getBaseCount(); ++i) {
-		GScopedInterface<IMetaClass> baseClass(node.metaClass->getBaseClass(i));
-		if(baseClass) {
-			baseClass->addReference();
-			this->traversal.emplace_back(baseClass.get(), node.metaClass->castToBase(node.instance, i), node.metaClass.get());
-		}
-	}
-	
+
+	const size_t current = this->index;
+	++this->index;
+
 	if(outInstance != nullptr) {
-		*outInstance = node.instance;
+		*outInstance = this->linearization->getInstanceAt(current, this->instance);
 	}
 
 	if(outDerived != nullptr) {
-		*outDerived = node.derived.get();
-		if(node.derived) {
-			node.derived->addReference();
+		*outDerived = this->linearization->getDerivedAt(current);
+		if(*outDerived != nullptr) {
+			(*outDerived)->addReference();
 		}
 	}
-	
-	return node.metaClass.get();
+
+	IMetaClass * metaClass = this->linearization->getClassAt(current);
+	metaClass->addReference();
+
+	return metaClass;
 }
 
 IMetaClass * GMetaClassTraveller::next(void ** outInstance)
@@ -104,4 +117,3 @@ IMetaClass * GMetaClassTraveller::next(void ** outInstance)
 } // namespace cpgf
 
 
-
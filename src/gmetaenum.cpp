@@ -1,16 +1,26 @@
 #include "cpgf/gmetaenum.h"
+#include "cpgf/gstringmap.h"
 
 
 #include <vector>
+#include <algorithm>
 
 
 namespace cpgf {
 
 class GMetaEnumDataImplement
 {
+public:
+	typedef std::pair<int64_t, size_t> ValueIndexType;
+
 public:
 	std::vector<GVariant> enumerators;
 	std::vector<std::string> keyNameList;
+	std::vector<int64_t> intValueList;
+	// Key to the index of the first key.
+	GStringMap<size_t> keyIndexMap;
+	// Sorted by value then index, for binary search in findValue.
+	std::vector<ValueIndexType> sortedValueList;
 };
 
 
@@ -54,17 +64,36 @@ GVariant GMetaEnum::getValue(size_t index) const
 	}
 }
 
+int64_t GMetaEnum::getIntValue(size_t index) const
+{
+	if(index >= this->getCount()) {
+		return 0;
+	}
+	else {
+		return this->implement->intValueList[index];
+	}
+}
+
 int GMetaEnum::findKey(const char * key) const
 {
-	size_t count = this->getCount();
+	GStringMap<size_t>::const_iterator it = this->implement->keyIndexMap.find(key);
+	if(it == this->implement->keyIndexMap.end()) {
+		return -1;
+	}
 
-	for(size_t i = 0; i < count; ++i) {
-		if(strcmp(this->getKey(i), key) == 0) {
-			return static_cast<int>(i);
-		}
+	return static_cast<int>(it->second);
+}
+
+int GMetaEnum::findValue(int64_t value) const
+{
+	const std::vector<GMetaEnumDataImplement::ValueIndexType> & sortedValueList = this->implement->sortedValueList;
+	std::vector<GMetaEnumDataImplement::ValueIndexType>::const_iterator it = std::lower_bound(
+		sortedValueList.begin(), sortedValueList.end(), GMetaEnumDataImplement::ValueIndexType(value, 0));
+	if(it == sortedValueList.end() || it->first != value) {
+		return -1;
 	}
 
-	return -1;
+	return static_cast<int>(it->second);
 }
 
 GMetaEnum & GMetaEnum::operator () (const char * key, const GVariant & value)
@@ -106,8 +135,21 @@ void GMetaEnum::destroyInplace(void * /*instance*/) const
 
 void GMetaEnum::addEnum(const char * key, const GVariant & value)
 {
+	const size_t index = this->implement->enumerators.size();
+	const int64_t intValue = canFromVariant<int64_t>(value) ? fromVariant<int64_t>(value) : 0;
+
 	this->implement->keyNameList.push_back(key);
 	this->implement->enumerators.push_back(value);
+	this->implement->intValueList.push_back(intValue);
+
+	if(! this->implement->keyIndexMap.hasKey(key)) {
+		this->implement->keyIndexMap.set(key, index);
+	}
+
+	// The index is the largest so far, so it goes after the same values.
+	const GMetaEnumDataImplement::ValueIndexType valueIndex(intValue, index);
+	std::vector<GMetaEnumDataImplement::ValueIndexType> & sortedValueList = this->implement->sortedValueList;
+	sortedValueList.insert(std::upper_bound(sortedValueList.begin(), sortedValueList.end(), valueIndex), valueIndex);
 }
 
 GMetaExtendType GMetaEnum::getItemExtendType(uint32_t /*flags*/) const
@@ -1,5 +1,6 @@
 #include "cpgf/gmetamethod.h"
 #include "cpgf/gmetaclass.h"
+#include "cpgf/gmetaprofile.h"
 
 
 #define REF_CALL_LOAD_PARAM(N, unused) params[N] = & p ## N;
@@ -13,7 +14,10 @@
 		if(this->baseData->hasDefaultParam()) { \
 			passedParamCount = this->baseData->getDefaultParamList()->loadDefaultParams(params, N, this->baseData->getParamCount()); \
 		} \
-		return this->baseData->invoke(instance, params, passedParamCount); \
+		G_META_PROFILE_SAMPLE_BEGIN(sampler, mptMethodInvoke); \
+		GVariant result(this->baseData->invoke(instance, params, passedParamCount)); \
+		G_META_PROFILE_SAMPLE_END(sampler, this->getQualifiedName().c_str()); \
+		return result; \
 	}
 
 #define REF_NEW_INSTANCE(N, unused) \
@@ -196,7 +200,10 @@ GVariant GMetaMethod::execute(void * instance, const GVariant * params, size_t p
 		paramCount = this->baseData->getDefaultParamList()->loadDefaultParams(variantPointers, paramCount, this->baseData->getParamCount());
 	}
 
-	return this->baseData->invoke(instance, variantPointers, paramCount);
+	G_META_PROFILE_SAMPLE_BEGIN(sampler, mptMethodInvoke);
+	GVariant result(this->baseData->invoke(instance, variantPointers, paramCount));
+	G_META_PROFILE_SAMPLE_END(sampler, this->getQualifiedName().c_str());
+	return result;
 }
 
 GVariant GMetaMethod::executeByData(void * instance, const GVariantData * * params, size_t paramCount) const
@@ -211,7 +218,10 @@ GVariant GMetaMethod::executeByData(void * instance, const GVariantData * * para
 		paramCount = this->baseData->getDefaultParamList()->loadDefaultParamsByData(params, paramCount, this->baseData->getParamCount());
 	}
 
-	return this->baseData->invokeByData(instance, params, paramCount);
+	G_META_PROFILE_SAMPLE_BEGIN(sampler, mptMethodInvoke);
+	GVariant result(this->baseData->invokeByData(instance, params, paramCount));
+	G_META_PROFILE_SAMPLE_END(sampler, this->getQualifiedName().c_str());
+	return result;
 }
 
 bool GMetaMethod::checkParam(const GVariant & param, size_t paramIndex) const
@@ -0,0 +1,321 @@
+#include "cpgf/gmetaprofile.h"
+
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+
+using namespace std;
+
+namespace cpgf {
+
+namespace {
+
+const char * const categoryNames[] = {
+	"GlueData",
+	"ScriptValueCopy",
+	"VariantRetain",
+	"MetaClassInterface",
+	"MetaMethodInterface",
+	"LuaUserData",
+	"ObjectCreate",
+	"MethodInvoke",
+};
+
+static_assert(sizeof(categoryNames) / sizeof(categoryNames[0]) == mpcCount, "categoryNames must match GMetaProfileCategory");
+
+const char * const timingNames[] = {
+	"Resolve",
+	"BindingInvoke",
+	"MethodInvoke",
+};
+
+static_assert(sizeof(timingNames) / sizeof(timingNames[0]) == mptCount, "timingNames must match GMetaProfileTiming");
+
+const uint32_t defaultSampleInterval = 64;
+
+typedef map<string, uint64_t> ItemCountMap;
+typedef map<string, GMetaProfileSampleStat> SampleStatMap;
+
+int getHistogramBucket(uint64_t nanoseconds)
+{
+	int bucket = 0;
+	while(nanoseconds != 0 && bucket < metaProfileHistogramBucketCount - 1) {
+		nanoseconds >>= 1;
+		++bucket;
+	}
+	return bucket;
+}
+
+// The number of calls until the next sample, uniform in [1, 2 * interval - 1] so its mean is interval.
+// A fixed gap would always sample the same call of a repeating call pattern.
+uint32_t getNextSampleGap(const uint32_t interval)
+{
+	static thread_local uint32_t randomState = 0;
+
+	if(randomState == 0) {
+		// Any non zero seed works for xorshift, the address differs between threads.
+		randomState = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&randomState) >> 4) | 1;
+	}
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+
+	return static_cast<uint32_t>(1 + randomState % (2 * static_cast<uint64_t>(interval) - 1));
+}
+
+// The upper bound of the bucket which contains the percent of the samples.
+uint64_t getHistogramPercentile(const GMetaProfileSampleStat & stat, const uint64_t percent)
+{
+	const uint64_t target = (stat.sampleCount * percent + 99) / 100;
+	uint64_t count = 0;
+	for(int i = 0; i < metaProfileHistogramBucketCount; ++i) {
+		count += stat.histogram[i];
+		if(count >= target) {
+			return (uint64_t)1 << i;
+		}
+	}
+	return (uint64_t)1 << (metaProfileHistogramBucketCount - 1);
+}
+
+class GMetaProfileData
+{
+public:
+	GMetaProfileData() : sampleInterval(defaultSampleInterval) {
+		this->reset();
+	}
+
+	void count(const GMetaProfileCategory category) {
+		this->categoryCounts[category].fetch_add(1, memory_order_relaxed);
+	}
+
+	void countItem(const GMetaProfileCategory category, const char * itemName) {
+		this->count(category);
+
+		lock_guard<mutex> lockGuard(this->itemMutex);
+		++this->itemCounts[category][itemName != nullptr ? itemName : ""];
+	}
+
+	uint64_t getCount(const GMetaProfileCategory category) const {
+		return this->categoryCounts[category].load(memory_order_relaxed);
+	}
+
+	uint64_t getItemCount(const GMetaProfileCategory category, const char * itemName) {
+		lock_guard<mutex> lockGuard(this->itemMutex);
+
+		const ItemCountMap & itemMap = this->itemCounts[category];
+		ItemCountMap::const_iterator it = itemMap.find(itemName != nullptr ? itemName : "");
+		return it != itemMap.end() ? it->second : 0;
+	}
+
+	void setSampleInterval(const uint32_t interval) {
+		this->sampleInterval.store(interval, memory_order_relaxed);
+	}
+
+	uint32_t getSampleInterval() const {
+		return this->sampleInterval.load(memory_order_relaxed);
+	}
+
+	bool shouldSample(const GMetaProfileTiming timing) const {
+		// Each timing has its own countdown, nested timings don't make each other sampled or skipped.
+		static thread_local uint32_t callCountdowns[mptCount] = {};
+
+		const uint32_t interval = this->getSampleInterval();
+		if(interval == 0) {
+			return false;
+		}
+		if(callCountdowns[timing] == 0) {
+			callCountdowns[timing] = getNextSampleGap(interval);
+		}
+		return --callCountdowns[timing] == 0;
+	}
+
+	void sample(const GMetaProfileTiming timing, const char * itemName, const uint64_t nanoseconds) {
+		const uint64_t interval = std::max<uint32_t>(this->getSampleInterval(), 1);
+
+		lock_guard<mutex> lockGuard(this->itemMutex);
+
+		SampleStatMap & statMap = this->sampleStats[timing];
+		SampleStatMap::iterator it = statMap.find(itemName != nullptr ? itemName : "");
+		if(it == statMap.end()) {
+			GMetaProfileSampleStat stat;
+			memset(&stat, 0, sizeof(stat));
+			it = statMap.insert(make_pair(string(itemName != nullptr ? itemName : ""), stat)).first;
+		}
+
+		GMetaProfileSampleStat & stat = it->second;
+		++stat.sampleCount;
+		stat.estimatedCallCount += interval;
+		stat.estimatedTotalNanoseconds += nanoseconds * interval;
+		++stat.histogram[getHistogramBucket(nanoseconds)];
+	}
+
+	bool getSampleStat(const GMetaProfileTiming timing, const char * itemName, GMetaProfileSampleStat * outStat) {
+		lock_guard<mutex> lockGuard(this->itemMutex);
+
+		const SampleStatMap & statMap = this->sampleStats[timing];
+		SampleStatMap::const_iterator it = statMap.find(itemName != nullptr ? itemName : "");
+		if(it == statMap.end()) {
+			return false;
+		}
+		*outStat = it->second;
+		return true;
+	}
+
+	void reset() {
+		for(int i = 0; i < mpcCount; ++i) {
+			this->categoryCounts[i].store(0, memory_order_relaxed);
+		}
+
+		lock_guard<mutex> lockGuard(this->itemMutex);
+		for(int i = 0; i < mpcCount; ++i) {
+			this->itemCounts[i].clear();
+		}
+		for(int i = 0; i < mptCount; ++i) {
+			this->sampleStats[i].clear();
+		}
+	}
+
+	string dump(const size_t maxSampleItemCount) {
+		ostringstream stream;
+
+		lock_guard<mutex> lockGuard(this->itemMutex);
+		for(int i = 0; i < mpcCount; ++i) {
+			stream << categoryNames[i] << ": " << this->getCount((GMetaProfileCategory)i) << "\n";
+
+			vector<pair<string, uint64_t> > itemList(this->itemCounts[i].begin(), this->itemCounts[i].end());
+			stable_sort(itemList.begin(), itemList.end(), [](const pair<string, uint64_t> & a, const pair<string, uint64_t> & b) {
+				return a.second > b.second;
+			});
+			for(const pair<string, uint64_t> & item : itemList) {
+				stream << "    " << item.first << ": " << item.second << "\n";
+			}
+		}
+
+		stream << "Sample interval: " << this->getSampleInterval() << "\n";
+		for(int i = 0; i < mptCount; ++i) {
+			stream << timingNames[i] << ":\n";
+
+			vector<pair<string, GMetaProfileSampleStat> > itemList(this->sampleStats[i].begin(), this->sampleStats[i].end());
+			stable_sort(itemList.begin(), itemList.end(), [](const pair<string, GMetaProfileSampleStat> & a, const pair<string, GMetaProfileSampleStat> & b) {
+				return a.second.estimatedTotalNanoseconds > b.second.estimatedTotalNanoseconds;
+			});
+			if(itemList.size() > maxSampleItemCount) {
+				itemList.resize(maxSampleItemCount);
+			}
+			for(const pair<string, GMetaProfileSampleStat> & item : itemList) {
+				const GMetaProfileSampleStat & stat = item.second;
+				stream << "    " << item.first
+					<< ": total " << stat.estimatedTotalNanoseconds << "ns"
+					<< ", calls " << stat.estimatedCallCount
+					<< ", mean " << stat.estimatedTotalNanoseconds / stat.estimatedCallCount << "ns"
+					<< ", p50 < " << getHistogramPercentile(stat, 50) << "ns"
+					<< ", p99 < " << getHistogramPercentile(stat, 99) << "ns"
+					<< ", samples " << stat.sampleCount
+					<< "\n";
+			}
+		}
+
+		return stream.str();
+	}
+
+private:
+	atomic<uint64_t> categoryCounts[mpcCount];
+	ItemCountMap itemCounts[mpcCount];
+	SampleStatMap sampleStats[mptCount];
+	atomic<uint32_t> sampleInterval;
+	mutex itemMutex;
+};
+
+GMetaProfileData & getMetaProfileData()
+{
+	// Never freed, so counting from static destructors is safe.
+	static GMetaProfileData * data = new GMetaProfileData();
+	return *data;
+}
+
+} // unnamed namespace
+
+
+bool isMetaProfileEnabled()
+{
+	return G_ENABLE_META_PROFILE != 0;
+}
+
+void metaProfileCount(GMetaProfileCategory category)
+{
+	getMetaProfileData().count(category);
+}
+
+void metaProfileCountItem(GMetaProfileCategory category, const char * itemName)
+{
+	getMetaProfileData().countItem(category, itemName);
+}
+
+uint64_t getMetaProfileCount(GMetaProfileCategory category)
+{
+	return getMetaProfileData().getCount(category);
+}
+
+uint64_t getMetaProfileItemCount(GMetaProfileCategory category, const char * itemName)
+{
+	return getMetaProfileData().getItemCount(category, itemName);
+}
+
+const char * getMetaProfileCategoryName(GMetaProfileCategory category)
+{
+	return categoryNames[category];
+}
+
+const char * getMetaProfileTimingName(GMetaProfileTiming timing)
+{
+	return timingNames[timing];
+}
+
+void setMetaProfileSampleInterval(uint32_t interval)
+{
+	getMetaProfileData().setSampleInterval(interval);
+}
+
+uint32_t getMetaProfileSampleInterval()
+{
+	return getMetaProfileData().getSampleInterval();
+}
+
+bool getMetaProfileSampleStat(GMetaProfileTiming timing, const char * itemName, GMetaProfileSampleStat * outStat)
+{
+	return getMetaProfileData().getSampleStat(timing, itemName, outStat);
+}
+
+void resetMetaProfile()
+{
+	getMetaProfileData().reset();
+}
+
+std::string dumpMetaProfile(size_t maxSampleItemCount)
+{
+	return getMetaProfileData().dump(maxSampleItemCount);
+}
+
+bool shouldSampleMetaProfile(GMetaProfileTiming timing)
+{
+	return getMetaProfileData().shouldSample(timing);
+}
+
+uint64_t getMetaProfileNanoseconds()
+{
+	return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void metaProfileSample(GMetaProfileTiming timing, const char * itemName, uint64_t nanoseconds)
+{
+	getMetaProfileData().sample(timing, itemName, nanoseconds);
+}
+
+
+} // namespace cpgf
+
@@ -2,6 +2,7 @@
 #include "cpgf/gmemorypool.h"
 #include "cpgf/gmetatype.h"
 #include "cpgf/gstringutil.h"
+#include "cpgf/gmetaprofile.h"
 
 namespace cpgf {
 
@@ -71,6 +72,7 @@ void retainVariantData(GVariantData & data)
 	if(baseType >= GVariantType::vtInterfaceBegin
 		&& baseType <= GVariantType::vtInterfaceEnd
 		&& data.valueInterface != nullptr) {
+		G_META_PROFILE_COUNT(mpcVariantRetain);
 		data.valueInterface->addReference();
 	}
 }
@@ -112,6 +114,30 @@ VariantTypeInfo variantTypeInfo[] = {
 	{ sizeof(void *) },
 };
 
+#define INTEGER_INFO(T) { \
+		(unsigned int)(64 - sizeof(T) * 8), \
+		std::is_signed<T>::value ? ~(std::uint64_t)0 : (~(std::uint64_t)0 >> (64 - sizeof(T) * 8)), \
+		! std::is_signed<T>::value && sizeof(T) == sizeof(std::uint64_t) \
+	}
+
+const VariantIntegerInfo variantIntegerInfo[] = {
+	INTEGER_INFO(bool), // vtBool
+	INTEGER_INFO(char),
+	INTEGER_INFO(wchar_t),
+	INTEGER_INFO(signed char),
+	INTEGER_INFO(unsigned char),
+	INTEGER_INFO(signed short),
+	INTEGER_INFO(unsigned short),
+	INTEGER_INFO(signed int),
+	INTEGER_INFO(unsigned int),
+	INTEGER_INFO(signed long),
+	INTEGER_INFO(unsigned long),
+	INTEGER_INFO(signed long long),
+	INTEGER_INFO(unsigned long long),
+};
+
+#undef INTEGER_INFO
+
 } //namespace variant_internal
 
 
@@ -1,5 +1,7 @@
 #include "cpgf/metautility/gmetabytearray.h"
 #include "cpgf/gexception.h"
+#include "cpgf/gerrorcode.h"
+#include "cpgf/gassert.h"
 #include "cpgf/gapiutil.h"
 #include "cpgf/gvariant.h"
 #include "cpgf/gmetacommon.h"
@@ -21,11 +23,11 @@ public:
 
 public:
 	GMetaByteArrayImplement()
-    	: byteArray(), length(0), position(0) {
+    	: byteArray(), length(0), position(0), exportCount(0) {
     }
 
     explicit GMetaByteArrayImplement(size_t length)
-    	: byteArray(length + 1), length(length), position(0) {
+    	: byteArray(length + 1), length(length), position(0), exportCount(0) {
         this->byteArray[0] = 0;
     }
 
@@ -46,6 +48,10 @@ public:
 
     void setLength(size_t length) {
     	if(this->length != length) {
+    		if(this->exportCount > 0) {
+    			raiseCoreException(Error_Meta_CantResizeExportedBuffer);
+    		}
+
 	    	this->length = length;
     		this->byteArray.resize(this->length + 1);
         	this->checkAndLimitPosition();
@@ -125,6 +131,7 @@ public:
 	ArrayType byteArray;
     size_t length;
     size_t position;
+    size_t exportCount;
 };
 
 GMetaByteArray::GMetaByteArray()
@@ -282,6 +289,23 @@ void GMetaByteArray::writeBuffer(const void * buffer, size_t length)
     this->implement->writeBuffer(buffer, length);
 }
 
+void GMetaByteArray::addBufferExport()
+{
+	++this->implement->exportCount;
+}
+
+void GMetaByteArray::releaseBufferExport()
+{
+	GASSERT(this->implement->exportCount > 0);
+
+	--this->implement->exportCount;
+}
+
+size_t GMetaByteArray::getBufferExportCount() const
+{
+	return this->implement->exportCount;
+}
+
 
 }
 
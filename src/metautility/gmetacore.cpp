@@ -2,6 +2,7 @@
 #include "cpgf/gmetaapi.h"
 #include "cpgf/scriptbind/gscriptbind.h"
 #include "cpgf/gscopedinterface.h"
+#include "cpgf/gmetaprofile.h"
 
 namespace cpgf {
 
@@ -56,5 +57,20 @@ GVariant GMetaCore::cast(const GVariant & instance, IMetaClass * targetMetaClass
 	return (void *)0;
 }
 
+std::string GMetaCore::getProfileReport()
+{
+	return dumpMetaProfile();
+}
+
+void GMetaCore::resetProfile()
+{
+	resetMetaProfile();
+}
+
+void GMetaCore::setProfileSampleInterval(uint32_t interval)
+{
+	setMetaProfileSampleInterval(interval);
+}
+
 
 } // namespace cpgf
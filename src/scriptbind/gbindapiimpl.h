@@ -42,6 +42,7 @@ protected:
 	virtual void G_API_CC invokeIndirectly(GScriptValueData * outResult, GVariantData const * const * params, uint32_t paramCount) override;
 	virtual void G_API_CC invokeOnObject(GScriptValueData * outResult, const GVariantData * params, uint32_t paramCount) override;
 	virtual void G_API_CC invokeIndirectlyOnObject(GScriptValueData * outResult, GVariantData const * const * params, uint32_t paramCount) override;
+	virtual void G_API_CC invokeBatch(GScriptValueData * outResults, GVariantData const * const * params, uint32_t paramCount, uint32_t batchCount) override;
 
 private:
 	GScriptFunction * scriptFunction;
@@ -70,6 +71,9 @@ protected:
 	virtual void G_API_CC getAsScriptArray(GScriptValueData * outResult, uint32_t index) override;
 	virtual void G_API_CC createScriptArray(GScriptValueData * outResult, uint32_t index) override;
 
+	virtual void G_API_CC setFundamentalArray(uint32_t index, const void * data, uint32_t count, GVtType vt) override;
+	virtual uint32_t G_API_CC getFundamentalArray(uint32_t index, void * outData, uint32_t count, GVtType vt) override;
+
 private:
 	GScriptArray * scriptArray;
 	bool freeArray;
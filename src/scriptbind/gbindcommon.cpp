@@ -6,11 +6,16 @@
 #include "cpgf/scriptbind/gscriptservice.h"
 #include "cpgf/glifecycle.h"
 #include "cpgf/gerrorcode.h"
+#include "cpgf/gmetaprofile.h"
+#include "cpgf/metautility/gmetabytearray.h"
 
 #include "cpgf/metatraits/gmetaobjectlifemanager_iobject.h"
 #include "cpgf/metatraits/gmetatraitsparam.h"
 
 #include <vector>
+#include <typeinfo>
+
+#include <string.h>
 
 
 #if defined(_MSC_VER)
@@ -54,24 +59,57 @@ const int ValueMatchRank_Equal = 100000;
 // Classes implementations
 //*********************************************
 
+class GScriptLockReleaser
+{
+public:
+	explicit GScriptLockReleaser(GBindingContext * context)
+		: context(context), lockState(context->releaseScriptLock())
+	{
+	}
+
+	~GScriptLockReleaser()
+	{
+		this->context->acquireScriptLock(this->lockState);
+	}
+
+private:
+	GBindingContext * context;
+	void * lockState;
+};
 
-InvokeCallableParam::InvokeCallableParam(size_t paramCount, IScriptContext * scriptContext)
+
+InvokeCallableParam::InvokeCallableParam(size_t paramCount, GBindingContext * context)
 	:
-		params((CallableParamData *)paramsBuffer),
+		params(nullptr),
 		paramCount(paramCount),
-		paramRanks((ConvertRank *)paramRanksBuffer),
-		backParamRanks((ConvertRank *)paramRanksBackBuffer),
-		scriptContext(scriptContext)
+		paramRanks(nullptr),
+		backParamRanks(nullptr),
+		scriptContext(context->borrowScriptContext()),
+		callArena(context->getCallArena()),
+		callArenaMark()
 {
-	// Use "raw" buffer to hold the object array CallableParamData and ConvertRank.
-	// If we use CallableParamData[REF_MAX_ARITY] and ConvertRank[REF_MAX_ARITY], the performance is bad due to the constructors.
-	memset(this->paramsBuffer, 0, sizeof(CallableParamData) * paramCount);
-	memset(this->paramRanksBuffer, 0, sizeof(ConvertRank) * paramCount);
-	memset(this->paramRanksBackBuffer, 0, sizeof(ConvertRank) * paramCount);
-
 	if(this->paramCount > REF_MAX_ARITY) {
 		raiseCoreException(Error_ScriptBinding_CallMethodWithTooManyParameters);
 	}
+
+	// Use "raw" memory from the call arena to hold the object array CallableParamData and ConvertRank.
+	// If we construct the arrays, the performance is bad due to the constructors.
+	this->callArenaMark = this->callArena->enter();
+	if(this->paramCount > 0) {
+		try {
+			this->params = static_cast<CallableParamData *>(this->callArena->allocate(sizeof(CallableParamData) * this->paramCount));
+			this->paramRanks = static_cast<ConvertRank *>(this->callArena->allocate(sizeof(ConvertRank) * this->paramCount));
+			this->backParamRanks = static_cast<ConvertRank *>(this->callArena->allocate(sizeof(ConvertRank) * this->paramCount));
+		}
+		catch(...) {
+			this->callArena->leave(this->callArenaMark);
+			throw;
+		}
+
+		memset(static_cast<void *>(this->params), 0, sizeof(CallableParamData) * this->paramCount);
+		memset(static_cast<void *>(this->paramRanks), 0, sizeof(ConvertRank) * this->paramCount);
+		memset(static_cast<void *>(this->backParamRanks), 0, sizeof(ConvertRank) * this->paramCount);
+	}
 }
 
 InvokeCallableParam::~InvokeCallableParam()
@@ -81,6 +119,8 @@ InvokeCallableParam::~InvokeCallableParam()
 		this->paramRanks[i].~ConvertRank();
 		this->backParamRanks[i].~ConvertRank();
 	}
+
+	this->callArena->leave(this->callArenaMark);
 }
 
 
@@ -235,7 +275,9 @@ void rankCallableImplicitConvert(ConvertRank * outputRank, IMetaService * servic
 	}
 }
 
-int rankFundamental(GVariantType protoType, GVariantType paramType)
+namespace {
+
+int computeFundamentalRank(GVariantType protoType, GVariantType paramType)
 {
 	if(protoType == paramType) {
 		return ValueMatchRank_Equal;
@@ -262,15 +304,45 @@ int rankFundamental(GVariantType protoType, GVariantType paramType)
 	return ValueMatchRank_ConvertBwtweenFamily;
 }
 
+const int fundamentalTypeCount = (int)GVariantType::vtFundamentalEnd - (int)GVariantType::vtFundamentalBegin + 1;
+
+struct FundamentalRankTable
+{
+	FundamentalRankTable() {
+		for(int proto = 0; proto < fundamentalTypeCount; ++proto) {
+			for(int param = 0; param < fundamentalTypeCount; ++param) {
+				this->ranks[proto][param] = computeFundamentalRank(
+					(GVariantType)(proto + (int)GVariantType::vtFundamentalBegin),
+					(GVariantType)(param + (int)GVariantType::vtFundamentalBegin)
+				);
+			}
+		}
+	}
+
+	int ranks[fundamentalTypeCount][fundamentalTypeCount];
+};
+
+} // unnamed namespace
+
+int rankFundamental(GVariantType protoType, GVariantType paramType)
+{
+	if(vtIsFundamental(protoType) && vtIsFundamental(paramType)) {
+		static const FundamentalRankTable rankTable;
+		return rankTable.ranks[(int)protoType - (int)GVariantType::vtFundamentalBegin][(int)paramType - (int)GVariantType::vtFundamentalBegin];
+	}
+
+	return computeFundamentalRank(protoType, paramType);
+}
+
 void rankCallableParam(
 	ConvertRank * outputRank,
 	IMetaService * service,
 	IMetaCallable * callable,
 	const InvokeCallableParam * callableParam,
-	size_t paramIndex
+	size_t paramIndex,
+	const GCallableParamDescriptor & proto
 )
 {
-	GMetaType proto = metaGetParamType(callable, paramIndex);
 	GScriptValue::Type type = callableParam->params[paramIndex].value.getType();
 
 	if(type == GScriptValue::typeNull) {
@@ -278,23 +350,35 @@ void rankCallableParam(
 		return;
 	}
 
-	if(proto.isFundamental() && type == GScriptValue::typePrimary) {
-		outputRank->weight = rankFundamental(proto.getVariantType(),
-			callableParam->params[paramIndex].value.toPrimary().getType());
+	if(proto.fundamental && type == GScriptValue::typePrimary) {
+		outputRank->weight = rankFundamental(proto.variantType,
+			callableParam->params[paramIndex].value.getValue().getType());
 		return;
 	}
 
-	if(type == GScriptValue::typeScriptFunction && vtIsInterface(proto.getVariantType())) {
+	if(type == GScriptValue::typeScriptFunction && vtIsInterface(proto.variantType)) {
 		outputRank->weight = ValueMatchRank_Convert;
 		return;
 	}
 
-	if(proto.getPointerDimension() > 1) {
+	if(proto.multiplePointer) {
 		outputRank->weight = ValueMatchRank_Unknown;
 		return;
 	}
 
-	rankCallableImplicitConvert(outputRank, service, callable, callableParam, paramIndex, proto);
+	rankCallableImplicitConvert(outputRank, service, callable, callableParam, paramIndex, proto.type);
+}
+
+void rankCallableParam(
+	ConvertRank * outputRank,
+	IMetaService * service,
+	IMetaCallable * callable,
+	const InvokeCallableParam * callableParam,
+	size_t paramIndex
+)
+{
+	rankCallableParam(outputRank, service, callable, callableParam, paramIndex,
+		GCallableParamDescriptor(metaGetParamType(callable, paramIndex)));
 }
 
 int rankCallable(
@@ -348,6 +432,80 @@ int rankCallable(
 	return rank;
 }
 
+int rankCallable(
+	IMetaService * service,
+	const GObjectGlueDataPointer & objectData,
+	const GCallableSignature & signature,
+	const InvokeCallableParam * callableParam,
+	ConvertRank * paramRanks
+)
+{
+	if(signature.variadic) {
+		return 0;
+	}
+
+	if(signature.paramCount < callableParam->paramCount) {
+		return -1;
+	}
+
+	if(signature.paramCount > callableParam->paramCount + signature.defaultParamCount) {
+		return -1;
+	}
+
+	int rank = 1;
+
+	const GScriptInstanceCv cv = getGlueDataCV(objectData);
+	if(cv == signature.cv) {
+		rank += ValueMatchRank_Equal;
+	}
+	else {
+		if(cv != GScriptInstanceCv::sicvNone) {
+			return -1;
+		}
+		rank += ValueMatchRank_Convert;
+	}
+
+	IMetaMethod * method = signature.method.get();
+	for(size_t i = 0; i < callableParam->paramCount; ++i) {
+		const GCallableParamDescriptor & proto = signature.params[i];
+		rankCallableParam(&paramRanks[i], service, method, callableParam, i, proto);
+		rank += paramRanks[i].weight;
+
+		if(! isParamImplicitConvert(paramRanks[i])) {
+			const GVariant & value = callableParam->params[i].value.getValue();
+			// Any fundamental converts to a fundamental parameter passed by value,
+			// the check is only needed for the other values.
+			if(proto.fundamentalByValue && vtIsFundamental(value.getType())) {
+				continue;
+			}
+			bool ok = !! method->checkParam(&value.refData(), static_cast<uint32_t>(i));
+			metaCheckError(method);
+			if(! ok) {
+				return -1;
+			}
+		}
+	}
+
+	return rank;
+}
+
+void initializeCallableSignature(GCallableSignature * outSignature, IMetaMethod * method, void * instance)
+{
+	outSignature->method.reset(method);
+	outSignature->methodInstance = instance;
+	outSignature->variadic = !! method->isVariadic();
+	outSignature->paramCount = method->getParamCount();
+	outSignature->defaultParamCount = method->getDefaultParamCount();
+	outSignature->cv = getCallableConstness(method);
+	outSignature->params.clear();
+	if(! outSignature->variadic) {
+		outSignature->params.reserve(outSignature->paramCount);
+		for(uint32_t i = 0; i < outSignature->paramCount; ++i) {
+			outSignature->params.push_back(GCallableParamDescriptor(metaGetParamType(method, i)));
+		}
+	}
+}
+
 bool implicitConvertForMetaClassCast(const ConvertRank & rank, GVariant * v);
 
 bool doConvertForMetaClassCast(
@@ -495,6 +653,8 @@ void doInvokeCallable(
 		InvokeCallableResult * result
 	)
 {
+	G_META_PROFILE_SAMPLE_BEGIN(sampler, mptBindingInvoke);
+
 	result->resultCount = callable->hasResult() ? 1 : 0;
 
 	GVariant holder;
@@ -515,7 +675,13 @@ void doInvokeCallable(
 	for(size_t i = 0; i < callableParam->paramCount; ++i) {
 		data[i] = &callableParam->params[i].value.getValue().refData();
 	}
-	callable->executeIndirectly(&result->resultData.refData(), instance, data, static_cast<uint32_t>(callableParam->paramCount));
+	if(callable->isReleaseScriptLock()) {
+		GScriptLockReleaser lockReleaser(context.get());
+		callable->executeIndirectly(&result->resultData.refData(), instance, data, static_cast<uint32_t>(callableParam->paramCount));
+	}
+	else {
+		callable->executeIndirectly(&result->resultData.refData(), instance, data, static_cast<uint32_t>(callableParam->paramCount));
+	}
 	metaCheckError(callable);
 
 	for(uint32_t i = 0; i < callableParam->paramCount; ++i) {
@@ -525,6 +691,8 @@ void doInvokeCallable(
 			static_cast<GObjectGlueData *>(callableParam->params[i].paramGlueData.get())->setAllowGC(false);
 		}
 	}
+
+	G_META_PROFILE_SAMPLE_END(sampler, callable->getQualifiedName());
 }
 
 
@@ -535,6 +703,8 @@ void * doInvokeConstructor(
 		InvokeCallableParam * callableParam
 	)
 {
+	G_META_PROFILE_COUNT_ITEM(mpcObjectCreate, metaClass->getName());
+
 	void * instance = nullptr;
 
 	if(callableParam->paramCount == 0 && metaClass->canCreateInstance()) {
@@ -562,47 +732,31 @@ void * doInvokeConstructor(
 	return instance;
 }
 
-IMetaMethod * doGetCallableFromScriptValue(
-		void ** outInstance,
-		const GScriptValue & scriptValue,
+const GCallableSignature * findAppropriateSignature(
 		IMetaService * service,
 		const GObjectGlueDataPointer & objectData,
+		const std::vector<GCallableSignature> & signatureList,
 		InvokeCallableParam * callableParam
 	)
 {
-	switch(scriptValue.getType()) {
-		case GScriptValue::typeMethod: {
-			GScopedInterface<IMetaMethod> method(scriptValue.toMethod(outInstance));
-				const int weight = rankCallable(service, objectData, method.get(), callableParam, callableParam->backParamRanks);
-				if(weight >= 0) {
-					std::swap(callableParam->paramRanks, callableParam->backParamRanks);
-					return method.release();
-				}
+	int maxRank = -1;
+	const GCallableSignature * result = nullptr;
+
+	for(const GCallableSignature & signature : signatureList) {
+		const int weight = rankCallable(service, objectData, signature, callableParam, callableParam->backParamRanks);
+		if(weight > maxRank) {
+			maxRank = weight;
+			result = &signature;
+			std::swap(callableParam->paramRanks, callableParam->backParamRanks);
 		}
-			break;
-
-		case GScriptValue::typeOverloadedMethods: {
-			GScopedInterface<IMetaList> methodList(scriptValue.toOverloadedMethods());
-			const int maxRankIndex = findAppropriateCallable(
-				service,
-				objectData,
-				[&](const uint32_t index) { return methodList->getAt(index); },
-				methodList->getCount(),
-				callableParam,
-				[](IMetaCallable *) { return true; }
-			);
-			if(maxRankIndex >= 0) {
-				*outInstance = methodList->getInstanceAt(static_cast<uint32_t>(maxRankIndex));
-				return static_cast<IMetaMethod *>(methodList->getAt(maxRankIndex));
+		if(signatureList.size() > 1) {
+			for(size_t i = 0; i < callableParam->paramCount; ++i) {
+				callableParam->backParamRanks[i].resetRank();
 			}
 		}
-			break;
-			
-		default:
-			break;
 	}
-	
-	return nullptr;
+
+	return result;
 }
 
 InvokeCallableResult doInvokeMethodList(
@@ -612,16 +766,21 @@ InvokeCallableResult doInvokeMethodList(
 		InvokeCallableParam * callableParam
 	)
 {
-	void * methodInstance = nullptr;
-	GScopedInterface<IMetaMethod> methodToInvoke(doGetCallableFromScriptValue(
-		&methodInstance,
-		methodData->getScriptValue(),
+	G_META_PROFILE_SAMPLE_BEGIN(sampler, mptResolve);
+
+	const GCallableSignature * signature = findAppropriateSignature(
 		context->getService(),
 		objectData,
+		methodData->getCallableSignatures(),
 		callableParam
-	));
+	);
 	
-	if(methodToInvoke) {
+	if(signature != nullptr) {
+		IMetaMethod * methodToInvoke = signature->method.get();
+		G_META_PROFILE_SAMPLE_END(sampler, methodToInvoke->getQualifiedName());
+
+		G_META_PROFILE_COUNT_ITEM(mpcMethodInvoke, methodToInvoke->getQualifiedName());
+
 		InvokeCallableResult result;
 		void * instance = nullptr;
 		if(objectData) {
@@ -638,10 +797,10 @@ InvokeCallableResult doInvokeMethodList(
 		}
 		else {
 			// This happens if an object method is bound to script as a global function.
-			instance = methodInstance;
+			instance = signature->methodInstance;
 		}
-		doInvokeCallable(context, instance, methodToInvoke.get(), callableParam, &result);
-		result.callable.reset(methodToInvoke.get());
+		doInvokeCallable(context, instance, methodToInvoke, callableParam, &result);
+		result.callable.reset(methodToInvoke);
 		return result;
 	}
 
@@ -777,17 +936,13 @@ bool setValueOnNamedMember(
 
 	GContextPointer context = classData->getBindingContext();
 
-	GMetaClassTraveller traveller(classData->getMetaClass(), getGlueDataInstanceAddress(instanceGlueData));
-
-	void * instance = nullptr;
+	const GMetaClassLinearization & linearization = classData->getLinearization();
+	const size_t classCount = linearization.getCount();
 
-	for(;;) {
-		GScopedInterface<IMetaClass> metaClass(traveller.next(&instance));
-		if(!metaClass) {
-			break;
-		}
+	for(size_t i = 0; i < classCount; ++i) {
+		IMetaClass * metaClass = linearization.getClassAt(i);
 
-		GMetaMapClass * mapClass = context->getClassData(metaClass.get())->getClassMap();
+		GMetaMapClass * mapClass = context->getClassData(metaClass)->getClassMap();
 		if(! mapClass) {
 			continue;
 		}
@@ -825,6 +980,19 @@ bool setValueOnNamedMember(
 	return true;
 }
 
+IMetaList * createMethodListFromScriptValue(const GScriptValue & scriptValue)
+{
+	if(scriptValue.getType() == GScriptValue::typeOverloadedMethods) {
+		return scriptValue.toOverloadedMethods();
+	}
+
+	void * instance;
+	GScopedInterface<IMetaMethod> method(scriptValue.toMethod(&instance));
+	IMetaList * methodList = createMetaList();
+	methodList->add(method.get(), method->isStatic() ? nullptr : instance);
+	return methodList;
+}
+
 InvokeCallableResult doInvokeOperator(
 		const GContextPointer & context,
 		const GObjectGlueDataPointer & objectData,
@@ -867,6 +1035,136 @@ std::string getMethodNameFromMethodList(IMetaList * methodList)
 	}
 }
 
+namespace {
+
+bool isFundamentalByValue(const GMetaType & type)
+{
+	return type.isFundamental() && ! type.isPointer() && ! type.isReference();
+}
+
+} // unnamed namespace
+
+GFundamentalSignature * createFundamentalSignature(IMetaMethod * method, void * instance)
+{
+	if(method == nullptr || method->isVariadic() || method->isExplicitThis()) {
+		return nullptr;
+	}
+
+	const uint32_t paramCount = method->getParamCount();
+	if(paramCount > REF_MAX_ARITY) {
+		return nullptr;
+	}
+
+	GVariantType resultType = GVariantType::vtEmpty;
+	const bool hasResult = !! method->hasResult();
+	if(hasResult) {
+		const GMetaType type = metaGetResultType(method);
+		if(! isFundamentalByValue(type)) {
+			return nullptr;
+		}
+		resultType = type.getVariantType();
+	}
+
+	std::unique_ptr<GFundamentalSignature> signature(new GFundamentalSignature());
+	for(uint32_t i = 0; i < paramCount; ++i) {
+		const GMetaType type = metaGetParamType(method, i);
+		if(! isFundamentalByValue(type)) {
+			return nullptr;
+		}
+		signature->paramTypes[i] = type.getVariantType();
+	}
+
+	GScopedInterface<IMetaItem> ownerItem(method->getOwnerItem());
+
+	signature->method.reset(method);
+	signature->methodInstance = instance;
+	signature->ownerClass.reset(gdynamic_cast<IMetaClass *>(ownerItem.get()));
+	signature->cv = getCallableConstness(method);
+	signature->releaseScriptLock = !! method->isReleaseScriptLock();
+	signature->hasResult = hasResult;
+	signature->resultType = resultType;
+	signature->paramCount = paramCount;
+
+	return signature.release();
+}
+
+bool doInvokeFundamentalMethod(
+		const GContextPointer & context,
+		const GObjectGlueDataPointer & objectData,
+		const GFundamentalSignature * signature,
+		const GVariant * params,
+		GVariant * outResult
+	)
+{
+	G_META_PROFILE_SAMPLE_BEGIN(sampler, mptBindingInvoke);
+
+	void * instance = signature->methodInstance;
+	if(objectData) {
+		const GScriptInstanceCv cv = objectData->getCV();
+		if(cv != signature->cv && cv != GScriptInstanceCv::sicvNone) {
+			return false;
+		}
+
+		instance = objectData->getInstanceAddress();
+		if(instance != nullptr) {
+			auto classData = objectData->getClassData();
+			if(classData && classData->getMetaClass() != signature->ownerClass.get()) {
+				instance = metaCastAny(instance, classData->getMetaClass(), signature->ownerClass.get());
+			}
+		}
+	}
+
+	const GVariantData * data[REF_MAX_ARITY];
+	for(uint32_t i = 0; i < signature->paramCount; ++i) {
+		data[i] = &params[i].refData();
+	}
+
+	IMetaMethod * method = signature->method.get();
+	G_META_PROFILE_COUNT_ITEM(mpcMethodInvoke, method->getQualifiedName());
+
+	if(signature->releaseScriptLock) {
+		GScriptLockReleaser lockReleaser(context.get());
+		method->executeIndirectly(&outResult->refData(), instance, data, signature->paramCount);
+	}
+	else {
+		method->executeIndirectly(&outResult->refData(), instance, data, signature->paramCount);
+	}
+	metaCheckError(method);
+
+	G_META_PROFILE_SAMPLE_END(sampler, method->getQualifiedName());
+
+	return true;
+}
+
+void checkFundamentalArraySetIndex(size_t index, size_t length)
+{
+	if(index > length) {
+		raiseCoreException(Error_ScriptBinding_ScriptArrayIndexOutOfRange, static_cast<int>(index), static_cast<int>(length));
+	}
+}
+
+bool isByteArrayClass(IMetaClass * metaClass)
+{
+	// Compare the C++ type rather than the name, a script class may be reflected with the same name.
+	static const GTypeInfo byteArrayType(typeid(GMetaByteArray));
+
+	return metaClass != nullptr && metaClass->isBaseType(&byteArrayType);
+}
+
+GMetaByteArray * getByteArrayFromGlueData(const GGlueDataPointer & glueData)
+{
+	if(! glueData || glueData->getType() != gdtObject) {
+		return nullptr;
+	}
+
+	GObjectGlueDataPointer objectData = std::static_pointer_cast<GObjectGlueData>(glueData);
+	if(! isByteArrayClass(objectData->getClassData()->getMetaClass())) {
+		return nullptr;
+	}
+
+	return static_cast<GMetaByteArray *>(objectData->getInstanceAddress());
+}
+
 } // namespace bind_internal
 
 
@@ -21,6 +21,8 @@
 
 namespace cpgf {
 
+class GMetaByteArray;
+
 namespace bind_internal {
 
 class ConvertRank
@@ -54,21 +56,22 @@ public:
 	GGlueDataPointer paramGlueData;
 };
 
-class InvokeCallableParam
+class InvokeCallableParam : public GNoncopyable
 {
 public:
-	InvokeCallableParam(size_t paramCount, IScriptContext * scriptContext);
+	InvokeCallableParam(size_t paramCount, GBindingContext * context);
 	~InvokeCallableParam();
 
 public:
 	CallableParamData * params;
-	char paramsBuffer[sizeof(CallableParamData) * REF_MAX_ARITY];
 	size_t paramCount;
 	ConvertRank * paramRanks;
-	char paramRanksBuffer[sizeof(ConvertRank) * REF_MAX_ARITY];
 	ConvertRank * backParamRanks;
-	char paramRanksBackBuffer[sizeof(ConvertRank) * REF_MAX_ARITY];
 	GSharedInterface<IScriptContext> scriptContext;
+
+private:
+	GScriptCallArena * callArena;
+	GScriptCallArena::Mark callArenaMark;
 };
 
 int rankCallable(
@@ -79,6 +82,16 @@ int rankCallable(
 	ConvertRank * paramRanks
 );
 
+int rankCallable(
+	IMetaService * service,
+	const GObjectGlueDataPointer & objectData,
+	const GCallableSignature & signature,
+	const InvokeCallableParam * callableParam,
+	ConvertRank * paramRanks
+);
+
+void initializeCallableSignature(GCallableSignature * outSignature, IMetaMethod * method, void * instance);
+
 void * doInvokeConstructor(
 	const GContextPointer & context,
 	IMetaService * service,
@@ -104,6 +117,18 @@ bool setValueOnNamedMember(
 	const GGlueDataPointer & valueGlueData
 );
 
+// Returns a method list holding the method or the overloaded methods in scriptValue.
+// The caller owns the list.
+IMetaList * createMethodListFromScriptValue(const GScriptValue & scriptValue);
+
+void doSetValueOnAccessible(
+	const GContextPointer & context,
+	IMetaAccessible * accessible,
+	const GGlueDataPointer & instanceGlueData,
+	GVariant value,
+	const GGlueDataPointer & valueGlueData
+);
+
 InvokeCallableResult doInvokeOperator(
 	const GContextPointer & context,
 	const GObjectGlueDataPointer & objectData,
@@ -114,25 +139,58 @@ InvokeCallableResult doInvokeOperator(
 
 std::string getMethodNameFromMethodList(IMetaList * methodList);
 
-struct ConvertRankBuffer
+// Returns nullptr if the method can't be invoked through GFundamentalSignature.
+GFundamentalSignature * createFundamentalSignature(IMetaMethod * method, void * instance);
+
+// params must have signature->paramCount elements.
+// Returns false if the object constness doesn't allow the method,
+// the caller should fall back to doInvokeMethodList which reports the error.
+bool doInvokeFundamentalMethod(
+	const GContextPointer & context,
+	const GObjectGlueDataPointer & objectData,
+	const GFundamentalSignature * signature,
+	const GVariant * params,
+	GVariant * outResult
+);
+
+// The bindings use these to let script access the memory of a GMetaByteArray
+// directly, without invoking the reflected read/write methods.
+bool isByteArrayClass(IMetaClass * metaClass);
+// Returns nullptr if glueData is not an object of GMetaByteArray.
+GMetaByteArray * getByteArrayFromGlueData(const GGlueDataPointer & glueData);
+
+// Raises exception if a bulk set starts beyond the end of the script array.
+// A Lua sequence can't hold nil, so the array can't be padded the way a Python list can.
+void checkFundamentalArraySetIndex(size_t index, size_t length);
+
+// Calls Op<T>::apply(parameters...) with T being the C++ type of the fundamental vt.
+// It's used by the bulk accessors of GScriptArray to loop over a typed C++ buffer.
+template <template <typename> class Op, typename... Parameters>
+void dispatchFundamentalArray(const GVariantType vt, Parameters &&... parameters)
 {
-	explicit ConvertRankBuffer(const size_t paramCount)
-		: paramCount(paramCount), paramRanks((ConvertRank *)paramRanksBuffer)
-	{
-		memset(this->paramRanksBuffer, 0, sizeof(ConvertRank) * paramCount);
-	};
-	
-	~ConvertRankBuffer()
-	{
-	for(size_t i = 0; i < this->paramCount; ++i) {
-		this->paramRanks[i].~ConvertRank();
+	switch(vt) {
+		case GVariantType::vtBool: Op<bool>::apply(parameters...); break;
+		case GVariantType::vtChar: Op<char>::apply(parameters...); break;
+		case GVariantType::vtWchar: Op<wchar_t>::apply(parameters...); break;
+		case GVariantType::vtSignedChar: Op<signed char>::apply(parameters...); break;
+		case GVariantType::vtUnsignedChar: Op<unsigned char>::apply(parameters...); break;
+		case GVariantType::vtSignedShort: Op<signed short>::apply(parameters...); break;
+		case GVariantType::vtUnsignedShort: Op<unsigned short>::apply(parameters...); break;
+		case GVariantType::vtSignedInt: Op<signed int>::apply(parameters...); break;
+		case GVariantType::vtUnsignedInt: Op<unsigned int>::apply(parameters...); break;
+		case GVariantType::vtSignedLong: Op<signed long>::apply(parameters...); break;
+		case GVariantType::vtUnsignedLong: Op<unsigned long>::apply(parameters...); break;
+		case GVariantType::vtSignedLongLong: Op<signed long long>::apply(parameters...); break;
+		case GVariantType::vtUnsignedLongLong: Op<unsigned long long>::apply(parameters...); break;
+		case GVariantType::vtFloat: Op<float>::apply(parameters...); break;
+		case GVariantType::vtDouble: Op<double>::apply(parameters...); break;
+		case GVariantType::vtLongDouble: Op<long double>::apply(parameters...); break;
+
+		default:
+			raiseCoreException(Error_ScriptBinding_NotSupportedFeature, "Non fundamental type in bulk array access", "script array");
+			break;
 	}
-	}
-
-	size_t paramCount;
-	ConvertRank * paramRanks;
-	char paramRanksBuffer[sizeof(ConvertRank) * REF_MAX_ARITY];
-};
+}
 
 template <typename Getter, typename Predict>
 int findAppropriateCallable(
@@ -1,12 +1,96 @@
 #include "gbindcontext.h"
 #include "gbindcommon.h"
 
+#include <algorithm>
+#include <cstddef>
+
 namespace cpgf {
 
 GScriptCoreService * doBindScriptCoreService(GScriptObject * scriptObject, const char * bindName, IScriptLibraryLoader * libraryLoader);
 
 namespace bind_internal {
 
+namespace {
+
+const size_t callArenaAlignment = alignof(std::max_align_t);
+const size_t callArenaMinBlockSize = 4096;
+
+} // unnamed namespace
+
+GScriptCallArena::GScriptCallArena()
+	:
+		blockList(),
+		blockIndex(0),
+		blockOffset(0),
+		usedBytes(0),
+		peakUsedBytes(0),
+		reservedBytes(0),
+		depth(0),
+		maxDepth(0)
+{
+}
+
+GScriptCallArena::Mark GScriptCallArena::enter()
+{
+	const Mark mark = { this->blockIndex, this->blockOffset, this->usedBytes, this->depth };
+
+	++this->depth;
+	if(this->depth > this->maxDepth) {
+		this->maxDepth = this->depth;
+	}
+
+	return mark;
+}
+
+void GScriptCallArena::leave(const Mark & mark)
+{
+	this->blockIndex = mark.blockIndex;
+	this->blockOffset = mark.blockOffset;
+	this->usedBytes = mark.usedBytes;
+	this->depth = mark.depth;
+}
+
+void * GScriptCallArena::allocate(size_t size)
+{
+	size = (size + callArenaAlignment - 1) & ~(callArenaAlignment - 1);
+
+	// Skip the retained blocks which are too small, they are used again after the rewinding.
+	while(this->blockIndex < this->blockList.size()
+		&& this->blockList[this->blockIndex].size - this->blockOffset < size) {
+		++this->blockIndex;
+		this->blockOffset = 0;
+	}
+
+	if(this->blockIndex == this->blockList.size()) {
+		// Double the reserved memory, so deep recursion only allocates a few blocks.
+		const size_t blockSize = std::max(size, std::max(callArenaMinBlockSize, this->reservedBytes));
+		Block block;
+		block.data.reset(new char[blockSize]);
+		block.size = blockSize;
+		this->blockList.push_back(std::move(block));
+		this->reservedBytes += blockSize;
+	}
+
+	void * memory = this->blockList[this->blockIndex].data.get() + this->blockOffset;
+	this->blockOffset += size;
+	this->usedBytes += size;
+	if(this->usedBytes > this->peakUsedBytes) {
+		this->peakUsedBytes = this->usedBytes;
+	}
+
+	return memory;
+}
+
+void GScriptCallArena::getStat(GScriptCallStackStat * outStat) const
+{
+	outStat->depth = this->depth;
+	outStat->maxDepth = this->maxDepth;
+	outStat->usedBytes = static_cast<uint32_t>(this->usedBytes);
+	outStat->peakUsedBytes = static_cast<uint32_t>(this->peakUsedBytes);
+	outStat->reservedBytes = static_cast<uint32_t>(this->reservedBytes);
+}
+
+
 void G_API_CC GScriptContext::addScriptUserConverter(IScriptUserConverter * converter)
 {
 	if(! this->scriptUserConverterList) {
@@ -82,9 +166,36 @@ void GScriptContext::bindExternalObjectToClass(void * address, IMetaClass * meta
 	);
 }
 
+void GScriptObjectCache::freeScriptObject(GGlueDataWrapper * dataWrapper)
+{
+	if(dataWrapper->getData()->getType() != gdtObject) {
+		return;
+	}
+
+	const GObjectGlueDataPointer objectData(dataWrapper->getAs<GObjectGlueData>());
+	if(! objectData->getClassData()) {
+		return;
+	}
+
+	MapType::iterator it = this->objectMap.find(KeyType(
+		objectAddressFromVariant(objectData->getInstance()),
+		objectData->getClassData()->getClassMap(),
+		objectData->getCV()
+	));
+	if(it != this->objectMap.end() && it->second->getDataWrapper() == dataWrapper) {
+		this->objectMap.erase(it);
+	}
+}
+
 
-GBindingPool::GBindingPool(const std::shared_ptr<GBindingContext> & context)
-	: context(context)
+void GScriptContext::getCallStackStat(GScriptCallStackStat * outStat)
+{
+	bindingContext->getCallArena()->getStat(outStat);
+}
+
+
+GBindingPool::GBindingPool(const std::shared_ptr<GBindingContext> & context, const GMetaMapPointer & metaMap)
+	: context(context), metaMap(metaMap)
 {
 }
 
@@ -132,7 +243,7 @@ GBindingPool::MethodKey GBindingPool::doMakeMethodKey(const GScriptValue & scrip
 GBindingPool::ObjectKey GBindingPool::doMakeObjectKey(const GObjectGlueDataPointer & glueData)
 {
 	return ObjectKey(
-		glueData->getClassData() ? glueData->getClassData()->getMetaClass() : nullptr,
+		glueData->getClassData() ? glueData->getClassData()->getClassMap() : nullptr,
 		objectAddressFromVariant(glueData->getInstance()),
 		glueData->getCV()
 	);
@@ -153,7 +264,15 @@ void GBindingPool::glueDataRemoved(const GObjectGlueDataPointer & glueData)
 		return;
 	}
 
-	this->objectMap.erase(this->doMakeObjectKey(glueData));
+	// Several wrappers may hold the same glue data, and a newer glue data may have taken the key,
+	// only remove the entry which is this glue data or is dead.
+	auto it = this->objectMap.find(this->doMakeObjectKey(glueData));
+	if(it != this->objectMap.end()) {
+		const GObjectGlueDataPointer existing(it->second.lock());
+		if(! existing || existing == glueData) {
+			this->objectMap.erase(it);
+		}
+	}
 }
 
 GObjectGlueDataPointer GBindingPool::newObjectGlueData(
@@ -163,7 +282,7 @@ GObjectGlueDataPointer GBindingPool::newObjectGlueData(
 	)
 {
 	const ObjectKey key = ObjectKey(
-		classData->getMetaClass(),
+		classData->getClassMap(),
 		objectInstance->getInstanceAddress(),
 		cv
 	);
@@ -349,7 +468,7 @@ GClassGlueDataPointer GBindingPool::getClassData(IMetaClass * metaClass)
 		return it->second;
 	}
 
-	GClassGlueDataPointer result = GClassGlueDataPointer(new GClassGlueData(this->context.lock(), metaClass, this->metaMap.getMetaClassMap(metaClass)));
+	GClassGlueDataPointer result = GClassGlueDataPointer(new GClassGlueData(this->context.lock(), metaClass, this->metaMap->getMetaClassMap(metaClass)));
 	this->classMap[metaClass] = result;
 	return result;
 }
@@ -360,15 +479,34 @@ void GBindingPool::classDestroyed(IMetaClass * metaClass)
 }
 
 
-GBindingContext::GBindingContext(IMetaService * service)
-	: service(service), scriptContext(new GScriptContext(this))
+GBindingContext::GBindingContext(IMetaService * service, const GMetaMapPointer & metaMap)
+	:
+		service(service),
+		metaMap(metaMap),
+		scriptContext(new GScriptContext(this)),
+		callArenaThreadId(std::this_thread::get_id())
 {
+	if(! this->metaMap) {
+		this->metaMap.reset(new GMetaMap());
+	}
 }
 
 GBindingContext::~GBindingContext()
 {
 }
 
+GScriptCallArena * GBindingContext::getThreadCallArena()
+{
+	std::lock_guard<std::mutex> lockGuard(this->threadCallArenaMutex);
+
+	// An arena is kept after its thread exits, a new thread may get the same id and reuse it.
+	std::unique_ptr<GScriptCallArena> & arena = this->threadCallArenaMap[std::this_thread::get_id()];
+	if(! arena) {
+		arena.reset(new GScriptCallArena());
+	}
+	return arena.get();
+}
+
 void GBindingContext::bindScriptCoreService(GScriptObject * scriptObject, const char * bindName, IScriptLibraryLoader * libraryLoader)
 {
 	if(this->scriptCoreService) {
@@ -411,6 +549,11 @@ GObjectGlueDataPointer GBindingContext::newObjectGlueData(
 	if(! objectInstance) {
 		objectInstance = GObjectInstance::create(context, instance, classData, allowGC);
 	}
+	else if(allowGC && ! objectInstance->isAllowGC()) {
+		// The instance may be wrapped without ownership, such as a new object which is returned
+		// at the address of a deleted one, take the ownership as requested.
+		objectInstance->setAllowGC(true);
+	}
 
 	return this->getBindingPool()->newObjectGlueData(classData, objectInstance, cv);
 }
@@ -448,7 +591,7 @@ GOperatorGlueDataPointer GBindingContext::newOperatorGlueData(const GObjectGlueD
 GBindingPool * GBindingContext::getBindingPool()
 {
 	if(! this->bindingPool) {
-		this->bindingPool.reset(new GBindingPool(this->shared_from_this()));
+		this->bindingPool.reset(new GBindingPool(this->shared_from_this(), this->metaMap));
 	}
 	
 	return this->bindingPool.get();
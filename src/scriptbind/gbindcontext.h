@@ -4,6 +4,7 @@
 #include "cpgf/scriptbind/gscriptbind.h"
 #include "cpgf/scriptbind/gscriptservice.h"
 #include "cpgf/gsharedinterface.h"
+#include "cpgf/gclassutil.h"
 #include "cpgf/gstringmap.h"
 #include "cpgf/glifecycle.h"
 
@@ -14,6 +15,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
+#include <mutex>
 
 namespace cpgf {
 
@@ -21,6 +24,130 @@ namespace bind_internal {
 
 class GBindingContext;
 
+// A bump allocator for the parameters of the callables invoked from script.
+// The invocations are nested in stack order, so each one takes a mark on entering
+// and rewinds to it on leaving, and the memory blocks are kept for the next invocations.
+// It's not thread safe, each thread uses its own arena, see GBindingContext::getCallArena.
+class GScriptCallArena : public GNoncopyable
+{
+public:
+	struct Mark
+	{
+		size_t blockIndex;
+		size_t blockOffset;
+		size_t usedBytes;
+		uint32_t depth;
+	};
+
+private:
+	struct Block
+	{
+		std::unique_ptr<char[]> data;
+		size_t size;
+	};
+
+public:
+	GScriptCallArena();
+
+	// Enter an invocation, the returned mark must be passed to leave.
+	Mark enter();
+	// Rewind to mark, the memory allocated after enter is reused.
+	// It restores the depth as well, so a leave which is skipped by the script engine is recovered
+	// by the leave of the outer invocation.
+	void leave(const Mark & mark);
+
+	// The memory is aligned for any fundamental type, and is not initialized.
+	void * allocate(size_t size);
+
+	void getStat(GScriptCallStackStat * outStat) const;
+
+private:
+	std::vector<Block> blockList;
+	size_t blockIndex;
+	size_t blockOffset;
+	size_t usedBytes;
+	size_t peakUsedBytes;
+	size_t reservedBytes;
+	uint32_t depth;
+	uint32_t maxDepth;
+};
+
+// Maps a C++ object, which is the instance address, the class and the cv, to the script object wrapping it,
+// so the same C++ object returned to script again and again gives the same script object.
+// The class is identified by its GMetaMapClass, because several IMetaClass interfaces may represent one class.
+// A binding adds the script object after creating it, and frees it in the finalizer of the script object.
+class GScriptObjectCache : public GNoncopyable
+{
+private:
+	typedef std::tuple<void *, GMetaMapClass *, GScriptInstanceCv> KeyType;
+
+	class ItemBase
+	{
+	public:
+		explicit ItemBase(GGlueDataWrapper * dataWrapper) : dataWrapper(dataWrapper) {}
+		virtual ~ItemBase() {}
+
+		GGlueDataWrapper * getDataWrapper() const {
+			return this->dataWrapper;
+		}
+
+	private:
+		GGlueDataWrapper * dataWrapper;
+	};
+
+	template <typename T>
+	class Item : public ItemBase
+	{
+	public:
+		Item(GGlueDataWrapper * dataWrapper, const T & scriptObject) : ItemBase(dataWrapper), scriptObject(scriptObject) {}
+
+		T * getScriptObject() {
+			return &this->scriptObject;
+		}
+
+	private:
+		T scriptObject;
+	};
+
+	typedef std::map<KeyType, std::unique_ptr<ItemBase> > MapType;
+
+public:
+	// T must be the same type which is passed to addScriptObject, each binding uses one type.
+	// If outDataWrapper is not nullptr, it receives the data wrapper embedded in the script object.
+	template <typename T>
+	T * findScriptObject(void * instance, const GClassGlueDataPointer & classData, const GScriptInstanceCv cv,
+		GGlueDataWrapper ** outDataWrapper = nullptr) const
+	{
+		typename MapType::const_iterator it = this->objectMap.find(KeyType(instance, classData->getClassMap(), cv));
+		if(it == this->objectMap.end()) {
+			return nullptr;
+		}
+		if(outDataWrapper != nullptr) {
+			*outDataWrapper = it->second->getDataWrapper();
+		}
+		return static_cast<Item<T> *>(it->second.get())->getScriptObject();
+	}
+
+	// dataWrapper is the object data wrapper embedded in scriptObject. Replace the existing script object, if any.
+	template <typename T>
+	void addScriptObject(void * instance, const GClassGlueDataPointer & classData, const GScriptInstanceCv cv,
+		GGlueDataWrapper * dataWrapper, const T & scriptObject)
+	{
+		this->objectMap[KeyType(instance, classData->getClassMap(), cv)].reset(new Item<T>(dataWrapper, scriptObject));
+	}
+
+	// Called when the script object holding dataWrapper is finalized.
+	// A script object which was replaced doesn't remove its replacement.
+	void freeScriptObject(GGlueDataWrapper * dataWrapper);
+
+	size_t getCount() const {
+		return this->objectMap.size();
+	}
+
+private:
+	MapType objectMap;
+};
+
 class GScriptContext : public IScriptContext
 {
 public:
@@ -40,6 +167,7 @@ protected:
 	virtual IScriptUserConverter * G_API_CC getScriptUserConverterAt(uint32_t index) override;
 	virtual void G_API_CC setAllowGC(const GVariantData * instance, gapi_bool allowGC) override;
 	virtual void G_API_CC bindExternalObjectToClass(void * address, IMetaClass * metaClass) override;
+	virtual void G_API_CC getCallStackStat(GScriptCallStackStat * outStat) override;
 
 private:
 	ScriptUserConverterListType::iterator findConverter(IScriptUserConverter * converter);
@@ -54,13 +182,13 @@ class GBindingPool
 {
 private:
 	typedef std::tuple<void *, void *> MethodKey; // <method, instance>
-	typedef std::tuple<void *, void *, GScriptInstanceCv> ObjectKey; // <class address, object address, constness>
+	typedef std::tuple<GMetaMapClass *, void *, GScriptInstanceCv> ObjectKey; // <class map, object address, constness>
 	typedef std::tuple<GObjectGlueData *, GMethodGlueData *> ObjectAndMethodKey;
 	typedef std::tuple<void *, IMetaAccessible *> AccessibleKey;
 	typedef std::tuple<GObjectGlueData *, IMetaClass *, GMetaOpType> OperatorKey;
 
 public:
-	explicit GBindingPool(const std::shared_ptr<GBindingContext> & context);
+	GBindingPool(const std::shared_ptr<GBindingContext> & context, const GMetaMapPointer & metaMap);
 	~GBindingPool();
 
 	template <typename T>
@@ -120,7 +248,7 @@ private:
 
 private:
 	std::weak_ptr<GBindingContext> context;
-	GMetaMap metaMap;
+	GMetaMapPointer metaMap;
 
 	std::map<MethodKey, GWeakMethodGlueDataPointer> methodMap;
 	std::map<ObjectKey, GWeakObjectGlueDataPointer> objectMap;
@@ -135,17 +263,37 @@ private:
 class GBindingContext : public std::enable_shared_from_this<GBindingContext>
 {
 public:
-	explicit GBindingContext(IMetaService * service);
+	// metaMap can be shared by several contexts to avoid building the class maps again.
+	// If it's empty, the context creates its own one.
+	explicit GBindingContext(IMetaService * service, const GMetaMapPointer & metaMap = GMetaMapPointer());
 	virtual ~GBindingContext();
 
 	IMetaService * getService() const {
 		return this->service.get();
 	}
 
+	const GMetaMapPointer & getMetaMap() const {
+		return this->metaMap;
+	}
+
 	void bindScriptCoreService(GScriptObject * scriptObject, const char * bindName, IScriptLibraryLoader * libraryLoader);
 
 	IScriptContext * borrowScriptContext() const;
 
+	// A callable with rule GMetaRuleReleaseScriptLock lets other threads call into the context
+	// while its parameters are still in use, so the invocations on different threads don't nest
+	// and each thread gets its own arena. The thread which created the context doesn't lock.
+	GScriptCallArena * getCallArena() {
+		if(std::this_thread::get_id() == this->callArenaThreadId) {
+			return &this->callArena;
+		}
+		return this->getThreadCallArena();
+	}
+
+	GScriptObjectCache * getScriptObjectCache() {
+		return &this->scriptObjectCache;
+	}
+
 public:
 	GClassGlueDataPointer getClassData(IMetaClass * metaClass);
 	void classDestroyed(IMetaClass * metaClass);
@@ -180,13 +328,30 @@ public:
 
 	GBindingPool * getBindingPool();
 
+private:
+	GScriptCallArena * getThreadCallArena();
+
+public:
+
+	// Called around executing a callable which has rule GMetaRuleReleaseScriptLock.
+	// Bindings to script engines with a global interpreter lock override them.
+	virtual void * releaseScriptLock() { return nullptr; }
+	virtual void acquireScriptLock(void * /*lockState*/) {}
+
 private:
 	GSharedInterface<IMetaService> service;
+	GMetaMapPointer metaMap;
 	std::shared_ptr<GBindingPool> bindingPool;
 
 	std::unique_ptr<GScriptCoreService> scriptCoreService;
 	GScopedInterface<IScriptContext> scriptContext;
 
+	std::thread::id callArenaThreadId;
+	GScriptCallArena callArena;
+	std::mutex threadCallArenaMutex;
+	std::map<std::thread::id, std::unique_ptr<GScriptCallArena> > threadCallArenaMap;
+	GScriptObjectCache scriptObjectCache;
+
 private:
 	template <typename T>
 	friend class GGlueDataWrapperImplement;
@@ -305,18 +305,13 @@ typename Methods::ResultType namedMemberToScript(const GGlueDataPointer & glueDa
 		return Methods::defaultValue();
 	}
 
-	GMetaClassTraveller traveller(classData->getMetaClass(), getGlueDataInstanceAddress(glueData));
+	const GMetaClassLinearization & linearization = classData->getLinearization();
+	const size_t classCount = linearization.getCount();
 
-	void * instance = nullptr;
+	for(size_t i = 0; i < classCount; ++i) {
+		IMetaClass * metaClass = linearization.getClassAt(i);
 
-	for(;;) {
-		GScopedInterface<IMetaClass> metaClass(traveller.next(&instance, nullptr));
-
-		if(!metaClass) {
-			break;
-		}
-
-		GMetaMapClass * mapClass = context->getClassData(metaClass.get())->getClassMap();
+		GMetaMapClass * mapClass = context->getClassData(metaClass)->getClassMap();
 		if(! mapClass) {
 			continue;
 		}
@@ -327,8 +322,9 @@ typename Methods::ResultType namedMemberToScript(const GGlueDataPointer & glueDa
 		}
 
 		GObjectGlueDataPointer castedObjectData;
+		void * instance = linearization.getInstanceAt(i, getGlueDataInstanceAddress(glueData));
 		if(instance != nullptr && objectData) {
-			castedObjectData = context->newObjectGlueData(context->getClassData(metaClass.get()), instance, false, objectData->getCV());
+			castedObjectData = context->newObjectGlueData(context->getClassData(metaClass), instance, false, objectData->getCV());
 		}
 
 		return Methods::doScriptValueToScript(
@@ -2,6 +2,7 @@
 #include "gbindcommon.h"
 
 #include "cpgf/gmemorypool.h"
+#include "cpgf/gmetaprofile.h"
 
 #include <vector>
 
@@ -85,6 +86,7 @@ void GGlueData::operator delete(void * p, size_t size)
 GGlueData::GGlueData(GGlueDataType type, const GContextPointer & context)
 	: type(type), context(GWeakContextPointer(context)), userDataHolder(), userData(nullptr)
 {
+	G_META_PROFILE_COUNT(mpcGlueData);
 }
 
 GGlueData::~GGlueData()
@@ -115,6 +117,14 @@ const GScriptDataHolderPointer & GClassGlueData::getDataHolder() const
 	return this->dataHolder;
 }
 
+const GMetaClassLinearization & GClassGlueData::getLinearization() const
+{
+	if(! this->linearization) {
+		this->linearization.reset(new GMetaClassLinearization(this->getMetaClass()));
+	}
+	return *this->linearization;
+}
+
 
 GClassGlueData::GClassGlueData(const GContextPointer & context, IMetaClass * metaClass, GMetaMapClass * mapClass)
 	: super(gdtClass, context), metaClass(metaClass), mapClass(mapClass)
@@ -224,6 +234,48 @@ GObjectGlueData::~GObjectGlueData()
 }
 
 
+GMethodGlueData::GMethodGlueData(const GContextPointer & context, const GScriptValue & scriptValue)
+	: super(gdtMethod, context), scriptValue(scriptValue), fundamentalSignature(), callableSignatures()
+{
+	if(scriptValue.getType() == GScriptValue::typeMethod) {
+		void * instance = nullptr;
+		GScopedInterface<IMetaMethod> method(scriptValue.toMethod(&instance));
+		this->fundamentalSignature.reset(createFundamentalSignature(method.get(), instance));
+	}
+}
+
+const std::vector<GCallableSignature> & GMethodGlueData::getCallableSignatures() const
+{
+	if(this->callableSignatures.empty()) {
+		switch(this->scriptValue.getType()) {
+			case GScriptValue::typeMethod: {
+				void * instance = nullptr;
+				GScopedInterface<IMetaMethod> method(this->scriptValue.toMethod(&instance));
+				this->callableSignatures.resize(1);
+				initializeCallableSignature(&this->callableSignatures[0], method.get(), instance);
+				break;
+			}
+
+			case GScriptValue::typeOverloadedMethods: {
+				GScopedInterface<IMetaList> methodList(this->scriptValue.toOverloadedMethods());
+				const uint32_t count = methodList->getCount();
+				this->callableSignatures.resize(count);
+				for(uint32_t i = 0; i < count; ++i) {
+					GScopedInterface<IMetaMethod> method(static_cast<IMetaMethod *>(methodList->getAt(i)));
+					initializeCallableSignature(&this->callableSignatures[i], method.get(), methodList->getInstanceAt(i));
+				}
+				break;
+			}
+
+			default:
+				break;
+		}
+	}
+
+	return this->callableSignatures;
+}
+
+
 GGlueDataWrapperPool::GGlueDataWrapperPool()
 	: active(true)
 {
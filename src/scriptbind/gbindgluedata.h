@@ -5,6 +5,7 @@
 #include "cpgf/gvariant.h"
 #include "cpgf/gflags.h"
 #include "cpgf/gmetaoperatorop.h"
+#include "cpgf/gmetaclasstraveller.h"
 #include "cpgf/scriptbind/gscriptbindapi.h"
 #include "cpgf/scriptbind/gscriptwrapper.h"
 #include "cpgf/scriptbind/gscriptvalue.h"
@@ -15,6 +16,7 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace cpgf {
 
@@ -179,10 +181,14 @@ public:
 
 	const GScriptDataHolderPointer & getDataHolder() const;
 
+	// The class and its base classes, built on first use and shared by all member lookups.
+	const GMetaClassLinearization & getLinearization() const;
+
 private:
 	GSharedInterface<IMetaClass> metaClass;
 	GMetaMapClass * mapClass;
 	mutable GScriptDataHolderPointer dataHolder;
+	mutable std::unique_ptr<GMetaClassLinearization> linearization;
 
 private:
 	friend class GBindingContext;
@@ -346,23 +352,81 @@ private:
 };
 
 
+// A single method of which the parameters and the result are fundamentals passed by value.
+// It's detected when the method is bound, then the bindings can read the script
+// arguments directly to variants and invoke it without ranking.
+struct GFundamentalSignature
+{
+	GSharedInterface<IMetaMethod> method;
+	void * methodInstance;
+	GSharedInterface<IMetaClass> ownerClass;
+	GScriptInstanceCv cv;
+	bool releaseScriptLock;
+	bool hasResult;
+	GVariantType resultType;
+	uint32_t paramCount;
+	GVariantType paramTypes[REF_MAX_ARITY];
+};
+
+// The parameter type of a callable read once, ranking the overloads
+// uses it instead of calling the meta interfaces on each invocation.
+struct GCallableParamDescriptor
+{
+	explicit GCallableParamDescriptor(const GMetaType & type)
+		:
+			type(type),
+			variantType(type.getVariantType()),
+			fundamental(type.isFundamental()),
+			fundamentalByValue(fundamental && ! type.isPointer() && ! type.isReference()),
+			multiplePointer(type.getPointerDimension() > 1)
+	{
+	}
+
+	GMetaType type;
+	GVariantType variantType;
+	bool fundamental;
+	bool fundamentalByValue;
+	bool multiplePointer;
+};
+
+// A method of a GMethodGlueData with everything rankCallable needs except the arguments.
+struct GCallableSignature
+{
+	GSharedInterface<IMetaMethod> method;
+	void * methodInstance;
+	bool variadic;
+	uint32_t paramCount;
+	uint32_t defaultParamCount;
+	GScriptInstanceCv cv;
+	std::vector<GCallableParamDescriptor> params;
+};
+
 class GMethodGlueData : public GGlueData
 {
 private:
 	typedef GGlueData super;
 
 private:
-	GMethodGlueData(const GContextPointer & context, const GScriptValue & scriptValue)
-		: super(gdtMethod, context), scriptValue(scriptValue) {
-	}
+	GMethodGlueData(const GContextPointer & context, const GScriptValue & scriptValue);
 
 public:
 	const GScriptValue & getScriptValue() const {
 		return this->scriptValue;
 	}
 
+	// nullptr if the method is overloaded or not all fundamentals.
+	const GFundamentalSignature * getFundamentalSignature() const {
+		return this->fundamentalSignature.get();
+	}
+
+	// One signature per overload. They are built when the method is invoked the first time,
+	// many method glue data are created only to be looked up and never invoked.
+	const std::vector<GCallableSignature> & getCallableSignatures() const;
+
 private:
 	GScriptValue scriptValue;
+	std::unique_ptr<GFundamentalSignature> fundamentalSignature;
+	mutable std::vector<GCallableSignature> callableSignatures;
 
 private:
 	friend class GBindingContext;
@@ -5,6 +5,8 @@
 #include "cpgf/gscopedinterface.h"
 #include "cpgf/gglobal.h"
 
+#include <algorithm>
+
 namespace cpgf {
 
 namespace bind_internal {
@@ -59,7 +61,7 @@ GMetaMapItem * GMetaMapClass::findItem(const char * name)
 		return nullptr;
 	}
 	else {
-		return &this->itemMap[name];
+		return &it->second;
 	}
 }
 
@@ -131,6 +133,15 @@ void GMetaMapClass::buildMap(IMetaClass * metaClass, void * instance)
 			this->itemMap[name] = GMetaMapItem(GScriptValue::fromOverloadedMethods(metaList.get()));
 		}
 	}
+
+	count = metaClass->getOperatorCount();
+	for(i = 0; i < count; ++i) {
+		GScopedInterface<IMetaOperator> metaOperator(metaClass->getOperatorAt(i));
+		const uint32_t op = metaOperator->getOperator();
+		if(std::find(this->operatorList.begin(), this->operatorList.end(), op) == this->operatorList.end()) {
+			this->operatorList.push_back(op);
+		}
+	}
 }
 
 
@@ -150,6 +161,9 @@ GMetaMapClass * GMetaMap::getMetaClassMap(IMetaClass * metaClass)
 	using namespace std;
 
 	const char * name = metaClass->getQualifiedName();
+
+	std::lock_guard<std::mutex> lockGuard(this->mutex);
+
 	MapType::iterator it = this->classMap.find(name);
 
 	if(it != this->classMap.end()) {
@@ -8,6 +8,8 @@
 
 #include <map>
 #include <unordered_map>
+#include <vector>
+#include <mutex>
 
 namespace cpgf {
 
@@ -53,11 +55,17 @@ public:
 		return &this->itemMap;
 	}
 
+	// Unique operator types of the class, in declaration order.
+	const std::vector<uint32_t> & getOperatorList() const {
+		return this->operatorList;
+	}
+
 private:
 	void buildMap(IMetaClass * metaClass, void * instance);
 
 private:
 	MapType itemMap;
+	std::vector<uint32_t> operatorList;
 };
 
 class GMetaMap
@@ -69,12 +77,17 @@ public:
 	GMetaMap();
 	~GMetaMap();
 
+	// Thread safe. A GMetaMap only holds immutable meta data,
+	// so it can be shared by binding contexts on different threads.
 	GMetaMapClass * getMetaClassMap(IMetaClass * metaClass);
 
 private:
 	MapType classMap;
+	std::mutex mutex;
 };
 
+typedef std::shared_ptr<GMetaMap> GMetaMapPointer;
+
 class GMethodGlueData;
 typedef std::shared_ptr<GMethodGlueData> GMethodGlueDataPointer;
 
@@ -1,5 +1,6 @@
 #include "gbindobject.h"
 #include "gbindcontext.h"
+#include "gbindcommon.h"
 
 #include "cpgf/scriptbind/gscriptuserconverter.h"
 #include "cpgf/gglobal.h"
@@ -66,6 +67,26 @@ GContextPointer GScriptFunctionBase::getBindingContext()
 	return this->weakContext.lock();
 }
 
+void GScriptFunctionBase::invokeBatch(GScriptValue * outResults, GVariant const * const * params, size_t paramCount, size_t batchCount)
+{
+	if(paramCount > REF_MAX_ARITY) {
+		raiseCoreException(Error_ScriptBinding_CallMethodWithTooManyParameters);
+	}
+
+	const GVariant * callParams[REF_MAX_ARITY];
+
+	for(size_t i = 0; i < batchCount; ++i) {
+		for(size_t n = 0; n < paramCount; ++n) {
+			callParams[n] = &params[n][i];
+		}
+
+		GScriptValue result = this->invokeIndirectly(callParams, paramCount);
+		if(outResults != nullptr) {
+			outResults[i] = result;
+		}
+	}
+}
+
 GScriptArrayBase::GScriptArrayBase(const GContextPointer & context)
 	: context(context)
 {
@@ -80,6 +101,55 @@ GContextPointer GScriptArrayBase::getBindingContext()
 	return this->context;
 }
 
+namespace {
+
+template <typename T>
+struct FundamentalArraySetter
+{
+	static void apply(GScriptArray * scriptArray, size_t index, const void * data, size_t count) {
+		const T * p = static_cast<const T *>(data);
+		for(size_t i = 0; i < count; ++i) {
+			scriptArray->setValue(index + i, GScriptValue::fromPrimary(GVariant(p[i])));
+		}
+	}
+};
+
+template <typename T>
+struct FundamentalArrayGetter
+{
+	static void apply(GScriptArray * scriptArray, size_t index, void * outData, size_t count) {
+		T * p = static_cast<T *>(outData);
+		for(size_t i = 0; i < count; ++i) {
+			const GScriptValue value(scriptArray->getValue(index + i));
+			p[i] = value.isPrimary() ? fromVariant<T>(value.toPrimary()) : T();
+		}
+	}
+};
+
+} // unnamed namespace
+
+void GScriptArrayBase::setFundamentalArray(size_t index, const void * data, size_t count, GVariantType vt)
+{
+	checkFundamentalArraySetIndex(index, this->getLength());
+
+	dispatchFundamentalArray<FundamentalArraySetter>(vt, this, index, data, count);
+}
+
+size_t GScriptArrayBase::getFundamentalArray(size_t index, void * outData, size_t count, GVariantType vt)
+{
+	const size_t length = this->getLength();
+	if(index >= length) {
+		return 0;
+	}
+	if(count > length - index) {
+		count = length - index;
+	}
+
+	dispatchFundamentalArray<FundamentalArrayGetter>(vt, this, index, outData, count);
+
+	return count;
+}
+
 
 } //namespace bind_internal
 
@@ -18,6 +18,11 @@ public:
 	virtual GScriptValue invokeIndirectly(GVariant const * const * params, size_t paramCount) = 0;
 	virtual GScriptValue invokeIndirectlyOnObject(GVariant const * const * params, size_t paramCount) { return invokeIndirectly(params, paramCount); };
 
+	// Invoke the function batchCount times. params has paramCount arrays of batchCount elements,
+	// call i gets params[0][i], params[1][i], and so on.
+	// If outResults is not nullptr, the result of call i is written to outResults[i].
+	virtual void invokeBatch(GScriptValue * outResults, GVariant const * const * params, size_t paramCount, size_t batchCount) = 0;
+
 	GMAKE_NONCOPYABLE(GScriptFunction);
 };
 
@@ -36,6 +41,13 @@ public:
 	virtual GScriptValue getAsScriptArray(size_t index) = 0;
 	virtual GScriptValue createScriptArray(size_t index) = 0;
 
+	// Bulk access to count fundamentals of type vt, data is a C++ array of that type.
+	// setFundamentalArray grows the script array when needed, index must not be beyond the length.
+	// getFundamentalArray returns the number of elements read, which is less than count
+	// if the script array is shorter. Elements which are not primary values are read as 0.
+	virtual void setFundamentalArray(size_t index, const void * data, size_t count, GVariantType vt) = 0;
+	virtual size_t getFundamentalArray(size_t index, void * outData, size_t count, GVariantType vt) = 0;
+
 	GMAKE_NONCOPYABLE(GScriptArray);
 };
 
@@ -84,6 +96,9 @@ public:
 	explicit GScriptFunctionBase(const GContextPointer & context);
 	~GScriptFunctionBase();
 
+	// Call by call through invokeIndirectly.
+	virtual void invokeBatch(GScriptValue * outResults, GVariant const * const * params, size_t paramCount, size_t batchCount);
+
 protected:
 	GContextPointer getBindingContext();
 
@@ -101,6 +116,10 @@ public:
 	explicit GScriptArrayBase(const GContextPointer & context);
 	~GScriptArrayBase();
 
+	// Element by element through setValue and getValue.
+	virtual void setFundamentalArray(size_t index, const void * data, size_t count, GVariantType vt);
+	virtual size_t getFundamentalArray(size_t index, void * outData, size_t count, GVariantType vt);
+
 protected:
 	GContextPointer getBindingContext();
 
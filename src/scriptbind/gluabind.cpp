@@ -5,6 +5,8 @@
 #include "cpgf/gcallback.h"
 #include "cpgf/gerrorcode.h"
 #include "cpgf/gstringutil.h"
+#include "cpgf/gmetaprofile.h"
+#include "cpgf/metautility/gmetabytearray.h"
 
 #include "gbindcommon.h"
 #include "gbindapiimpl.h"
@@ -16,6 +18,7 @@
 #include <set>
 #include <iostream>
 #include <string>
+#include <type_traits>
 
 #include <string.h>
 
@@ -68,6 +71,7 @@ public:
 	
 	virtual GScriptValue invoke(const GVariant * params, size_t paramCount);
 	virtual GScriptValue invokeIndirectly(GVariant const * const * params, size_t paramCount);
+	virtual void invokeBatch(GScriptValue * outResults, GVariant const * const * params, size_t paramCount, size_t batchCount);
 
 	void toLua();
 
@@ -92,6 +96,9 @@ public:
 	virtual GScriptValue getAsScriptArray(size_t index);
 	virtual GScriptValue createScriptArray(size_t index);
 
+	virtual void setFundamentalArray(size_t index, const void * data, size_t count, GVariantType vt);
+	virtual size_t getFundamentalArray(size_t index, void * outData, size_t count, GVariantType vt);
+
 	void toLua();
 	
 private:
@@ -105,7 +112,7 @@ private:
 	typedef GScriptObjectBase super;
 
 public:
-	GLuaScriptObject(IMetaService * service, lua_State * L);
+	GLuaScriptObject(IMetaService * service, lua_State * L, const GMetaMapPointer & metaMap = GMetaMapPointer());
 	GLuaScriptObject(const GLuaScriptObject & other);
 	GLuaScriptObject(IMetaService * service, lua_State * L, int objectIndex);
 	virtual ~GLuaScriptObject();
@@ -123,7 +130,7 @@ public:
 
 	virtual bool maybeIsScriptArray(const char * name);
 	virtual GScriptValue getAsScriptArray(const char * name);
-	virtual GScriptValue createScriptArray(const char * name);
+	virtual GScriptValue createScriptArray(const char * name, size_t reserveLength);
 
 public:
 	lua_State * getLuaState() const {
@@ -163,8 +170,8 @@ private:
 	typedef GBindingContext super;
 
 public:
-	GLuaBindingContext(IMetaService * service, lua_State * luaState)
-		: super(service), luaState(luaState)
+	GLuaBindingContext(IMetaService * service, lua_State * luaState, const GMetaMapPointer & metaMap = GMetaMapPointer())
+		: super(service, metaMap), luaState(luaState)
 	{
 	}
 
@@ -249,6 +256,7 @@ typedef GCallback<GLuaGlobalAccessor * ()> GlobalAccessorGetter;
 bool doValueToScript(const GContextPointer & context, GLuaScriptObject * scriptObject, const GScriptValue & value, const ScriptValueToScriptData & data, const char * name = nullptr);
 
 void initObjectMetaTable(lua_State * L);
+void initByteArrayMetaTable(lua_State * L);
 void setMetaTableGC(lua_State * L);
 void setMetaTableCall(lua_State * L, void * userData);
 void setMetaTableSignature(lua_State * L);
@@ -391,6 +399,20 @@ public:
 		lua_remove(this->luaState, -2);
 	}
 
+	// Move the ref to the weak table, so the object can be garbage collected.
+	void makeWeakReference()
+	{
+		if(this->weakReference) {
+			return;
+		}
+
+		this->get();
+		this->release();
+		this->weakReference = true;
+		this->ref = LUA_NOREF;
+		this->retainAndPop();
+	}
+
 private:
 	lua_State * luaState;
 	bool weakReference;
@@ -428,12 +450,35 @@ void objectToLua(
 {
 	lua_State * L = getLuaState(context);
 
-	if(objectAddressFromVariant(instance) == nullptr) {
+	void * instanceAddress = objectAddressFromVariant(instance);
+	if(instanceAddress == nullptr) {
 		lua_pushnil(L);
 
 		return;
 	}
 
+	GScriptObjectCache * scriptObjectCache = context->getScriptObjectCache();
+	GGlueDataWrapper * cachedDataWrapper;
+	GLuaRefUserData ** cachedUserData = scriptObjectCache->findScriptObject<GLuaRefUserData *>(instanceAddress, classData, cv, &cachedDataWrapper);
+	if(cachedUserData != nullptr) {
+		(*cachedUserData)->get();
+		if(! lua_isnil(L, -1)) {
+			if(allowGC) {
+				// The cached object may not be owned, such as a new object which is returned
+				// at the address of a deleted one, take the ownership as requested.
+				static_cast<GObjectGlueData *>(cachedDataWrapper->getData().get())->setAllowGC(true);
+				(*cachedUserData)->makeWeakReference();
+			}
+			if(outputGlueData != nullptr) {
+				*outputGlueData = cachedDataWrapper->getData();
+			}
+			return;
+		}
+
+		// The weak ref has been cleared and the finalizer is pending
+		lua_pop(L, 1);
+	}
+
 	GObjectGlueDataPointer objectData(context->newObjectGlueData(classData, instance, allowGC, cv));
 	if(outputGlueData != nullptr) {
 		*outputGlueData = objectData;
@@ -443,6 +488,10 @@ void objectToLua(
 	if(glueUserData != nullptr) {
 		glueUserData->get();
 		if(! lua_isnil(L, -1)) {
+			// newObjectGlueData has taken the ownership if it's requested.
+			if(allowGC) {
+				glueUserData->makeWeakReference();
+			}
 			return;
 		}
 
@@ -450,8 +499,9 @@ void objectToLua(
 		lua_pop(L, 1);
 	}
 
+	G_META_PROFILE_COUNT(mpcLuaUserData);
 	void * userData = lua_newuserdata(L, getGlueDataWrapperSize<GObjectGlueData>());
-	newGlueDataWrapper(userData, objectData);
+	GGlueDataWrapper * dataWrapper = newGlueDataWrapper(userData, objectData);
 
 	IMetaClass * metaClass = classData->getMetaClass();
 
@@ -475,6 +525,10 @@ void objectToLua(
 	
 		initObjectMetaTable(L);
 
+		if(isByteArrayClass(metaClass)) {
+			initByteArrayMetaTable(L);
+		}
+
 		lua_pushvalue(L, -1); // duplicate the meta table
 		lua_setfield(L, LUA_REGISTRYINDEX, metaTableName);
 	
@@ -488,6 +542,8 @@ void objectToLua(
 	objectData->setUserData(glueUserData);
 	glueUserData->retainAndPop();
 
+	scriptObjectCache->addScriptObject(instanceAddress, classData, cv, dataWrapper, glueUserData);
+
 	glueUserData->get();
 }
 
@@ -511,6 +567,7 @@ void rawToLua(const GContextPointer & context, const GVariant & value)
 {
 	lua_State * L = getLuaState(context);
 
+	G_META_PROFILE_COUNT(mpcLuaUserData);
 	void * userData = lua_newuserdata(L, getGlueDataWrapperSize<GRawGlueData>());
 	GRawGlueDataPointer rawData(context->newRawGlueData(value));
 	newGlueDataWrapper(userData, rawData);
@@ -752,6 +809,73 @@ bool methodResultToLua(const GContextPointer & context, IMetaCallable * callable
 	return methodResultToScript<GLuaMethods>(context, callable, result);
 }
 
+// Returns false if any argument doesn't match the category of its parameter exactly,
+// a number for a numeric parameter and a boolean for a bool parameter,
+// then the call goes through the normal ranking path.
+bool invokeFundamentalMethod(
+		const GContextPointer & context,
+		const GObjectGlueDataPointer & objectData,
+		const GFundamentalSignature * signature,
+		int * outResultCount
+	)
+{
+	lua_State * L = getLuaState(context);
+
+	if(lua_gettop(L) != static_cast<int>(signature->paramCount)) {
+		return false;
+	}
+
+	GVariant params[REF_MAX_ARITY];
+	for(uint32_t i = 0; i < signature->paramCount; ++i) {
+		const int index = static_cast<int>(i) + 1;
+		switch(lua_type(L, index)) {
+			case LUA_TNUMBER:
+				if(vtIsBoolean(signature->paramTypes[i])) {
+					return false;
+				}
+#if LUA_VERSION_NUM >= 503
+				if(vtIsInteger(signature->paramTypes[i]) && lua_isinteger(L, index)) {
+					params[i] = lua_tointeger(L, index);
+					break;
+				}
+#endif
+				params[i] = lua_tonumber(L, index);
+				break;
+
+			case LUA_TBOOLEAN:
+				if(! vtIsBoolean(signature->paramTypes[i])) {
+					return false;
+				}
+				params[i] = bool(lua_toboolean(L, index) != 0);
+				break;
+
+			default:
+				return false;
+		}
+	}
+
+	GVariant result;
+	if(! doInvokeFundamentalMethod(context, objectData, signature, params, &result)) {
+		return false;
+	}
+
+	*outResultCount = 0;
+	if(signature->hasResult) {
+		if(vtIsBoolean(signature->resultType)) {
+			lua_pushboolean(L, fromVariant<bool>(result));
+		}
+		else if(vtIsInteger(signature->resultType)) {
+			lua_pushinteger(L, fromVariant<lua_Integer>(result));
+		}
+		else {
+			lua_pushnumber(L, fromVariant<lua_Number>(result));
+		}
+		*outResultCount = 1;
+	}
+
+	return true;
+}
+
 int callbackInvokeMethodList(lua_State * L)
 {
 	ENTER_LUA()
@@ -759,7 +883,16 @@ int callbackInvokeMethodList(lua_State * L)
 	GObjectAndMethodGlueDataPointer userData = static_cast<GGlueDataWrapper *>(lua_touserdata(L, lua_upvalueindex(1)))->getAs<GObjectAndMethodGlueData>();
 
 	GContextPointer bindingContext(userData->getBindingContext());
-	InvokeCallableParam callableParam(lua_gettop(L), bindingContext->borrowScriptContext());
+
+	const GFundamentalSignature * signature = userData->getMethodData()->getFundamentalSignature();
+	if(signature != nullptr) {
+		int resultCount;
+		if(invokeFundamentalMethod(bindingContext, userData->getObjectData(), signature, &resultCount)) {
+			return resultCount;
+		}
+	}
+
+	InvokeCallableParam callableParam(lua_gettop(L), bindingContext.get());
 	loadCallableParam(bindingContext, &callableParam, 1);
 	
 	InvokeCallableResult result = doInvokeMethodList(bindingContext, userData->getObjectData(), userData->getMethodData(), &callableParam);
@@ -778,7 +911,7 @@ int invokeConstructor(const GClassGlueDataPointer & classUserData)
 
 	const GContextPointer & context(classUserData->getBindingContext());
 
-	InvokeCallableParam callableParam(paramCount, context->borrowScriptContext());
+	InvokeCallableParam callableParam(paramCount, context.get());
 	loadCallableParam(context, &callableParam, 2);
 	
 	void * instance = doInvokeConstructor(context, context->getService(), classUserData->getMetaClass(), &callableParam);
@@ -809,7 +942,7 @@ int invokeOperator(const GContextPointer & context, const GObjectGlueDataPointer
 		paramCount = 1; // Lua pass two parameters to __unm...
 	}
 
-	InvokeCallableParam callableParam(paramCount, context->borrowScriptContext());
+	InvokeCallableParam callableParam(paramCount, context.get());
 	loadCallableParam(context, &callableParam, startIndex);
 	
 	InvokeCallableResult result = doInvokeOperator(context, objectData, metaClass, op, &callableParam);
@@ -822,6 +955,9 @@ int UserData_gc(lua_State * L)
 	ENTER_LUA()
 
 	GGlueDataWrapper * dataWrapper = static_cast<GGlueDataWrapper *>(lua_touserdata(L, -1));
+	if(dataWrapper->getData()->isValid()) {
+		dataWrapper->getData()->getBindingContext()->getScriptObjectCache()->freeScriptObject(dataWrapper);
+	}
 	destroyGlueDataWrapper(dataWrapper);
 	
 	return 0;
@@ -914,6 +1050,7 @@ void helperBindOperator(const GContextPointer & context, const GObjectGlueDataPo
 			}
 
 			lua_pushstring(L, luaOperators[i]);
+			G_META_PROFILE_COUNT(mpcLuaUserData);
 			void * userData = lua_newuserdata(L, getGlueDataWrapperSize<GOperatorGlueData>());
 			newGlueDataWrapper(userData, operatorData);
 
@@ -939,12 +1076,11 @@ void helperBindOperator(const GContextPointer & context, const GObjectGlueDataPo
 void helperBindAllOperators(const GContextPointer & context, const GObjectGlueDataPointer & objectData,
 	IMetaClass * metaClass, bool bindingToObject)
 {
-	std::set<uint32_t> boundOperators;
+	// The operator list is built once per class in the meta map,
+	// so binding an object doesn't need to walk the meta operators.
+	const std::vector<uint32_t> & operatorList = context->getClassData(metaClass)->getClassMap()->getOperatorList();
 
-	int count = metaClass->getOperatorCount();
-	for(int i = 0; i < count; ++i) {
-		GScopedInterface<IMetaOperator> item(metaClass->getOperatorAt(i));
-		uint32_t op = item->getOperator();
+	for(uint32_t op : operatorList) {
 		if((op == mopFunctor && !bindingToObject)
 			|| (op != mopFunctor && bindingToObject)) {
 			// If it's binding to class, we bind all operators exception functor,
@@ -952,10 +1088,7 @@ void helperBindAllOperators(const GContextPointer & context, const GObjectGlueDa
 			// If it's binding to object, we only bind functor, to optimize performance.
 			continue;
 		}
-		if(boundOperators.find(op) == boundOperators.end()) {
-			boundOperators.insert(op);
-			helperBindOperator(context, objectData, metaClass, static_cast<GMetaOpType>(op));
-		}
+		helperBindOperator(context, objectData, metaClass, static_cast<GMetaOpType>(op));
 	}
 }
 
@@ -973,6 +1106,7 @@ void helperBindClass(const GContextPointer & context, IMetaClass * metaClass)
 		lua_pop(L, 1);
 	}
 
+	G_META_PROFILE_COUNT(mpcLuaUserData);
 	void * userData = lua_newuserdata(L, getGlueDataWrapperSize<GClassGlueData>());
 	newGlueDataWrapper(userData, classData);
 
@@ -1011,6 +1145,7 @@ void helperBindMethods(
 		lua_pop(L, 1);
 	}
 
+	G_META_PROFILE_COUNT(mpcLuaUserData);
 	void * userData = lua_newuserdata(L, getGlueDataWrapperSize<GObjectAndMethodGlueData>());
 	newGlueDataWrapper(userData, objectAndMethodData);
 
@@ -1252,24 +1387,145 @@ void initObjectMetaTable(lua_State * L)
 }
 
 
+GMetaByteArray * byteArrayFromLua(lua_State * L)
+{
+	GMetaByteArray * byteArray = nullptr;
+	if(lua_isuserdata(L, 1) && isValidMetaTable(L, 1)) {
+		byteArray = getByteArrayFromGlueData(static_cast<GGlueDataWrapper *>(lua_touserdata(L, 1))->getData());
+	}
+	if(byteArray == nullptr) {
+		raiseCoreException(Error_ScriptBinding_AccessMemberWithWrongObject);
+	}
+
+	return byteArray;
+}
+
+char * byteArrayAddressFromLua(lua_State * L, GMetaByteArray * byteArray, const size_t size)
+{
+	const lua_Integer offset = lua_tointeger(L, 2);
+	if(offset < 0 || static_cast<size_t>(offset) + size > byteArray->getLength()) {
+		raiseCoreException(Error_ScriptBinding_ScriptMethodParamMismatch, 0, "GMetaByteArray accessor (offset is out of range)");
+	}
+
+	return static_cast<char *>(byteArray->getPointer()) + offset;
+}
+
+// byteArray:getXXX(offset), where offset is in bytes and doesn't change the position.
+template <typename T>
+int ByteArray_get(lua_State * L)
+{
+	ENTER_LUA()
+
+	GMetaByteArray * byteArray = byteArrayFromLua(L);
+	T value;
+	memcpy(&value, byteArrayAddressFromLua(L, byteArray, sizeof(T)), sizeof(T));
+	if(std::is_integral<T>::value) {
+		lua_pushinteger(L, static_cast<lua_Integer>(value));
+	}
+	else {
+		lua_pushnumber(L, static_cast<lua_Number>(value));
+	}
+	return 1;
+
+	LEAVE_LUA(L, return 0)
+}
+
+// byteArray:setXXX(offset, value)
+template <typename T>
+int ByteArray_set(lua_State * L)
+{
+	ENTER_LUA()
+
+	GMetaByteArray * byteArray = byteArrayFromLua(L);
+	const T value = std::is_integral<T>::value ? static_cast<T>(lua_tointeger(L, 3)) : static_cast<T>(lua_tonumber(L, 3));
+	memcpy(byteArrayAddressFromLua(L, byteArray, sizeof(T)), &value, sizeof(T));
+	return 0;
+
+	LEAVE_LUA(L, return 0)
+}
+
+int ByteArray_length(lua_State * L)
+{
+	ENTER_LUA()
+
+	lua_pushinteger(L, static_cast<lua_Integer>(byteArrayFromLua(L)->getLength()));
+	return 1;
+
+	LEAVE_LUA(L, return 0)
+}
+
+int ByteArray_index(lua_State * L)
+{
+	lua_pushvalue(L, 2);
+	lua_rawget(L, lua_upvalueindex(1));
+	if(! lua_isnil(L, -1)) {
+		return 1;
+	}
+	lua_pop(L, 1);
+
+	return UserData_index(L);
+}
+
+// The accessors are plain Lua C functions working on the byte array memory,
+// they are much faster than the reflected readXXX/writeXXX methods.
+void initByteArrayMetaTable(lua_State * L)
+{
+	const luaL_Reg accessors[] = {
+		{ "getInt8", &ByteArray_get<int8_t> },
+		{ "getInt16", &ByteArray_get<int16_t> },
+		{ "getInt32", &ByteArray_get<int32_t> },
+		{ "getInt64", &ByteArray_get<int64_t> },
+		{ "getUint8", &ByteArray_get<uint8_t> },
+		{ "getUint16", &ByteArray_get<uint16_t> },
+		{ "getUint32", &ByteArray_get<uint32_t> },
+		{ "getUint64", &ByteArray_get<uint64_t> },
+		{ "getFloat32", &ByteArray_get<float> },
+		{ "getFloat64", &ByteArray_get<double> },
+		{ "setInt8", &ByteArray_set<int8_t> },
+		{ "setInt16", &ByteArray_set<int16_t> },
+		{ "setInt32", &ByteArray_set<int32_t> },
+		{ "setInt64", &ByteArray_set<int64_t> },
+		{ "setUint8", &ByteArray_set<uint8_t> },
+		{ "setUint16", &ByteArray_set<uint16_t> },
+		{ "setUint32", &ByteArray_set<uint32_t> },
+		{ "setUint64", &ByteArray_set<uint64_t> },
+		{ "setFloat32", &ByteArray_set<float> },
+		{ "setFloat64", &ByteArray_set<double> },
+		{ nullptr, nullptr }
+	};
+
+	lua_pushstring(L, "__index");
+	lua_newtable(L);
+	for(const luaL_Reg * accessor = accessors; accessor->name != nullptr; ++accessor) {
+		lua_pushstring(L, accessor->name);
+		lua_pushcclosure(L, accessor->func, 0);
+		lua_rawset(L, -3);
+	}
+	lua_pushcclosure(L, &ByteArray_index, 1);
+	lua_rawset(L, -3);
+
+	lua_pushstring(L, "__len");
+	lua_pushcclosure(L, &ByteArray_length, 0);
+	lua_rawset(L, -3);
+}
+
 int Enum_index(lua_State * L)
 {
 	ENTER_LUA()
 
 	GEnumGlueDataPointer userData = static_cast<GGlueDataWrapper *>(lua_touserdata(L, -2))->getAs<GEnumGlueData>();
 	
+	// lua_tostring returns nullptr if the key is neither a string nor a number.
 	const char * name = lua_tostring(L, -1);
 
-	int index = userData->getMetaEnum()->findKey(name);
+	const int index = (name != nullptr ? userData->getMetaEnum()->findKey(name) : -1);
 	if(index < 0) {
-		raiseCoreException(Error_ScriptBinding_CantFindEnumKey, name);
-	}
-	else {
-		GVariant value(metaGetEnumValue(userData->getMetaEnum(), index));
-		lua_pushinteger(L, fromVariant<lua_Integer>(value));
+		raiseCoreException(Error_ScriptBinding_CantFindEnumKey, name != nullptr ? name : "");
 	}
+
+	lua_pushinteger(L, static_cast<lua_Integer>(userData->getMetaEnum()->getIntValue(index)));
 	
-	return true;
+	return 1;
 	
 	LEAVE_LUA(L, return false)
 }
@@ -1289,6 +1545,7 @@ void helperBindEnum(const GContextPointer & context, IMetaEnum * metaEnum)
 {
 	lua_State * L = getLuaState(context);
 
+	G_META_PROFILE_COUNT(mpcLuaUserData);
 	void * userData = lua_newuserdata(L, getGlueDataWrapperSize<GEnumGlueData>());
 	GEnumGlueDataPointer enumData(context->newEnumGlueData(metaEnum));
 	newGlueDataWrapper(userData, enumData);
@@ -1463,9 +1720,63 @@ GScriptValue GLuaScriptFunction::invoke(const GVariant * params, size_t paramCou
 
 GScriptValue GLuaScriptFunction::invokeIndirectly(GVariant const * const * params, size_t paramCount)
 {
+	lua_State * L = getLuaState(this->getBindingContext());
+	const int top = lua_gettop(L);
+
 	this->toLua();
 
-	return invokeLuaFunctionIndirectly(this->getBindingContext(), params, paramCount, "");
+	try {
+		GScriptValue result = invokeLuaFunctionIndirectly(this->getBindingContext(), params, paramCount, "");
+		// Pop the result, otherwise the stack overflows when C++ calls the function many times.
+		lua_settop(L, top);
+		return result;
+	}
+	catch(...) {
+		lua_settop(L, top);
+		throw;
+	}
+}
+
+void GLuaScriptFunction::invokeBatch(GScriptValue * outResults, GVariant const * const * params, size_t paramCount, size_t batchCount)
+{
+	if(paramCount > REF_MAX_ARITY) {
+		raiseCoreException(Error_ScriptBinding_CallMethodWithTooManyParameters);
+	}
+
+	// Lock the context and fetch the function once for the whole batch.
+	const GContextPointer context(this->getBindingContext());
+	if(! context) {
+		raiseCoreException(Error_ScriptBinding_NoContext);
+	}
+
+	lua_State * L = getLuaState(context);
+	const int top = lua_gettop(L);
+	const GVariant * callParams[REF_MAX_ARITY];
+
+	this->toLua();
+
+	try {
+		for(size_t i = 0; i < batchCount; ++i) {
+			for(size_t n = 0; n < paramCount; ++n) {
+				callParams[n] = &params[n][i];
+			}
+
+			lua_pushvalue(L, top + 1);
+			GScriptValue result = invokeLuaFunctionIndirectly(context, callParams, paramCount, "");
+			// Pop the result, so the stack doesn't grow with the batch.
+			lua_settop(L, top + 1);
+
+			if(outResults != nullptr) {
+				outResults[i] = result;
+			}
+		}
+	}
+	catch(...) {
+		lua_settop(L, top);
+		throw;
+	}
+
+	lua_settop(L, top);
 }
 
 void GLuaScriptFunction::toLua()
@@ -1559,6 +1870,100 @@ GScriptValue GLuaScriptArray::createScriptArray(size_t index)
 	return GScriptValue::fromScriptArray(scriptArray.get());
 }	
 
+template <typename T>
+struct LuaFundamentalArraySetter
+{
+	static void apply(lua_State * L, int tableIndex, size_t index, const void * data, size_t count) {
+		const T * p = static_cast<const T *>(data);
+		for(size_t i = 0; i < count; ++i) {
+			if(std::is_same<T, bool>::value) {
+				lua_pushboolean(L, p[i] ? 1 : 0);
+			}
+			else if(std::is_integral<T>::value) {
+				lua_pushinteger(L, static_cast<lua_Integer>(p[i]));
+			}
+			else {
+				lua_pushnumber(L, static_cast<lua_Number>(p[i]));
+			}
+			lua_rawseti(L, tableIndex, (int)(index + i + 1));
+		}
+	}
+};
+
+template <typename T>
+struct LuaFundamentalArrayGetter
+{
+	static void apply(lua_State * L, int tableIndex, size_t index, void * outData, size_t count) {
+		T * p = static_cast<T *>(outData);
+		for(size_t i = 0; i < count; ++i) {
+			lua_rawgeti(L, tableIndex, (int)(index + i + 1));
+			switch(lua_type(L, -1)) {
+				case LUA_TNUMBER:
+#if LUA_VERSION_NUM >= 503
+					if(std::is_integral<T>::value && lua_isinteger(L, -1)) {
+						p[i] = static_cast<T>(lua_tointeger(L, -1));
+						break;
+					}
+#endif
+					p[i] = static_cast<T>(lua_tonumber(L, -1));
+					break;
+
+				case LUA_TBOOLEAN:
+					p[i] = static_cast<T>(lua_toboolean(L, -1) != 0);
+					break;
+
+				default:
+					p[i] = T();
+					break;
+			}
+			lua_pop(L, 1);
+		}
+	}
+};
+
+void GLuaScriptArray::setFundamentalArray(size_t index, const void * data, size_t count, GVariantType vt)
+{
+	lua_State * L = getLuaState(this->getBindingContext());
+
+	getRefObject(L, this->ref);
+
+#if LUA_VERSION_NUM >= 502
+	checkFundamentalArraySetIndex(index, lua_rawlen(L, -1));
+#else
+	checkFundamentalArraySetIndex(index, lua_objlen(L, -1));
+#endif
+
+	dispatchFundamentalArray<LuaFundamentalArraySetter>(vt, L, lua_gettop(L), index, data, count);
+	lua_pop(L, 1);
+}
+
+size_t GLuaScriptArray::getFundamentalArray(size_t index, void * outData, size_t count, GVariantType vt)
+{
+	lua_State * L = getLuaState(this->getBindingContext());
+
+	getRefObject(L, this->ref);
+
+#if LUA_VERSION_NUM >= 502
+	const size_t length = lua_rawlen(L, -1);
+#else
+	const size_t length = lua_objlen(L, -1);
+#endif
+
+	if(index >= length) {
+		count = 0;
+	}
+	else if(count > length - index) {
+		count = length - index;
+	}
+
+	if(count > 0) {
+		dispatchFundamentalArray<LuaFundamentalArrayGetter>(vt, L, lua_gettop(L), index, outData, count);
+	}
+	lua_pop(L, 1);
+
+	return count;
+}
+
 void GLuaScriptArray::toLua()
 {
 	lua_State * L = getLuaState(this->getBindingContext());
@@ -1566,8 +1971,8 @@ void GLuaScriptArray::toLua()
 }
 
 
-GLuaScriptObject::GLuaScriptObject(IMetaService * service, lua_State * L)
-	: super(GContextPointer(new GLuaBindingContext(service, L))), luaState(L), ref(LUA_NOREF)
+GLuaScriptObject::GLuaScriptObject(IMetaService * service, lua_State * L, const GMetaMapPointer & metaMap)
+	: super(GContextPointer(new GLuaBindingContext(service, L, metaMap))), luaState(L), ref(LUA_NOREF)
 {
 }
 
@@ -1748,11 +2153,11 @@ GScriptValue GLuaScriptObject::getAsScriptArray(const char * name)
 	}
 }
 
-GScriptValue GLuaScriptObject::createScriptArray(const char * name)
+GScriptValue GLuaScriptObject::createScriptArray(const char * name, size_t reserveLength)
 {
 	GLuaScopeGuard scopeGuard(this);
 
-	lua_newtable(this->luaState);
+	lua_createtable(this->luaState, static_cast<int>(reserveLength), 0);
 	scopeGuard.set(name);
 	scopeGuard.get(name);
 
@@ -1775,6 +2180,16 @@ IScriptObject * createLuaScriptInterface(IMetaService * service, lua_State * L)
 	return new ImplScriptObject(new GLuaScriptObject(service, L), true);
 }
 
+namespace bind_internal {
+
+// Used by GLuaStatePool to share the class maps among the pooled states.
+GScriptObject * doCreateLuaScriptObject(IMetaService * service, lua_State * L, const GMetaMapPointer & metaMap)
+{
+	return new GLuaScriptObject(service, L, metaMap);
+}
+
+} // namespace bind_internal
+
 
 } // namespace cpgf
 
@@ -0,0 +1,247 @@
+#include "cpgf/scriptbind/gluastatepool.h"
+#include "cpgf/gmetaapi.h"
+#include "cpgf/gsharedinterface.h"
+#include "cpgf/gassert.h"
+
+#include "gbindmetamap.h"
+
+#include <vector>
+#include <mutex>
+
+
+#if LUA_VERSION_NUM >= 502
+	#define HAS_LUA_GLOBALSINDEX 0
+#else
+	#define HAS_LUA_GLOBALSINDEX 1
+#endif
+
+
+namespace cpgf {
+
+namespace bind_internal {
+
+GScriptObject * doCreateLuaScriptObject(IMetaService * service, lua_State * L, const GMetaMapPointer & metaMap);
+
+} // namespace bind_internal
+
+using namespace bind_internal;
+
+
+namespace {
+
+void pushGlobalTable(lua_State * L)
+{
+#if HAS_LUA_GLOBALSINDEX
+	lua_pushvalue(L, LUA_GLOBALSINDEX);
+#else
+	lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+#endif
+}
+
+} // unnamed namespace
+
+
+class GLuaStatePoolImplement
+{
+public:
+	GLuaStatePoolImplement(IMetaService * service, const GLuaStatePool::BinderType & binder);
+	~GLuaStatePoolImplement();
+
+	GLuaPooledState * acquire();
+	void release(GLuaPooledState * state);
+	void reserve(size_t count);
+
+	size_t getIdleCount() const;
+	size_t getTotalCount() const;
+
+private:
+	GSharedInterface<IMetaService> service;
+	GLuaStatePool::BinderType binder;
+	GMetaMapPointer metaMap;
+
+	std::vector<GLuaPooledState *> idleList;
+	size_t totalCount;
+	mutable std::mutex mutex;
+
+private:
+	friend class GLuaPooledState;
+};
+
+
+GLuaPooledState::GLuaPooledState(GLuaStatePoolImplement * pool)
+	: luaState(luaL_newstate()), scriptObject(), snapshotRef(LUA_NOREF)
+{
+	luaL_openlibs(this->luaState);
+
+	this->scriptObject.reset(doCreateLuaScriptObject(pool->service.get(), this->luaState, pool->metaMap));
+	if(! pool->binder.empty()) {
+		pool->binder(this->scriptObject.get());
+	}
+
+	// Shallow copy of the global table, reset() restores the globals from it.
+	lua_State * L = this->luaState;
+	lua_newtable(L);
+	pushGlobalTable(L);
+	lua_pushnil(L);
+	while(lua_next(L, -2) != 0) {
+		lua_pushvalue(L, -2);
+		lua_insert(L, -2);
+		lua_rawset(L, -5);
+	}
+	lua_pop(L, 1);
+	this->snapshotRef = luaL_ref(L, LUA_REGISTRYINDEX);
+}
+
+GLuaPooledState::~GLuaPooledState()
+{
+	luaL_unref(this->luaState, LUA_REGISTRYINDEX, this->snapshotRef);
+	this->scriptObject.reset();
+	lua_close(this->luaState);
+}
+
+void GLuaPooledState::reset()
+{
+	lua_State * L = this->luaState;
+
+	lua_settop(L, 0);
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, this->snapshotRef);
+	pushGlobalTable(L);
+
+	// Remove the globals added by the job.
+	// Assigning nil to an existing field during lua_next is allowed.
+	lua_pushnil(L);
+	while(lua_next(L, 2) != 0) {
+		lua_pop(L, 1);
+		lua_pushvalue(L, -1);
+		lua_rawget(L, 1);
+		const bool isNew = lua_isnil(L, -1);
+		lua_pop(L, 1);
+		if(isNew) {
+			lua_pushvalue(L, -1);
+			lua_pushnil(L);
+			lua_rawset(L, 2);
+		}
+	}
+
+	// Restore the globals the job overwrote or removed.
+	lua_pushnil(L);
+	while(lua_next(L, 1) != 0) {
+		lua_pushvalue(L, -2);
+		lua_insert(L, -2);
+		lua_rawset(L, 2);
+	}
+
+	lua_settop(L, 0);
+}
+
+
+GLuaStatePoolImplement::GLuaStatePoolImplement(IMetaService * service, const GLuaStatePool::BinderType & binder)
+	: service(service), binder(binder), metaMap(new GMetaMap()), idleList(), totalCount(0)
+{
+}
+
+GLuaStatePoolImplement::~GLuaStatePoolImplement()
+{
+	GASSERT_MSG(this->idleList.size() == this->totalCount, "All Lua states must be released before destroying GLuaStatePool");
+
+	for(GLuaPooledState * state : this->idleList) {
+		delete state;
+	}
+}
+
+GLuaPooledState * GLuaStatePoolImplement::acquire()
+{
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+		if(! this->idleList.empty()) {
+			GLuaPooledState * state = this->idleList.back();
+			this->idleList.pop_back();
+			return state;
+		}
+	}
+
+	// Binding is slow, don't block the other threads meanwhile.
+	GLuaPooledState * state = new GLuaPooledState(this);
+
+	std::lock_guard<std::mutex> lockGuard(this->mutex);
+	++this->totalCount;
+
+	return state;
+}
+
+void GLuaStatePoolImplement::release(GLuaPooledState * state)
+{
+	if(state == nullptr) {
+		return;
+	}
+
+	state->reset();
+
+	std::lock_guard<std::mutex> lockGuard(this->mutex);
+	this->idleList.push_back(state);
+}
+
+void GLuaStatePoolImplement::reserve(size_t count)
+{
+	while(this->getIdleCount() < count) {
+		GLuaPooledState * state = new GLuaPooledState(this);
+
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		++this->totalCount;
+		this->idleList.push_back(state);
+	}
+}
+
+size_t GLuaStatePoolImplement::getIdleCount() const
+{
+	std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+	return this->idleList.size();
+}
+
+size_t GLuaStatePoolImplement::getTotalCount() const
+{
+	std::lock_guard<std::mutex> lockGuard(this->mutex);
+
+	return this->totalCount;
+}
+
+
+GLuaStatePool::GLuaStatePool(IMetaService * service, const BinderType & binder)
+	: implement(new GLuaStatePoolImplement(service, binder))
+{
+}
+
+GLuaStatePool::~GLuaStatePool()
+{
+}
+
+GLuaPooledState * GLuaStatePool::acquire()
+{
+	return this->implement->acquire();
+}
+
+void GLuaStatePool::release(GLuaPooledState * state)
+{
+	this->implement->release(state);
+}
+
+void GLuaStatePool::reserve(size_t count)
+{
+	this->implement->reserve(count);
+}
+
+size_t GLuaStatePool::getIdleCount() const
+{
+	return this->implement->getIdleCount();
+}
+
+size_t GLuaStatePool::getTotalCount() const
+{
+	return this->implement->getTotalCount();
+}
+
+
+} // namespace cpgf
@@ -14,6 +14,7 @@
 #include "cpgf/gstringmap.h"
 #include "cpgf/gerrorcode.h"
 #include "cpgf/gstringutil.h"
+#include "cpgf/metautility/gmetabytearray.h"
 
 #include "gbindcommon.h"
 #include "gbindapiimpl.h"
@@ -134,6 +135,14 @@ public:
 		: super(service)
 	{
 	}
+
+	virtual void * releaseScriptLock() override {
+		return PyEval_SaveThread();
+	}
+
+	virtual void acquireScriptLock(void * lockState) override {
+		PyEval_RestoreThread(static_cast<PyThreadState *>(lockState));
+	}
 };
 
 typedef std::shared_ptr<GPythonBindingContext> GPythonContextPointer;
@@ -149,6 +158,7 @@ public:
 
 	virtual GScriptValue invoke(const GVariant * params, size_t paramCount);
 	virtual GScriptValue invokeIndirectly(GVariant const * const * params, size_t paramCount);
+	virtual void invokeBatch(GScriptValue * outResults, GVariant const * const * params, size_t paramCount, size_t batchCount);
 	
 	PyObject * getPythonObject() const {
 		return this->func;
@@ -175,6 +185,9 @@ public:
 	virtual GScriptValue getAsScriptArray(size_t index);
 	virtual GScriptValue createScriptArray(size_t index);
 
+	virtual void setFundamentalArray(size_t index, const void * data, size_t count, GVariantType vt);
+	virtual size_t getFundamentalArray(size_t index, void * outData, size_t count, GVariantType vt);
+
 	PyObject * getPythonObject() const {
 		return this->listObject;
 	}
@@ -203,7 +216,7 @@ public:
 
 	virtual bool maybeIsScriptArray(const char * name);
 	virtual GScriptValue getAsScriptArray(const char * name);
-	virtual GScriptValue createScriptArray(const char * name);
+	virtual GScriptValue createScriptArray(const char * name, size_t reserveLength);
 
 	GPythonContextPointer getPythonContext() const {
 		return std::static_pointer_cast<GPythonBindingContext>(this->getBindingContext());
@@ -459,6 +472,23 @@ PyObject * binaryOperator(PyObject * a, PyObject * b);
 template <GMetaOpType op>
 PyObject * unaryOperator(PyObject * a);
 
+Py_ssize_t byteArrayGetBuffer(PyObject * object, Py_ssize_t segment, void ** pointer);
+Py_ssize_t byteArrayGetSegmentCount(PyObject * object, Py_ssize_t * lengthPointer);
+Py_ssize_t byteArrayGetCharBuffer(PyObject * object, Py_ssize_t segment, char ** pointer);
+int byteArrayGetNewBuffer(PyObject * object, Py_buffer * view, int flags);
+void byteArrayReleaseBuffer(PyObject * object, Py_buffer * view);
+
+// Only objects of GMetaByteArray support the buffer interface,
+// so script can process the bytes without calling the read/write methods.
+PyBufferProcs bufferProcs = {
+	&byteArrayGetBuffer, /* bf_getreadbuffer */
+	&byteArrayGetBuffer, /* bf_getwritebuffer */
+	&byteArrayGetSegmentCount, /* bf_getsegcount */
+	&byteArrayGetCharBuffer, /* bf_getcharbuffer */
+	&byteArrayGetNewBuffer, /* bf_getbuffer */
+	&byteArrayReleaseBuffer, /* bf_releasebuffer */
+};
+
 PyNumberMethods numberMethods = {
 	&binaryOperator<mopAdd, true>, /* nb_add */
 	&binaryOperator<mopSub, true>, /* nb_subtract */
@@ -526,8 +556,8 @@ PyTypeObject objectType = {
 	0,								  /* tp_str */
 	&callbackGetAttribute,			 /* tp_getattro */
 	&callbackSetAttribute,			/* tp_setattro */
-	0,								  /* tp_as_buffer */
-	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES,	/* tp_flags */
+	&bufferProcs,					  /* tp_as_buffer */
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_CHECKTYPES | Py_TPFLAGS_HAVE_NEWBUFFER,	/* tp_flags */
 	0,								  /* tp_doc */
 	0, 			  /* tp_traverse */
 	0,								  /* tp_clear */
@@ -1255,7 +1285,7 @@ PyObject * callbackCallMethod(PyObject * callableObject, PyObject * args, PyObje
 	GObjectAndMethodGlueDataPointer userData = methodObject->getAs<GObjectAndMethodGlueData>();
 
 	GContextPointer bindingContext(userData->getBindingContext());
-	InvokeCallableParam callableParam(static_cast<int>(PyTuple_Size(args)), bindingContext->borrowScriptContext());
+	InvokeCallableParam callableParam(static_cast<int>(PyTuple_Size(args)), bindingContext.get());
 	loadCallableParam(bindingContext, args, &callableParam);
 
 	InvokeCallableResult result = doInvokeMethodList(bindingContext, userData->getObjectData(), userData->getMethodData(), &callableParam);
@@ -1274,7 +1304,7 @@ PyObject * callbackConstructObject(PyObject * callableObject, PyObject * args, P
 	GClassGlueDataPointer classUserData = cppClass->getAs<GClassGlueData>();
 	GContextPointer context = classUserData->getBindingContext();
 
-	InvokeCallableParam callableParam(static_cast<int>(PyTuple_Size(args)), context->borrowScriptContext());
+	InvokeCallableParam callableParam(static_cast<int>(PyTuple_Size(args)), context.get());
 	loadCallableParam(context, args, &callableParam);
 
 	void * instance = doInvokeConstructor(context, context->getService(), classUserData->getMetaClass(), &callableParam);
@@ -1291,6 +1321,73 @@ PyObject * callbackConstructObject(PyObject * callableObject, PyObject * args, P
 	LEAVE_PYTHON(return nullptr)
 }
 
+GMetaByteArray * byteArrayFromPython(PyObject * object)
+{
+	GMetaByteArray * byteArray = getByteArrayFromGlueData(nativeFromPython(object)->getData());
+	if(byteArray == nullptr) {
+		PyErr_SetString(PyExc_TypeError, "Only GMetaByteArray supports the buffer interface.");
+	}
+
+	return byteArray;
+}
+
+Py_ssize_t byteArrayGetBuffer(PyObject * object, Py_ssize_t segment, void ** pointer)
+{
+	if(segment != 0) {
+		PyErr_SetString(PyExc_SystemError, "Accessing non-existent buffer segment.");
+		return -1;
+	}
+
+	GMetaByteArray * byteArray = byteArrayFromPython(object);
+	if(byteArray == nullptr) {
+		return -1;
+	}
+
+	*pointer = byteArray->getPointer();
+	return static_cast<Py_ssize_t>(byteArray->getLength());
+}
+
+Py_ssize_t byteArrayGetSegmentCount(PyObject * object, Py_ssize_t * lengthPointer)
+{
+	GMetaByteArray * byteArray = getByteArrayFromGlueData(nativeFromPython(object)->getData());
+	if(lengthPointer != nullptr) {
+		*lengthPointer = (byteArray != nullptr ? static_cast<Py_ssize_t>(byteArray->getLength()) : 0);
+	}
+
+	return byteArray != nullptr ? 1 : 0;
+}
+
+Py_ssize_t byteArrayGetCharBuffer(PyObject * object, Py_ssize_t segment, char ** pointer)
+{
+	return byteArrayGetBuffer(object, segment, reinterpret_cast<void **>(pointer));
+}
+
+int byteArrayGetNewBuffer(PyObject * object, Py_buffer * view, int flags)
+{
+	GMetaByteArray * byteArray = byteArrayFromPython(object);
+	if(byteArray == nullptr) {
+		view->obj = nullptr;
+		return -1;
+	}
+
+	// The view points to the byte array memory, so the byte array refuses to change
+	// its length until the view is released, same as Python bytearray.
+	if(PyBuffer_FillInfo(view, object, byteArray->getPointer(), static_cast<Py_ssize_t>(byteArray->getLength()), 0, flags) < 0) {
+		return -1;
+	}
+	byteArray->addBufferExport();
+
+	return 0;
+}
+
+void byteArrayReleaseBuffer(PyObject * object, Py_buffer * /*view*/)
+{
+	GMetaByteArray * byteArray = getByteArrayFromGlueData(nativeFromPython(object)->getData());
+	if(byteArray != nullptr) {
+		byteArray->releaseBufferExport();
+	}
+}
+
 PyObject * callbackGetAttribute(PyObject * object, PyObject * attrName)
 {
 	ENTER_PYTHON()
@@ -1761,7 +1858,7 @@ PyObject * binaryOperator(PyObject * a, PyObject * b)
 	GObjectGlueDataPointer objectData = nativeFromPython(self)->getAs<GObjectGlueData>();
 	const GContextPointer & context = objectData->getBindingContext();
 
-	InvokeCallableParam callableParam(2, context->borrowScriptContext());
+	InvokeCallableParam callableParam(2, context.get());
 
 	callableParam.params[selfIndex].value = doScriptToValue(context, self, &callableParam.params[selfIndex].paramGlueData);
 
@@ -1784,7 +1881,7 @@ PyObject * unaryOperator(PyObject * a)
 	GObjectGlueDataPointer objectData = nativeFromPython(self)->getAs<GObjectGlueData>();
 	const GContextPointer & context = objectData->getBindingContext();
 
-	InvokeCallableParam callableParam(1, context->borrowScriptContext());
+	InvokeCallableParam callableParam(1, context.get());
 
 	callableParam.params[0].value = doScriptToValue(context, self, &callableParam.params[0].paramGlueData);
 
@@ -1827,6 +1924,49 @@ GScriptValue GPythonScriptFunction::invokeIndirectly(GVariant const * const * pa
 	return invokePythonFunctionIndirectly(this->getBindingContext(), nullptr, this->func, params, paramCount, "");
 }
 
+void GPythonScriptFunction::invokeBatch(GScriptValue * outResults, GVariant const * const * params, size_t paramCount, size_t batchCount)
+{
+	if(paramCount > REF_MAX_ARITY) {
+		raiseCoreException(Error_ScriptBinding_CallMethodWithTooManyParameters);
+	}
+
+	const GContextPointer context(this->getBindingContext());
+	if(! context) {
+		raiseCoreException(Error_ScriptBinding_NoContext);
+	}
+
+	if(! PyCallable_Check(this->func)) {
+		raiseCoreException(Error_ScriptBinding_CantCallNonfunction);
+	}
+
+	GPythonScopedPointer args;
+	for(size_t i = 0; i < batchCount; ++i) {
+		// The argument tuple is reused unless the previous call kept a reference to it.
+		if(! args || Py_REFCNT(args.get()) != 1) {
+			args.reset(PyTuple_New(paramCount));
+		}
+
+		for(size_t n = 0; n < paramCount; ++n) {
+			PyObject * arg = doValueToScript(
+				context,
+				doCreateScriptValueFromVariant(context, params[n][i], false),
+				ScriptValueToScriptData(),
+				true
+			);
+			if(arg == nullptr) {
+				raiseCoreException(Error_ScriptBinding_ScriptMethodParamMismatch, n, "");
+			}
+			PyTuple_SetItem(args.get(), n, arg);
+		}
+
+		GPythonScopedPointer result(PyObject_Call(this->func, args.get(), nullptr));
+		GScriptValue value = doScriptToValue(context, result.get(), nullptr);
+		if(outResults != nullptr) {
+			outResults[i] = value;
+		}
+	}
+}
+
 
 GPythonScriptArray::GPythonScriptArray(const GContextPointer & context, PyObject * listObject)
 	: super(context), listObject(listObject)
@@ -1928,6 +2068,95 @@ GScriptValue GPythonScriptArray::createScriptArray(size_t index)
 	return GScriptValue();
 }
 
+template <typename T>
+PyObject * fundamentalToPython(const T & value)
+{
+	if(std::is_same<T, bool>::value) {
+		return pyAddRef(value ? Py_True : Py_False);
+	}
+	else if(std::is_integral<T>::value) {
+		if(std::is_unsigned<T>::value) {
+			return PyLong_FromUnsignedLongLong(static_cast<unsigned PY_LONG_LONG>(value));
+		}
+		else {
+			return PyLong_FromLongLong(static_cast<PY_LONG_LONG>(value));
+		}
+	}
+	else {
+		return PyFloat_FromDouble(static_cast<double>(value));
+	}
+}
+
+template <typename T>
+struct PythonFundamentalArraySetter
+{
+	static void apply(PyObject * listObject, size_t index, const void * data, size_t count) {
+		const T * p = static_cast<const T *>(data);
+		size_t length = PyList_Size(listObject);
+		for(size_t i = 0; i < count; ++i) {
+			PyObject * item = fundamentalToPython(p[i]);
+			if(index + i < length) {
+				PyList_SetItem(listObject, index + i, item); // steals item
+			}
+			else {
+				PyList_Append(listObject, item);
+				Py_XDECREF(item);
+				++length;
+			}
+		}
+	}
+};
+
+template <typename T>
+struct PythonFundamentalArrayGetter
+{
+	static void apply(PyObject * listObject, size_t index, void * outData, size_t count) {
+		T * p = static_cast<T *>(outData);
+		for(size_t i = 0; i < count; ++i) {
+			PyObject * item = PyList_GET_ITEM(listObject, index + i); // borrowed reference!
+			if(PyInt_Check(item)) {
+				p[i] = static_cast<T>(PyInt_AS_LONG(item));
+			}
+			else if(PyLong_Check(item)) {
+				if(std::is_unsigned<T>::value) {
+					p[i] = static_cast<T>(PyLong_AsUnsignedLongLongMask(item));
+				}
+				else {
+					p[i] = static_cast<T>(PyLong_AsLongLong(item));
+				}
+			}
+			else if(PyFloat_Check(item)) {
+				p[i] = static_cast<T>(PyFloat_AS_DOUBLE(item));
+			}
+			else {
+				p[i] = T();
+			}
+		}
+	}
+};
+
+void GPythonScriptArray::setFundamentalArray(size_t index, const void * data, size_t count, GVariantType vt)
+{
+	checkFundamentalArraySetIndex(index, this->getLength());
+
+	dispatchFundamentalArray<PythonFundamentalArraySetter>(vt, this->listObject, index, data, count);
+}
+
+size_t GPythonScriptArray::getFundamentalArray(size_t index, void * outData, size_t count, GVariantType vt)
+{
+	const size_t length = this->getLength();
+	if(index >= length) {
+		return 0;
+	}
+	if(count > length - index) {
+		count = length - index;
+	}
+
+	dispatchFundamentalArray<PythonFundamentalArrayGetter>(vt, this->listObject, index, outData, count);
+
+	return count;
+}
+
 GPythonScriptObject::GPythonScriptObject(IMetaService * service, PyObject * object)
 	: super(GContextPointer(new GPythonBindingContext(service))), object(object)
 {
@@ -2051,7 +2280,7 @@ GScriptValue GPythonScriptObject::getAsScriptArray(const char * name)
 	}
 }
 
-GScriptValue GPythonScriptObject::createScriptArray(const char * name)
+GScriptValue GPythonScriptObject::createScriptArray(const char * name, size_t /*reserveLength*/)
 {
 	PyObject * attr = getObjectAttr(this->object, name);
 	if(attr != nullptr) {
@@ -2,6 +2,8 @@
 #include "cpgf/scriptbind/gscriptbindutil.h"
 #include "gbindapiimpl.h"
 
+#include <vector>
+
 
 namespace cpgf {
 
@@ -94,6 +96,34 @@ void G_API_CC ImplScriptFunction::invokeIndirectlyOnObject(GScriptValueData * ou
 	LEAVE_BINDING_API()
 }
 
+void G_API_CC ImplScriptFunction::invokeBatch(GScriptValueData * outResults, GVariantData const * const * params, uint32_t paramCount, uint32_t batchCount)
+{
+	ENTER_BINDING_API()
+
+	if(paramCount > REF_MAX_ARITY) {
+		raiseCoreException(Error_ScriptBinding_CallMethodWithTooManyParameters);
+	}
+
+	std::vector<GVariant> paramVariants(paramCount * batchCount);
+	const GVariant * paramArrays[REF_MAX_ARITY];
+
+	for(uint32_t n = 0; n < paramCount; ++n) {
+		GVariant * paramArray = &paramVariants[n * batchCount];
+		for(uint32_t i = 0; i < batchCount; ++i) {
+			paramArray[i] = createVariantFromData(params[n][i]);
+		}
+		paramArrays[n] = paramArray;
+	}
+
+	std::vector<GScriptValue> results(outResults != nullptr ? batchCount : 0);
+	this->scriptFunction->invokeBatch(outResults != nullptr ? &results[0] : nullptr, paramArrays, paramCount, batchCount);
+	for(uint32_t i = 0; i < results.size(); ++i) {
+		outResults[i] = results[i].takeData();
+	}
+
+	LEAVE_BINDING_API()
+}
+
 ImplScriptArray::ImplScriptArray(GScriptArray * scriptArray, bool freeArray)
 	: scriptArray(scriptArray), freeArray(freeArray)
 {
@@ -139,6 +169,16 @@ void G_API_CC ImplScriptArray::createScriptArray(GScriptValueData * outResult, u
 	*outResult = value.takeData();
 }
 
+void G_API_CC ImplScriptArray::setFundamentalArray(uint32_t index, const void * data, uint32_t count, GVtType vt)
+{
+	this->scriptArray->setFundamentalArray(index, data, count, static_cast<GVariantType>(vt));
+}
+
+uint32_t G_API_CC ImplScriptArray::getFundamentalArray(uint32_t index, void * outData, uint32_t count, GVtType vt)
+{
+	return (uint32_t)(this->scriptArray->getFundamentalArray(index, outData, count, static_cast<GVariantType>(vt)));
+}
+
 
 ImplScriptObject::ImplScriptObject(GScriptObject * scriptObject, bool freeObject)
 	: scriptObject(scriptObject), freeObject(freeObject)
@@ -89,9 +89,9 @@ GScriptValue scriptGetAsScriptArray(IScriptObject * scriptObject, const char * n
 	return createScriptValueFromData(data);
 }
 
-GScriptValue scriptCreateScriptArray(GScriptObject * scriptObject, const char * name)
+GScriptValue scriptCreateScriptArray(GScriptObject * scriptObject, const char * name, size_t reserveLength)
 {
-	return scriptObject->createScriptArray(name);
+	return scriptObject->createScriptArray(name, reserveLength);
 }
 
 GScriptValue scriptCreateScriptArray(IScriptObject * scriptObject, const char * name)
@@ -5,6 +5,7 @@
 #include "cpgf/gmetaapi.h"
 #include "cpgf/gglobal.h"
 #include "cpgf/gscopedinterface.h"
+#include "cpgf/gmetaprofile.h"
 
 namespace cpgf {
 
@@ -81,11 +82,14 @@ GScriptValue::GScriptValue(const GScriptValue & other)
 		transferOwnership(other.transferOwnership),
 		cv(other.cv)
 {
+	G_META_PROFILE_COUNT(mpcScriptValueCopy);
 }
 
 GScriptValue & GScriptValue::operator = (const GScriptValue & other)
 {
 	if(this != &other) {
+		G_META_PROFILE_COUNT(mpcScriptValueCopy);
+
 		this->type = other.type;
 		this->value = other.value;
 		this->metaItem = other.metaItem;
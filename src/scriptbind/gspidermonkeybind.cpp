@@ -8,6 +8,8 @@
 #include "../gstaticuninitializerorders.h"
 
 #include <string>
+#include <vector>
+#include <memory>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -141,6 +143,21 @@ private:
 	JSObject  * jsObject;
 };
 
+// A class member defined on the prototype of the class.
+struct GSpiderMemberData
+{
+	GSpiderMemberData(IMetaClass * metaClass, const char * name, const GScriptValue * scriptValue)
+		: metaClass(metaClass), name(name), scriptValue(scriptValue), enumObject()
+	{
+	}
+
+	GSharedInterface<IMetaClass> metaClass;
+	const char * name;
+	const GScriptValue * scriptValue;
+	// Only for enums, created on first access.
+	GScopedJsObject enumObject;
+};
+
 class JsClassUserData : public GUserData
 {
 private:
@@ -184,11 +201,17 @@ public:
 		return GAccessibleGlueDataPointer();
 	}
 
+	GSpiderMemberData * addMemberData(IMetaClass * metaClass, const char * name, const GScriptValue * scriptValue) {
+		this->memberDataList.push_back(std::unique_ptr<GSpiderMemberData>(new GSpiderMemberData(metaClass, name, scriptValue)));
+		return this->memberDataList.back().get();
+	}
+
 private:
 	string className;
 	JSClass jsClass;
 	GScopedJsObject classObject;
 	std::unique_ptr<AccessibleMapType> accessibleMap;
+	std::vector<std::unique_ptr<GSpiderMemberData> > memberDataList;
 };
 
 class GSpiderBindingContext : public GBindingContext, public GShareFromBase
@@ -282,7 +305,7 @@ public:
 
 	virtual bool maybeIsScriptArray(const char * name);
 	virtual GScriptValue getAsScriptArray(const char * name);
-	virtual GScriptValue createScriptArray(const char * name);
+	virtual GScriptValue createScriptArray(const char * name, size_t reserveLength);
 
 	GSpiderContextPointer getSpiderContext() const {
 		return std::static_pointer_cast<GSpiderBindingContext>(this->getBindingContext());
@@ -678,7 +701,7 @@ JSBool callbackMethodList(JSContext * jsContext, unsigned int argc, jsval * valu
 		}
 
 		GContextPointer bindingContext(methodData->getBindingContext());
-		InvokeCallableParam callableParam(argc, bindingContext->borrowScriptContext());
+		InvokeCallableParam callableParam(argc, bindingContext.get());
 		loadCallableParam(valuePointer, std::static_pointer_cast<GSpiderBindingContext>(bindingContext), &callableParam);
 
 		InvokeCallableResult result = doInvokeMethodList(bindingContext, objectData, methodData, &callableParam);
@@ -729,6 +752,21 @@ JsValue objectToSpider(const GSpiderContextPointer & context, const GClassGlueDa
 		return JSVAL_NULL;
 	}
 
+	GScriptObjectCache * scriptObjectCache = context->getScriptObjectCache();
+	GGlueDataWrapper * cachedDataWrapper;
+	JSObject ** cachedObject = scriptObjectCache->findScriptObject<JSObject *>(instanceAddress, classData, cv, &cachedDataWrapper);
+	if(cachedObject != nullptr) {
+		if(flags.has(bvfAllowGC)) {
+			// The cached object may not be owned, such as a new object which is returned
+			// at the address of a deleted one, take the ownership as requested.
+			static_cast<GObjectGlueData *>(cachedDataWrapper->getData().get())->setAllowGC(true);
+		}
+		if(outputGlueData != nullptr) {
+			*outputGlueData = cachedDataWrapper->getData();
+		}
+		return ObjectValue(**cachedObject);
+	}
+
 	GObjectGlueDataPointer objectData = context->newObjectGlueData(classData, instance, flags, cv);
 	GGlueDataWrapper * objectWrapper = newGlueDataWrapper(objectData, std::static_pointer_cast<GSpiderBindingContext>(context)->getGlueDataWrapperPool());
 
@@ -742,6 +780,7 @@ JsValue objectToSpider(const GSpiderContextPointer & context, const GClassGlueDa
 
 	JSObject * object = JS_NewObject(context->getJsContext(), classUserData->getJsClass(), nullptr, nullptr);
 	setObjectPrivateData(object, objectWrapper);
+	scriptObjectCache->addScriptObject(instanceAddress, classData, cv, objectWrapper, object);
 
 	return ObjectValue(*object);
 }
@@ -983,7 +1022,7 @@ JSBool objectConstructor(JSContext * jsContext, unsigned int argc, jsval * value
 		GClassGlueDataPointer classData = dataWrapper->getAs<GClassGlueData>();
 		GSpiderContextPointer context = std::static_pointer_cast<GSpiderBindingContext>(classData->getBindingContext());
 
-		InvokeCallableParam callableParam(argc, context->borrowScriptContext());
+		InvokeCallableParam callableParam(argc, context.get());
 		loadCallableParam(valuePointer, context, &callableParam);
 
 		void * instance = doInvokeConstructor(context, context->getService(), classData->getMetaClass(), &callableParam);
@@ -1005,6 +1044,138 @@ JSBool objectConstructor(JSContext * jsContext, unsigned int argc, jsval * value
 	LEAVE_SPIDERMONKEY(return failedResult())
 }
 
+GObjectGlueDataPointer getMemberObjectData(JSContext * jsContext, jsval * valuePointer)
+{
+	GGlueDataWrapper * dataWrapper = getNativeObject(jsContext, JS_THIS_OBJECT(jsContext, valuePointer));
+	if(dataWrapper == nullptr || dataWrapper->getData()->getType() != gdtObject) {
+		raiseCoreException(Error_ScriptBinding_AccessMemberWithWrongObject);
+	}
+
+	return dataWrapper->getAs<GObjectGlueData>();
+}
+
+// The object may be of a class derived from the class declaring the member.
+void * getMemberInstance(const GObjectGlueDataPointer & objectData, const GSpiderMemberData * memberData)
+{
+	void * instance = objectData->getInstanceAddress();
+	IMetaClass * objectClass = objectData->getClassData()->getMetaClass();
+	if(instance != nullptr && objectClass != memberData->metaClass.get()) {
+		instance = metaCastAny(instance, objectClass, memberData->metaClass.get());
+	}
+
+	return instance;
+}
+
+JSBool memberGetter(JSContext * jsContext, unsigned int /*argc*/, jsval * valuePointer)
+{
+	ENTER_SPIDERMONKEY()
+
+	GSpiderMemberData * memberData = static_cast<GSpiderMemberData *>(getFunctionPrivateData(&JS_CALLEE(jsContext, valuePointer).toObject()));
+	GObjectGlueDataPointer objectData = getMemberObjectData(jsContext, valuePointer);
+	GContextPointer context = objectData->getBindingContext();
+
+	JsValue result;
+	const GScriptValue & scriptValue = *memberData->scriptValue;
+	switch(scriptValue.getType()) {
+		case GScriptValue::typeAccessible: {
+			void * tempInstance;
+			GScopedInterface<IMetaAccessible> accessible(scriptValue.toAccessible(&tempInstance));
+			result = accessibleToScript<GSpiderMethods>(context, accessible.get(), getMemberInstance(objectData, memberData),
+				objectData->getCV() == GScriptInstanceCv::sicvConst);
+			break;
+		}
+
+		case GScriptValue::typeEnum:
+			if(memberData->enumObject.getJsObject() == nullptr) {
+				GScopedInterface<IMetaEnum> metaEnum(scriptValue.toEnum());
+				memberData->enumObject.reset(jsContext, createEnumBinding(std::static_pointer_cast<GSpiderBindingContext>(context), metaEnum.get()));
+			}
+			result = ObjectValue(*memberData->enumObject.getJsObject());
+			break;
+
+		default:
+			result = namedMemberToScript<GSpiderMethods>(objectData, memberData->name);
+			break;
+	}
+
+	JS_SET_RVAL(jsContext, valuePointer, result);
+	return JS_TRUE;
+
+	LEAVE_SPIDERMONKEY(return failedResult())
+}
+
+JSBool memberSetter(JSContext * jsContext, unsigned int argc, jsval * valuePointer)
+{
+	ENTER_SPIDERMONKEY()
+
+	GSpiderMemberData * memberData = static_cast<GSpiderMemberData *>(getFunctionPrivateData(&JS_CALLEE(jsContext, valuePointer).toObject()));
+	GObjectGlueDataPointer objectData = getMemberObjectData(jsContext, valuePointer);
+
+	if(objectData->getCV() == GScriptInstanceCv::sicvConst) {
+		raiseCoreException(Error_ScriptBinding_CantWriteToConstObject);
+	}
+
+	GSpiderContextPointer context = std::static_pointer_cast<GSpiderBindingContext>(objectData->getBindingContext());
+	GGlueDataPointer valueGlueData;
+	GScriptValue value = spiderToScriptValue(context, argc > 0 ? JS_ARGV(jsContext, valuePointer)[0] : JSVAL_VOID, &valueGlueData);
+
+	const GScriptValue & scriptValue = *memberData->scriptValue;
+	if(scriptValue.getType() == GScriptValue::typeAccessible) {
+		void * tempInstance;
+		GScopedInterface<IMetaAccessible> accessible(scriptValue.toAccessible(&tempInstance));
+		doSetValueOnAccessible(context, accessible.get(), objectData, value.getValue(), valueGlueData);
+	}
+	else {
+		setValueOnNamedMember(objectData, memberData->name, value, valueGlueData);
+	}
+
+	JS_SET_RVAL(jsContext, valuePointer, JSVAL_VOID);
+	return JS_TRUE;
+
+	LEAVE_SPIDERMONKEY(return failedResult())
+}
+
+// Define the members of the class, not including the base classes, on the prototype once,
+// so all objects of the class share them and creating an object is a single JS_NewObject.
+// The base class members are found through the prototype chain.
+// Methods are plain function values. Assigning to a method on an object still goes to
+// propertySetter, the class setter, so a script function can override a virtual method.
+// The other members are accessor properties with native getter and setter functions.
+void bindClassMembers(const GSpiderContextPointer & context, JSObject * prototype,
+	const GClassGlueDataPointer & classData, JsClassUserData * classUserData)
+{
+	GMetaMapClass * mapClass = classData->getClassMap();
+	if(mapClass == nullptr) {
+		return;
+	}
+
+	JSContext * jsContext = context->getJsContext();
+
+	const GMetaMapClass::MapType * itemMap = mapClass->getMap();
+	for(GMetaMapClass::MapType::const_iterator it = itemMap->begin(); it != itemMap->end(); ++it) {
+		const char * name = it->first;
+		const GScriptValue & scriptValue = it->second.getScriptValue();
+
+		if(scriptValue.getType() == GScriptValue::typeMethod || scriptValue.getType() == GScriptValue::typeOverloadedMethods) {
+			GScopedInterface<IMetaList> methodList(createMethodListFromScriptValue(scriptValue));
+			JSObject * functionObject = JS_GetFunctionObject(createJsFunction(context, classData, methodList.get()));
+			JS_DefineProperty(jsContext, prototype, name, ObjectValue(*functionObject), JS_PropertyStub, JS_StrictPropertyStub, JSPROP_PERMANENT);
+		}
+		else {
+			GSpiderMemberData * memberData = classUserData->addMemberData(classData->getMetaClass(), name, &scriptValue);
+
+			JSObject * getter = JS_GetFunctionObject(JS_NewFunction(jsContext, &memberGetter, 0, 0, nullptr, name));
+			setFunctionPrivateData(getter, memberData);
+			JSObject * setter = JS_GetFunctionObject(JS_NewFunction(jsContext, &memberSetter, 1, 0, nullptr, name));
+			setFunctionPrivateData(setter, memberData);
+
+			JS_DefineProperty(jsContext, prototype, name, JSVAL_VOID,
+				JS_DATA_TO_FUNC_PTR(JSPropertyOp, getter), JS_DATA_TO_FUNC_PTR(JSStrictPropertyOp, setter),
+				JSPROP_GETTER | JSPROP_SETTER | JSPROP_SHARED | JSPROP_PERMANENT);
+		}
+	}
+}
+
 void bindClassItems(const GSpiderContextPointer & context, JSObject * owner, IMetaClass * metaClass)
 {
 	GScopedInterface<IMetaItem> item;
@@ -1056,6 +1227,8 @@ JSObject * createClassBinding(const GSpiderContextPointer & context, JSObject *
 		classUserData->setClassObject(context->getJsContext(), classObject);
 		setClassPrivateData(context->getJsContext(), classObject, dataWrapper);
 
+		bindClassMembers(context, classObject, classData, classUserData);
+
 		JSObject * obj = JS_GetObjectPrototype(context->getJsContext(), classObject);
 		bindClassItems(context, obj, metaClass);
 
@@ -1563,7 +1736,7 @@ GScriptValue GSpiderMonkeyScriptObject::getAsScriptArray(const char * name)
 	return GScriptValue();
 }
 
-GScriptValue GSpiderMonkeyScriptObject::createScriptArray(const char * name)
+GScriptValue GSpiderMonkeyScriptObject::createScriptArray(const char * name, size_t /*reserveLength*/)
 {
 	GScriptValue value = this->getAsScriptArray(name);
 	if(value.isNull()) {
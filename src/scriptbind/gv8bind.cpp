@@ -1,7 +1,6 @@
 #include "cpgf/scriptbind/gscriptbind.h"
 #include "cpgf/scriptbind/gv8bind.h"
 #include "cpgf/scriptbind/gv8runner.h"
-#include "cpgf/gstringmap.h"
 #include "cpgf/gerrorcode.h"
 #include "cpgf/gstringutil.h"
 
@@ -11,6 +10,7 @@
 
 #include <stdexcept>
 #include <memory>
+#include <vector>
 
 
 using namespace std;
@@ -147,7 +147,7 @@ public:
 
 	virtual bool maybeIsScriptArray(const char * name);
 	virtual GScriptValue getAsScriptArray(const char * name);
-	virtual GScriptValue createScriptArray(const char * name);
+	virtual GScriptValue createScriptArray(const char * name, size_t reserveLength);
 
 public:
 	Local<Object> getObject() const {
@@ -189,6 +189,46 @@ private:
 };
 
 
+// A class member installed as an accessor on the prototype template of the class.
+struct GV8MemberData
+{
+	GV8MemberData(IMetaClass * metaClass, const char * name, const GScriptValue * scriptValue)
+		: metaClass(metaClass), name(name), scriptValue(scriptValue), methodTemplate()
+	{
+	}
+
+	~GV8MemberData() {
+		this->methodTemplate.Reset();
+	}
+
+	GSharedInterface<IMetaClass> metaClass;
+	const char * name;
+	const GScriptValue * scriptValue;
+	// Only for methods.
+	Persistent<FunctionTemplate> methodTemplate;
+};
+
+class GClassTemplateUserData : public GFunctionTemplateUserData
+{
+private:
+	typedef GFunctionTemplateUserData super;
+
+public:
+	explicit GClassTemplateUserData(Handle<FunctionTemplate> functionTemplate)
+		: super(functionTemplate), memberDataList()
+	{
+	}
+
+	GV8MemberData * addMemberData(IMetaClass * metaClass, const char * name, const GScriptValue * scriptValue) {
+		this->memberDataList.push_back(std::unique_ptr<GV8MemberData>(new GV8MemberData(metaClass, name, scriptValue)));
+		return this->memberDataList.back().get();
+	}
+
+private:
+	std::vector<std::unique_ptr<GV8MemberData> > memberDataList;
+};
+
+
 class GObjectTemplateUserData : public GUserData
 {
 public:
@@ -407,6 +447,22 @@ Handle<Value> objectToV8(const GContextPointer & context, const GClassGlueDataPo
 		return Handle<Value>();
 	}
 
+	GScriptObjectCache * scriptObjectCache = context->getScriptObjectCache();
+	GGlueDataWrapper * cachedDataWrapper;
+	std::shared_ptr<Persistent<Object> > * cachedObject = scriptObjectCache->findScriptObject<std::shared_ptr<Persistent<Object> > >(
+		instanceAddress, classData, cv, &cachedDataWrapper);
+	if(cachedObject != nullptr) {
+		if(flags.has(bvfAllowGC)) {
+			// The cached object may not be owned, such as a new object which is returned
+			// at the address of a deleted one, take the ownership as requested.
+			static_cast<GObjectGlueData *>(cachedDataWrapper->getData().get())->setAllowGC(true);
+		}
+		if(outputGlueData != nullptr) {
+			*outputGlueData = cachedDataWrapper->getData();
+		}
+		return Local<Object>::New(getV8Isolate(), *(cachedObject->get()));
+	}
+
 	Handle<FunctionTemplate> functionTemplate = createClassTemplate(context, classData);
 	Handle<Value> external = External::New(getV8Isolate(), &signatureKey);
 	Local<Object> object = functionTemplate->GetFunction()->NewInstance(1, &external);
@@ -418,6 +474,7 @@ Handle<Value> objectToV8(const GContextPointer & context, const GClassGlueDataPo
 	setObjectSignature(&object);
 
 	PersistentObjectWrapper<Object> *self = new PersistentObjectWrapper<Object>(getV8Isolate(), object, dataWrapper);
+	scriptObjectCache->addScriptObject(instanceAddress, classData, cv, dataWrapper, self->getPersistent());
 
 	if(outputGlueData != nullptr) {
 		*outputGlueData = objectData;
@@ -615,7 +672,7 @@ void callbackMethodList(const v8::FunctionCallbackInfo<Value>& args)
 	GMethodGlueDataPointer methodData(methodDataWrapper->getAs<GMethodGlueData>());
 
 	GContextPointer bindingContext(methodData->getBindingContext());
-	InvokeCallableParam callableParam(args.Length(), bindingContext->borrowScriptContext());
+	InvokeCallableParam callableParam(args.Length(), bindingContext.get());
 	loadCallableParam(args, bindingContext, &callableParam);
 
 	InvokeCallableResult result = doInvokeMethodList(bindingContext, objectData, methodData, &callableParam);
@@ -848,7 +905,7 @@ void objectConstructor(const v8::FunctionCallbackInfo<Value> & args)
 		GClassGlueDataPointer classData = dataWrapper->getAs<GClassGlueData>();
 		GContextPointer context = classData->getBindingContext();
 
-		InvokeCallableParam callableParam(args.Length(), context->borrowScriptContext());
+		InvokeCallableParam callableParam(args.Length(), context.get());
 		loadCallableParam(args, context, &callableParam);
 
 		void * instance = doInvokeConstructor(context, context->getService(), classData->getMetaClass(), &callableParam);
@@ -907,93 +964,110 @@ void staticMemberSetter(Local<String> prop, Local<Value> value, const v8::Proper
 	LEAVE_V8()
 }
 
-void namedMemberGetter(Local<String> prop, const v8::PropertyCallbackInfo<Value> & info)
+// The accessor signature guarantees info.This() is an object of the class or a derived class.
+// If the object is of the class declaring the member, the member is used directly,
+// otherwise the instance must be casted to the declaring class, so the member is looked up by name.
+bool isMemberOfObjectClass(const GV8MemberData * memberData, const GGlueDataPointer & glueData)
+{
+	IMetaClass * metaClass = getGlueDataMetaClass(glueData);
+	return metaClass != nullptr && (metaClass == memberData->metaClass.get() || metaClass->equals(memberData->metaClass.get()));
+}
+
+void memberGetter(Local<String> /*prop*/, const v8::PropertyCallbackInfo<Value> & info)
 {
 	ENTER_V8()
 
-	if(!isValidObject(info.Holder())) {
+	const GV8MemberData * memberData = static_cast<GV8MemberData *>(Local<External>::Cast(info.Data())->Value());
+	GGlueDataWrapper * dataWrapper = getNativeObject(info.This());
+	if(dataWrapper == nullptr) {
 		raiseCoreException(Error_ScriptBinding_AccessMemberWithWrongObject);
 	}
 
-	String::Utf8Value utf8_prop(prop);
-	const char * name = *utf8_prop;
+	GGlueDataPointer glueData = dataWrapper->getData();
 
-	GGlueDataWrapper * dataWrapper = getNativeObject(info.Holder());
+	if(isMemberOfObjectClass(memberData, glueData)) {
+		const GScriptValue & scriptValue = *memberData->scriptValue;
+		if(scriptValue.getType() == GScriptValue::typeAccessible) {
+			void * tempInstance;
+			GScopedInterface<IMetaAccessible> accessible(scriptValue.toAccessible(&tempInstance));
+			info.GetReturnValue().Set(accessibleToScript<GV8Methods>(glueData->getBindingContext(), accessible.get(),
+				getGlueDataInstanceAddress(glueData), getGlueDataCV(glueData) == GScriptInstanceCv::sicvConst));
+			return;
+		}
 
-	info.GetReturnValue().Set( getNamedMember(dataWrapper->getData(), name) );
+		if(! memberData->methodTemplate.IsEmpty()) {
+			info.GetReturnValue().Set(Local<FunctionTemplate>::New(getV8Isolate(), memberData->methodTemplate)->GetFunction());
+			return;
+		}
+	}
+
+	info.GetReturnValue().Set(getNamedMember(glueData, memberData->name));
 
 	LEAVE_V8()
 }
 
-void namedMemberSetter(Local<String> prop, Local<Value> value, const v8::PropertyCallbackInfo<Value> & info)
+void memberSetter(Local<String> /*prop*/, Local<Value> value, const v8::PropertyCallbackInfo<void> & info)
 {
 	ENTER_V8()
 
-	String::Utf8Value utf8_prop(prop);
-	const char * name = *utf8_prop;
-
-	if(!isValidObject(info.Holder())) {
+	const GV8MemberData * memberData = static_cast<GV8MemberData *>(Local<External>::Cast(info.Data())->Value());
+	GGlueDataWrapper * dataWrapper = getNativeObject(info.This());
+	if(dataWrapper == nullptr) {
 		raiseCoreException(Error_ScriptBinding_AccessMemberWithWrongObject);
 	}
 
-	GGlueDataWrapper * dataWrapper = getNativeObject(info.Holder());
+	GGlueDataPointer glueData = dataWrapper->getData();
 
-	if(getGlueDataCV(dataWrapper->getData()) == opcvConst) {
+	if(getGlueDataCV(glueData) == GScriptInstanceCv::sicvConst) {
 		raiseCoreException(Error_ScriptBinding_CantWriteToConstObject);
 	}
-	else {
-		GGlueDataPointer valueGlueData;
 
-		GScriptValue v = v8ToScriptValue(dataWrapper->getData()->getBindingContext(), info.Holder()->CreationContext(), value, &valueGlueData);
-		if(setValueOnNamedMember(dataWrapper->getData(), name, v, valueGlueData)) {
-			info.GetReturnValue().Set(value);
-		}
+	GContextPointer context = glueData->getBindingContext();
+	GGlueDataPointer valueGlueData;
+	GScriptValue v = v8ToScriptValue(context, info.This()->CreationContext(), value, &valueGlueData);
+
+	const GScriptValue & scriptValue = *memberData->scriptValue;
+	if(scriptValue.getType() == GScriptValue::typeAccessible && isMemberOfObjectClass(memberData, glueData)) {
+		void * tempInstance;
+		GScopedInterface<IMetaAccessible> accessible(scriptValue.toAccessible(&tempInstance));
+		doSetValueOnAccessible(context, accessible.get(), glueData, v.getValue(), valueGlueData);
+	}
+	else {
+		// Assigning to a method stores the value in the script data of the object,
+		// so a script function can override a virtual method.
+		setValueOnNamedMember(glueData, memberData->name, v, valueGlueData);
 	}
 
 	LEAVE_V8()
 }
 
-void namedMemberEnumerator(const v8::PropertyCallbackInfo<Array> & info)
+// Install all members of the class, not including the base classes, as accessors on the prototype template.
+// The base class members are found through the prototype chain set up by Inherit.
+// So V8 can cache the member lookup, which a named property interceptor on the instance template prevents.
+void bindClassMembers(const GContextPointer & context, const GClassGlueDataPointer & classData,
+	Handle<FunctionTemplate> functionTemplate, GClassTemplateUserData * userData)
 {
-	ENTER_V8()
-
-	if(!isValidObject(info.Holder())) {
-		raiseCoreException(Error_ScriptBinding_AccessMemberWithWrongObject);
+	GMetaMapClass * mapClass = classData->getClassMap();
+	if(mapClass == nullptr) {
+		return;
 	}
 
-	GGlueDataWrapper * dataWrapper = getNativeObject(info.Holder());
-	GGlueDataPointer glueData = dataWrapper->getData();
-
-	GMetaClassTraveller traveller(getGlueDataMetaClass(glueData), getGlueDataInstanceAddress(glueData));
-	GStringMap<bool, GStringMapReuseKey> nameMap;
-	GScopedInterface<IMetaItem> metaItem;
+	Local<ObjectTemplate> prototypeTemplate = functionTemplate->PrototypeTemplate();
+	Local<AccessorSignature> signature = AccessorSignature::New(getV8Isolate(), functionTemplate);
 
-	for(;;) {
-		GScopedInterface<IMetaClass> metaClass(traveller.next(nullptr, nullptr));
-
-		if(!metaClass) {
-			break;
-		}
+	const GMetaMapClass::MapType * itemMap = mapClass->getMap();
+	for(GMetaMapClass::MapType::const_iterator it = itemMap->begin(); it != itemMap->end(); ++it) {
+		const GScriptValue & scriptValue = it->second.getScriptValue();
+		GV8MemberData * memberData = userData->addMemberData(classData->getMetaClass(), it->first, &scriptValue);
 
-		uint32_t metaCount = metaClass->getMetaCount();
-		for(uint32_t i = 0; i < metaCount; ++i) {
-			metaItem.reset(metaClass->getMetaAt(i));
-			nameMap.set(metaItem->getName(), true);
+		if(scriptValue.getType() == GScriptValue::typeMethod || scriptValue.getType() == GScriptValue::typeOverloadedMethods) {
+			GScopedInterface<IMetaList> methodList(createMethodListFromScriptValue(scriptValue));
+			memberData->methodTemplate.Reset(getV8Isolate(), createMethodTemplate(context, classData, false, methodList.get(), functionTemplate));
 		}
-	}
-
-	HandleScope handleScope(getV8Isolate());
 
-	Local<Array> metaNames = Array::New(getV8Isolate(), nameMap.getCount());
-	int i = 0;
-	for(GStringMap<bool, GStringMapReuseKey>::iterator it = nameMap.begin(); it != nameMap.end(); ++it) {
-		metaNames->Set(Number::New(getV8Isolate(), i), String::NewFromOneByte(getV8Isolate(), (const unsigned char*)it->first));
-		++i;
+		prototypeTemplate->SetAccessor(String::NewFromOneByte(getV8Isolate(), (const unsigned char*)it->first),
+			&memberGetter, &memberSetter, External::New(getV8Isolate(), memberData), DEFAULT, None, signature);
 	}
-
-	info.GetReturnValue().Set( metaNames );
-
-	LEAVE_V8()
 }
 
 void bindClassItems(Local<Object> object, IMetaClass * metaClass, Persistent<External> & objectData)
@@ -1041,13 +1115,14 @@ Handle<FunctionTemplate> createClassTemplate(const GContextPointer & context, co
 	functionTemplate->SetHiddenPrototype(true);
 
 	if(mapClass->getUserData() == nullptr) {
-		mapClass->setUserData(new GFunctionTemplateUserData(functionTemplate));
+		mapClass->setUserData(new GClassTemplateUserData(functionTemplate));
 	}
+	GClassTemplateUserData * userData = gdynamic_cast<GClassTemplateUserData *>(mapClass->getUserData());
 
 	Local<ObjectTemplate> instanceTemplate = functionTemplate->InstanceTemplate();
 	instanceTemplate->SetInternalFieldCount(1);
 
-	instanceTemplate->SetNamedPropertyHandler(&namedMemberGetter, &namedMemberSetter, nullptr, nullptr, &namedMemberEnumerator);
+	bindClassMembers(context, classData, functionTemplate, userData);
 
 	if(metaClass->getBaseCount() > 0) {
 		GScopedInterface<IMetaClass> baseClass(metaClass->getBaseClass(0));
@@ -1404,7 +1479,7 @@ GScriptValue GV8ScriptObject::getAsScriptArray(const char * name)
 	return v8GetAsScriptArray(this->getBindingContext(), String::NewFromOneByte(getV8Isolate(), (const unsigned char*)name), localObject);
 }
 
-GScriptValue GV8ScriptObject::createScriptArray(const char * name)
+GScriptValue GV8ScriptObject::createScriptArray(const char * name, size_t /*reserveLength*/)
 {
 	HandleScope handleScope(getV8Isolate());
 	Local<Object> localObject(Local<Object>::New(getV8Isolate(), this->object));
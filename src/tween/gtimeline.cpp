@@ -36,7 +36,7 @@ GTweenNumber GTimeline::getDuration() const
 	if(this->durationTime < 0) {
 		this->durationTime = 0;
 		for(ListType::const_iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-			if(it->hasAddedToTimeline()) {
+			if(! it->isRemoved() && it->hasAddedToTimeline()) {
 				GTweenNumber t = it->startTime + it->tweenable->getTotalDuration() + it->tweenable->getDelay();
 				if(t > this->durationTime) {
 					this->durationTime = t;
@@ -51,13 +51,10 @@ GTweenNumber GTimeline::getDuration() const
 GTweenNumber GTimeline::append(const GTweenable & tweenable)
 {
 	GTweenNumber duration = 0;
-	TweenableData * data = nullptr;
+	TweenableData * data = this->findTweenableData(tweenable);
 	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		if(it->tweenable == &tweenable) {
-			data = &*it;
-		}
-		else {
-			if(it->hasAddedToTimeline()) {
+		if(it->tweenable != &tweenable) {
+			if(! it->isRemoved() && it->hasAddedToTimeline()) {
 				GTweenNumber t = it->startTime + it->tweenable->getTotalDuration() + it->tweenable->getDelay();
 				if(t > duration) {
 					duration = t;
@@ -80,13 +77,7 @@ GTweenNumber GTimeline::append(const GTweenable & tweenable)
 
 void GTimeline::prepend(const GTweenable & tweenable)
 {
-	TweenableData * data = nullptr;
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		if(it->tweenable == &tweenable) {
-			data = &*it;
-			break;
-		}
-	}
+	TweenableData * data = this->findTweenableData(tweenable);
 
 	if(data == nullptr) {
 		raiseCoreException(Error_Tween_TweenableNotOwnedByTimeline);
@@ -94,7 +85,7 @@ void GTimeline::prepend(const GTweenable & tweenable)
 
 	GTweenNumber duration = tweenable.getTotalDuration() + tweenable.getDelay();
 	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		if(it->tweenable != &tweenable && it->hasAddedToTimeline()) {
+		if(it->tweenable != &tweenable && ! it->isRemoved() && it->hasAddedToTimeline()) {
 			it->startTime += duration;
 		}
 	}
@@ -107,13 +98,7 @@ void GTimeline::prepend(const GTweenable & tweenable)
 
 void GTimeline::insert(GTweenNumber time, const GTweenable & tweenable)
 {
-	TweenableData * data = nullptr;
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		if(it->tweenable == &tweenable) {
-			data = &*it;
-			break;
-		}
-	}
+	TweenableData * data = this->findTweenableData(tweenable);
 
 	if(data == nullptr) {
 		raiseCoreException(Error_Tween_TweenableNotOwnedByTimeline);
@@ -121,7 +106,7 @@ void GTimeline::insert(GTweenNumber time, const GTweenable & tweenable)
 
 	GTweenNumber minStartTime = -1.0f;
 	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		if(it->tweenable != &tweenable && it->hasAddedToTimeline()) {
+		if(it->tweenable != &tweenable && ! it->isRemoved() && it->hasAddedToTimeline()) {
 			if(it->startTime >= time) {
 				if(minStartTime < 0 || it->startTime < minStartTime) {
 					minStartTime = it->startTime;
@@ -133,7 +118,7 @@ void GTimeline::insert(GTweenNumber time, const GTweenable & tweenable)
 		GTweenNumber duration = tweenable.getTotalDuration() + tweenable.getDelay();
 		GTweenNumber deltaTime = duration - (minStartTime - time);
 		for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-			if(it->tweenable != &tweenable && it->hasAddedToTimeline()) {
+			if(it->tweenable != &tweenable && ! it->isRemoved() && it->hasAddedToTimeline()) {
 				if(it->startTime >= time) {
 					it->startTime += deltaTime;
 				}
@@ -149,33 +134,30 @@ void GTimeline::insert(GTweenNumber time, const GTweenable & tweenable)
 
 void GTimeline::setAt(GTweenNumber time, const GTweenable & tweenable)
 {
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		if(it->tweenable == &tweenable) {
-			it->startTime = time;
-			it->addToTimeline();
-			this->invalidDurationTime();
-			return;
-		}
+	TweenableData * data = this->findTweenableData(tweenable);
+	if(data == nullptr) {
+		raiseCoreException(Error_Tween_TweenableNotOwnedByTimeline);
 	}
 
-	raiseCoreException(Error_Tween_TweenableNotOwnedByTimeline);
+	data->startTime = time;
+	data->addToTimeline();
+	this->invalidDurationTime();
 }
 
 GTweenNumber GTimeline::getStartTime(const GTweenable & tweenable)
 {
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		if(it->tweenable == &tweenable) {
-			return it->startTime;
-		}
+	TweenableData * data = this->findTweenableData(tweenable);
+	if(data == nullptr) {
+		raiseCoreException(Error_Tween_TweenableNotOwnedByTimeline);
+		return 0;
 	}
 
-	raiseCoreException(Error_Tween_TweenableNotOwnedByTimeline);
-	
-	return 0;
+	return data->startTime;
 }
 
 void GTimeline::performTime(GTweenNumber elapsed, GTweenNumber frameDuration, bool forceReversed, bool forceUseFrames)
 {
+	this->compact();
 	this->getDuration();
 
 	bool shouldFinish = false;
@@ -215,7 +197,7 @@ void GTimeline::performTime(GTweenNumber elapsed, GTweenNumber frameDuration, bo
 					}
 					
 					if(this->callbackOnRepeat) {
-						this->callbackOnRepeat();
+						this->invokeCallback(this->callbackOnRepeat);
 					}
 				}
 			}
@@ -238,7 +220,12 @@ void GTimeline::performTime(GTweenNumber elapsed, GTweenNumber frameDuration, bo
 		if(useFrames && frameDuration > 0) {
 			frameDuration = 1.0f;
 		}
-		for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
+		// Index the slots, the callbacks may add tweenables to the timeline.
+		for(size_t i = 0; i < this->tweenList.size(); ++i) {
+			ListType::iterator it = this->tweenList.begin() + i;
+			if(it->isRemoved()) {
+				continue;
+			}
 			if(shouldRestart) {
 				it->tweenable->restart();
 			}
@@ -259,7 +246,7 @@ void GTimeline::performTime(GTweenNumber elapsed, GTweenNumber frameDuration, bo
 		}
 		
 		if(this->callbackOnUpdate) {
-			this->callbackOnUpdate();
+			this->invokeCallback(this->callbackOnUpdate);
 		}
 	}
 	
@@ -1,4 +1,5 @@
 #include "cpgf/tween/gtween.h"
+#include "cpgf/tween/gtweenlist.h"
 #include "cpgf/tween/easing/linear.h"
 
 #include <cmath>
@@ -13,9 +14,9 @@ void GTweenItem::deleteSelf()
 	this->virtualFunctions->deleteSelf(this);
 }
 
-void GTweenItem::tick(GTweenEaseParam * param, const GTweenEaseType & ease)
+void GTweenItem::tick(GTweenNumber ratio)
 {
-	this->virtualFunctions->tick(this, param, ease);
+	this->virtualFunctions->tick(this, ratio);
 }
 
 void GTweenItem::init()
@@ -50,6 +51,10 @@ GTweenNumber GTween::getDuration() const
 
 void GTween::removeForInstance(const void * instance)
 {
+	if(this->ownerList != nullptr) {
+		this->ownerList->removeInstanceIndex(instance, this);
+	}
+
 	for(ListType::iterator it = this->itemList.begin(); it != this->itemList.end();) {
 		if((*it)->getInstance() == instance) {
 			(*it)->deleteSelf();
@@ -64,6 +69,15 @@ void GTween::removeForInstance(const void * instance)
 	}
 }
 
+void GTween::addItem(tween_internal::GTweenItem * item)
+{
+	this->itemList.push_back(item);
+
+	if(this->ownerList != nullptr) {
+		this->ownerList->addInstanceIndex(item->getInstance(), this);
+	}
+}
+
 void GTween::performTime(GTweenNumber elapsed, GTweenNumber /*frameDuration*/, bool forceReversed, bool /*forceUseFrames*/)
 {
 	bool shouldFinish = false;
@@ -108,7 +122,7 @@ void GTween::performTime(GTweenNumber elapsed, GTweenNumber /*frameDuration*/, b
 					}
 					
 					if(this->callbackOnRepeat) {
-						this->callbackOnRepeat();
+						this->invokeCallback(this->callbackOnRepeat);
 					}
 				}
 			}
@@ -133,12 +147,15 @@ void GTween::performTime(GTweenNumber elapsed, GTweenNumber /*frameDuration*/, b
 			param.current = 1.0f;
 			param.total = 1.0f;
 		}
+
+		// The ease is evaluated once, all the items share the ratio.
+		const GTweenNumber ratio = this->easeCallback(&param);
 		for(ListType::iterator it = this->itemList.begin(); it != this->itemList.end(); ++it) {
-			(*it)->tick(&param, this->easeCallback);
+			(*it)->tick(ratio);
 		}
 		
 		if(this->callbackOnUpdate) {
-			this->callbackOnUpdate();
+			this->invokeCallback(this->callbackOnUpdate);
 		}
 	}
 	
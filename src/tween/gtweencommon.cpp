@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 using namespace std;
 
@@ -10,15 +11,30 @@ namespace cpgf {
 
 const GTweenNumber invalidPreviousAppliedTime = -1.0f;
 
+namespace tween_internal {
+
+// Set by GTweenScheduler while it ticks a list in parallel.
+thread_local std::vector<GTweenCallback> * deferredCallbackList = nullptr;
+
+std::vector<GTweenCallback> * setDeferredCallbackList(std::vector<GTweenCallback> * callbackList)
+{
+	std::vector<GTweenCallback> * previous = deferredCallbackList;
+	deferredCallbackList = callbackList;
+	return previous;
+}
+
+} // namespace tween_internal
+
 GTweenable::GTweenable()
-	: elapsedTime(0), delayTime(0), repeatDelayTime(0), repeatCount(0), cycleCount(0), timeScaleTime(1.0f), flags(), previousAppliedTime(invalidPreviousAppliedTime)
+	: elapsedTime(0), delayTime(0), repeatDelayTime(0), repeatCount(0), cycleCount(0), timeScaleTime(1.0f), flags(), previousAppliedTime(invalidPreviousAppliedTime),
+		ownerList(nullptr), ownerSlot(0)
 {
 }
 
 GTweenable::~GTweenable()
 {
 	if(this->callbackOnDestroy) {
-		this->callbackOnDestroy();
+		this->invokeCallback(this->callbackOnDestroy);
 	}
 }
 
@@ -78,7 +94,17 @@ void GTweenable::doComplete(bool emitEvent)
 	this->elapsedTime = this->getTotalDuration() + this->delayTime;
 
 	if(emitEvent && this->callbackOnComplete) {
-		this->callbackOnComplete();
+		this->invokeCallback(this->callbackOnComplete);
+	}
+}
+
+void GTweenable::invokeCallback(const GTweenCallback & callback)
+{
+	if(tween_internal::deferredCallbackList != nullptr) {
+		tween_internal::deferredCallbackList->push_back(callback);
+	}
+	else {
+		callback();
 	}
 }
 
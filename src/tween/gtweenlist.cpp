@@ -2,6 +2,8 @@
 #include "cpgf/tween/gtimeline.h"
 
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 namespace cpgf {
 
@@ -28,6 +30,11 @@ void GTweenList::TweenableData::addToTimeline()
 	this->flags.set(TweenDataFlag_hasAddedToTimeline);
 }
 
+bool GTweenList::TweenableData::isRemoved() const
+{
+	return this->tweenable == nullptr;
+}
+
 
 GTweenList * GTweenList::getInstance()
 {
@@ -41,6 +48,7 @@ GTweenList * GTweenList::getInstance()
 }
 
 GTweenList::GTweenList()
+	: removedCount(0), parallel(false)
 {
 }
 
@@ -52,11 +60,8 @@ GTweenList::~GTweenList()
 GTween & GTweenList::tween()
 {
 	GTween * tweenable = this->tweenPool.allocate();
-	TweenableData data(false);
-	data.startTime = 0;
-	data.tweenable = tweenable;
 	tweenable->useFrames(this->isUseFrames());
-	this->tweenList.push_back(data);
+	this->addTweenable(tweenable, false);
 	return *tweenable;
 }
 
@@ -66,38 +71,55 @@ GTimeline & GTweenList::timeline()
 		this->timelinePool.reset(new GObjectPool<GTimeline>());
 	}
 	GTimeline * newTimeline = this->timelinePool->allocate();
-	TweenableData data(true);
-	data.startTime = 0;
-	data.tweenable = newTimeline;
 	newTimeline->useFrames(this->isUseFrames());
-	this->tweenList.push_back(data);
+	this->addTweenable(newTimeline, true);
+	this->timelineList.push_back(newTimeline);
 	return *newTimeline;
 }
 
+void GTweenList::addTweenable(GTweenable * tweenable, bool isTimeline)
+{
+	TweenableData data(isTimeline);
+	data.startTime = 0;
+	data.tweenable = tweenable;
+	tweenable->ownerList = this;
+	tweenable->ownerSlot = this->tweenList.size();
+	this->tweenList.push_back(data);
+}
+
 void GTweenList::performTime(GTweenNumber /*elapsed*/, GTweenNumber frameDuration, bool /*forceReversed*/, bool /*forceUseFrames*/)
 {
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end();) {
-		it->tweenable->tick(frameDuration);
-		if(it->tweenable->isCompleted()) {
-			this->freeTween(it->tweenable, it->isTimeline());
-			it = this->tweenList.erase(it);
+	// The callbacks may add or remove tweenables, so don't hold references to the slots.
+	// The live slots are compacted in the same pass.
+	size_t liveCount = 0;
+	size_t compactedCount = 0;
+	for(size_t i = 0; i < this->tweenList.size(); ++i) {
+		if(! this->tweenList[i].isRemoved()) {
+			this->tweenList[i].tweenable->tick(frameDuration);
+			if(! this->tweenList[i].isRemoved() && this->tweenList[i].tweenable->isCompleted()) {
+				this->removeAt(i);
+			}
+		}
+
+		if(this->tweenList[i].isRemoved()) {
+			++compactedCount;
 		}
 		else {
-			++it;
+			if(liveCount != i) {
+				this->tweenList[liveCount] = this->tweenList[i];
+				this->tweenList[liveCount].tweenable->ownerSlot = liveCount;
+			}
+			++liveCount;
 		}
 	}
+	this->tweenList.erase(this->tweenList.begin() + liveCount, this->tweenList.end());
+	this->removedCount -= compactedCount;
 }
 
 void GTweenList::remove(const GTweenable & tweenable)
 {
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end();) {
-		if(it->tweenable == &tweenable) {
-			this->freeTween(it->tweenable, it->isTimeline());
-			it = this->tweenList.erase(it);
-		}
-		else {
-			++it;
-		}
+	if(this->findTweenableData(tweenable) != nullptr) {
+		this->removeAt(tweenable.ownerSlot);
 	}
 }
 
@@ -108,14 +130,30 @@ GTweenNumber GTweenList::getDuration() const
 
 void GTweenList::removeForInstance(const void * instance)
 {
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end();) {
-		it->tweenable->removeForInstance(instance);
-		if(it->tweenable->isCompleted()) {
-			this->freeTween(it->tweenable, it->isTimeline());
-			it = this->tweenList.erase(it);
+	InstanceMapType::iterator mapIt = this->instanceMap.find(instance);
+	if(mapIt != this->instanceMap.end()) {
+		std::vector<GTween *> tweens;
+		tweens.swap(mapIt->second);
+		this->instanceMap.erase(mapIt);
+
+		// A tween having several items of the instance may be listed more than once.
+		std::sort(tweens.begin(), tweens.end());
+		tweens.erase(std::unique(tweens.begin(), tweens.end()), tweens.end());
+
+		for(GTween * tween : tweens) {
+			tween->removeForInstance(instance);
+			if(tween->isCompleted()) {
+				this->removeAt(tween->ownerSlot);
+			}
 		}
-		else {
-			++it;
+	}
+
+	// Copy the list because removeAt changes it.
+	const std::vector<GTimeline *> timelines(this->timelineList);
+	for(GTimeline * timeline : timelines) {
+		timeline->removeForInstance(instance);
+		if(timeline->isCompleted()) {
+			this->removeAt(timeline->ownerSlot);
 		}
 	}
 }
@@ -123,28 +161,101 @@ void GTweenList::removeForInstance(const void * instance)
 void GTweenList::doRestartChildren()
 {
 	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		it->tweenable->restart();
+		if(! it->isRemoved()) {
+			it->tweenable->restart();
+		}
 	}
 }
 
 void GTweenList::doRestartChildrenWithDelay()
 {
 	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		it->tweenable->restartWithDelay();
+		if(! it->isRemoved()) {
+			it->tweenable->restartWithDelay();
+		}
 	}
 }
 
+GTweenList & GTweenList::tickInParallel(bool value)
+{
+	this->parallel = value;
+
+	return *this;
+}
+
+bool GTweenList::isTickInParallel() const
+{
+	return this->parallel;
+}
+
 size_t GTweenList::getTweenableCount() const
 {
-	return this->tweenList.size();
+	return this->tweenList.size() - this->removedCount;
 }
 
 void GTweenList::clear()
 {
-	for(ListType::iterator it = this->tweenList.begin(); it != this->tweenList.end(); ++it) {
-		this->freeTween(it->tweenable, it->isTimeline());
+	ListType tweens;
+	tweens.swap(this->tweenList);
+	this->removedCount = 0;
+	this->instanceMap.clear();
+	this->timelineList.clear();
+
+	for(ListType::iterator it = tweens.begin(); it != tweens.end(); ++it) {
+		if(! it->isRemoved()) {
+			it->tweenable->ownerList = nullptr;
+			this->freeTween(it->tweenable, it->isTimeline());
+		}
+	}
+}
+
+void GTweenList::removeAt(size_t slot)
+{
+	TweenableData & data = this->tweenList[slot];
+	GTweenable * tweenable = data.tweenable;
+	const bool isTimeline = data.isTimeline();
+
+	data.tweenable = nullptr;
+	++this->removedCount;
+
+	if(isTimeline) {
+		this->timelineList.erase(std::find(this->timelineList.begin(), this->timelineList.end(), tweenable));
 	}
-	this->tweenList.clear();
+	else {
+		this->removeAllInstanceIndex(static_cast<GTween *>(tweenable));
+	}
+
+	tweenable->ownerList = nullptr;
+	this->freeTween(tweenable, isTimeline);
+}
+
+void GTweenList::compact()
+{
+	if(this->removedCount == 0) {
+		return;
+	}
+
+	size_t liveCount = 0;
+	for(size_t i = 0; i < this->tweenList.size(); ++i) {
+		if(! this->tweenList[i].isRemoved()) {
+			if(liveCount != i) {
+				this->tweenList[liveCount] = this->tweenList[i];
+				this->tweenList[liveCount].tweenable->ownerSlot = liveCount;
+			}
+			++liveCount;
+		}
+	}
+	this->tweenList.erase(this->tweenList.begin() + liveCount, this->tweenList.end());
+	this->removedCount = 0;
+}
+
+GTweenList::TweenableData * GTweenList::findTweenableData(const GTweenable & tweenable)
+{
+	if(tweenable.ownerList != this) {
+		return nullptr;
+	}
+
+	return &this->tweenList[tweenable.ownerSlot];
 }
 
 void GTweenList::freeTween(GTweenable * tweenable, bool isTimeline)
@@ -157,6 +268,46 @@ void GTweenList::freeTween(GTweenable * tweenable, bool isTimeline)
 	}
 }
 
+void GTweenList::addInstanceIndex(const void * instance, GTween * tween)
+{
+	if(instance == nullptr) {
+		return;
+	}
 
-} // namespace cpgf
+	std::vector<GTween *> & tweens = this->instanceMap[instance];
+	// The items of a tween are usually added together.
+	if(tweens.empty() || tweens.back() != tween) {
+		tweens.push_back(tween);
+	}
+}
+
+void GTweenList::removeInstanceIndex(const void * instance, GTween * tween)
+{
+	InstanceMapType::iterator mapIt = this->instanceMap.find(instance);
+	if(mapIt == this->instanceMap.end()) {
+		return;
+	}
+
+	std::vector<GTween *> & tweens = mapIt->second;
+	tweens.erase(std::remove(tweens.begin(), tweens.end(), tween), tweens.end());
+	if(tweens.empty()) {
+		this->instanceMap.erase(mapIt);
+	}
+}
+
+void GTweenList::removeAllInstanceIndex(GTween * tween)
+{
+	if(this->instanceMap.empty()) {
+		return;
+	}
+
+	for(tween_internal::GTweenItem * item : tween->itemList) {
+		const void * instance = item->getInstance();
+		if(instance != nullptr) {
+			this->removeInstanceIndex(instance, tween);
+		}
+	}
+}
 
+
+} // namespace cpgf
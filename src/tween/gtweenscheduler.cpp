@@ -0,0 +1,235 @@
+#include "cpgf/tween/gtweenscheduler.h"
+#include "cpgf/tween/gtweenlist.h"
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+
+namespace cpgf {
+
+namespace tween_internal {
+
+std::vector<GTweenCallback> * setDeferredCallbackList(std::vector<GTweenCallback> * callbackList);
+
+} // namespace tween_internal
+
+
+class GTweenSchedulerImplement
+{
+private:
+	struct Job
+	{
+		GTweenList * tweenList;
+		std::vector<GTweenCallback> callbackList;
+	};
+
+public:
+	explicit GTweenSchedulerImplement(int threadCount);
+	~GTweenSchedulerImplement();
+
+	void add(GTweenList * tweenList);
+	void remove(GTweenList * tweenList);
+
+	void tick(GTweenNumber frameDuration);
+
+	size_t getThreadCount() const;
+
+private:
+	void workerMain();
+	void runJobs();
+
+private:
+	std::vector<GTweenList *> tweenListList;
+
+	std::vector<Job> jobList;
+	size_t jobCount;
+	std::atomic<size_t> nextJobIndex;
+	GTweenNumber frameDuration;
+
+	std::vector<std::thread> threadList;
+	std::mutex mutex;
+	std::condition_variable workCondition;
+	std::condition_variable doneCondition;
+	unsigned int generation;
+	size_t busyThreadCount;
+	bool stopping;
+};
+
+
+GTweenSchedulerImplement::GTweenSchedulerImplement(int threadCount)
+	: tweenListList(), jobList(), jobCount(0), nextJobIndex(0), frameDuration(0),
+		threadList(), mutex(), workCondition(), doneCondition(), generation(0), busyThreadCount(0), stopping(false)
+{
+	if(threadCount < 0) {
+		threadCount = (int)std::thread::hardware_concurrency() - 1;
+	}
+
+	for(int i = 0; i < threadCount; ++i) {
+		this->threadList.push_back(std::thread(&GTweenSchedulerImplement::workerMain, this));
+	}
+}
+
+GTweenSchedulerImplement::~GTweenSchedulerImplement()
+{
+	{
+		std::lock_guard<std::mutex> lockGuard(this->mutex);
+		this->stopping = true;
+	}
+	this->workCondition.notify_all();
+
+	for(std::thread & thread : this->threadList) {
+		thread.join();
+	}
+}
+
+void GTweenSchedulerImplement::add(GTweenList * tweenList)
+{
+	this->tweenListList.push_back(tweenList);
+}
+
+void GTweenSchedulerImplement::remove(GTweenList * tweenList)
+{
+	this->tweenListList.erase(std::remove(this->tweenListList.begin(), this->tweenListList.end(), tweenList), this->tweenListList.end());
+}
+
+void GTweenSchedulerImplement::tick(GTweenNumber frameDuration)
+{
+	// Copy the pointers, the callbacks may add or remove lists.
+	const std::vector<GTweenList *> tweenLists(this->tweenListList);
+
+	this->jobCount = 0;
+	for(GTweenList * tweenList : tweenLists) {
+		if(tweenList->isTickInParallel()) {
+			// The jobs are reused to keep the memory of the callback lists.
+			if(this->jobCount == this->jobList.size()) {
+				this->jobList.push_back(Job());
+			}
+			this->jobList[this->jobCount].tweenList = tweenList;
+			++this->jobCount;
+		}
+		else {
+			tweenList->tick(frameDuration);
+		}
+	}
+
+	if(this->jobCount == 0) {
+		return;
+	}
+
+	this->frameDuration = frameDuration;
+	this->nextJobIndex = 0;
+
+	if(this->threadList.empty() || this->jobCount == 1) {
+		this->runJobs();
+	}
+	else {
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+			this->busyThreadCount = this->threadList.size();
+			++this->generation;
+		}
+		this->workCondition.notify_all();
+
+		this->runJobs();
+
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->doneCondition.wait(lock, [this]() { return this->busyThreadCount == 0; });
+	}
+
+	// Copy the callbacks out of the jobs, a callback may tick the scheduler again.
+	std::vector<GTweenCallback> callbackList;
+	for(size_t i = 0; i < this->jobCount; ++i) {
+		std::vector<GTweenCallback> & jobCallbackList = this->jobList[i].callbackList;
+		callbackList.insert(callbackList.end(), jobCallbackList.begin(), jobCallbackList.end());
+		jobCallbackList.clear();
+	}
+
+	for(const GTweenCallback & callback : callbackList) {
+		callback();
+	}
+}
+
+size_t GTweenSchedulerImplement::getThreadCount() const
+{
+	return this->threadList.size();
+}
+
+void GTweenSchedulerImplement::workerMain()
+{
+	unsigned int doneGeneration = 0;
+
+	for(;;) {
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->workCondition.wait(lock, [this, doneGeneration]() {
+				return this->stopping || this->generation != doneGeneration;
+			});
+
+			if(this->stopping) {
+				return;
+			}
+
+			doneGeneration = this->generation;
+		}
+
+		this->runJobs();
+
+		{
+			std::lock_guard<std::mutex> lockGuard(this->mutex);
+			--this->busyThreadCount;
+		}
+		this->doneCondition.notify_one();
+	}
+}
+
+void GTweenSchedulerImplement::runJobs()
+{
+	for(;;) {
+		const size_t index = this->nextJobIndex++;
+		if(index >= this->jobCount) {
+			break;
+		}
+
+		Job & job = this->jobList[index];
+		std::vector<GTweenCallback> * previous = tween_internal::setDeferredCallbackList(&job.callbackList);
+		job.tweenList->tick(this->frameDuration);
+		tween_internal::setDeferredCallbackList(previous);
+	}
+}
+
+
+GTweenScheduler::GTweenScheduler(int threadCount)
+	: implement(new GTweenSchedulerImplement(threadCount))
+{
+}
+
+GTweenScheduler::~GTweenScheduler()
+{
+}
+
+void GTweenScheduler::add(GTweenList * tweenList)
+{
+	this->implement->add(tweenList);
+}
+
+void GTweenScheduler::remove(GTweenList * tweenList)
+{
+	this->implement->remove(tweenList);
+}
+
+void GTweenScheduler::tick(GTweenNumber frameDuration)
+{
+	this->implement->tick(frameDuration);
+}
+
+size_t GTweenScheduler::getThreadCount() const
+{
+	return this->implement->getThreadCount();
+}
+
+
+} // namespace cpgf
@@ -0,0 +1,163 @@
+#include "test_callback_common.h"
+
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+
+using namespace cpgf;
+
+namespace {
+
+// Counts how many times the callable is copied or moved, so the tests can
+// tell whether a callback move steals the heap storage or relocates the callable.
+int relocationCount = 0;
+
+struct LargeCapture
+{
+	long long values[5];
+
+	LargeCapture() : values{ 1, 2, 3, 4, 5 } {
+	}
+
+	LargeCapture(const LargeCapture & other) {
+		++relocationCount;
+		std::copy(other.values, other.values + 5, this->values);
+	}
+
+	LargeCapture(LargeCapture && other) {
+		++relocationCount;
+		std::copy(other.values, other.values + 5, this->values);
+	}
+
+	int operator() (int n) const {
+		return (int)(this->values[0] + this->values[1] + this->values[2] + this->values[3] + this->values[4]) + n;
+	}
+};
+
+struct alignas(64) OverAligned
+{
+	int value;
+
+	int operator() (int n) const {
+		return this->value + n;
+	}
+};
+
+struct CapacityObject
+{
+	int value;
+
+	int getValue(int n) {
+		return this->value + n;
+	}
+};
+
+struct UniqueValueGetter
+{
+	std::unique_ptr<int> value;
+
+	int operator() () const {
+		return *this->value;
+	}
+};
+
+int addOne(int n)
+{
+	return n + 1;
+}
+
+GTEST(Callback_Capacity_InlineByDefault)
+{
+	CapacityObject object = { 5 };
+
+	GCallback<int (int)> cb1(&addOne);
+	GCallback<int (int)> cb2(&object, &CapacityObject::getValue);
+	GCallback<int (int)> cb3 = [](int n) { return n * 2; };
+	GCallback<int (int)> cb4(cb2);
+
+	GCHECK(! cb1.isOnHeap());
+	GCHECK(! cb2.isOnHeap());
+	GCHECK(! cb3.isOnHeap());
+	GCHECK(! cb4.isOnHeap());
+	GEQUAL(3, cb1(2));
+	GEQUAL(7, cb2(2));
+	GEQUAL(4, cb3(2));
+	GEQUAL(7, cb4(2));
+	GCHECK(cb2 == cb4);
+}
+
+GTEST(Callback_Capacity_LargeCapture)
+{
+	LargeCapture func;
+
+	GCallback<int (int)> small(func);
+	GCHECK(small.isOnHeap());
+	GEQUAL(16, small(1));
+
+	GCallback<int (int), 64> large(func);
+	GCHECK(! large.isOnHeap());
+	GEQUAL(16, large(1));
+
+	// Moving a callback on heap steals the memory, the callable is not relocated.
+	relocationCount = 0;
+	GCallback<int (int)> moved(std::move(small));
+	GEQUAL(0, relocationCount);
+	GCHECK(small.empty());
+	GCHECK(moved.isOnHeap());
+	GEQUAL(16, moved(1));
+
+	// A callable in the inline buffer has to be moved.
+	relocationCount = 0;
+	GCallback<int (int), 64> movedLarge(std::move(large));
+	GEQUAL(1, relocationCount);
+	GCHECK(large.empty());
+	GCHECK(! movedLarge.isOnHeap());
+	GEQUAL(16, movedLarge(1));
+}
+
+GTEST(Callback_Capacity_OverAligned)
+{
+	OverAligned func = { 5 };
+
+	GCallback<int (int)> cb(func);
+	GCallback<int (int), 256> large(func);
+	// The inline buffer is only aligned for pointers, so over-aligned callables always go to heap.
+	GCHECK(cb.isOnHeap());
+	GCHECK(large.isOnHeap());
+	GEQUAL(6, cb(1));
+	GEQUAL(6, large(1));
+
+	GCallback<int (int)> copied(cb);
+	GEQUAL(7, copied(2));
+
+	// Both copies must keep the alignment of the callable.
+	GCallback<int (int)> lambda = [func](int n) {
+		GEQUAL(0u, (unsigned int)(reinterpret_cast<std::uintptr_t>(&func) % alignof(OverAligned)));
+		return func(n);
+	};
+	GCallback<int (int)> lambdaCopy(lambda);
+	GEQUAL(8, lambda(3));
+	GEQUAL(8, lambdaCopy(3));
+}
+
+GTEST(Callback_Capacity_MoveOnly)
+{
+	UniqueValueGetter getter = { std::unique_ptr<int>(new int(38)) };
+	GMoveOnlyCallback<int ()> cb(std::move(getter));
+	GCHECK(! cb.isOnHeap());
+	GEQUAL(38, cb());
+
+	GMoveOnlyCallback<int ()> other(std::move(cb));
+	GCHECK(! cb);
+	GEQUAL(38, other());
+
+	CapacityObject object = { 5 };
+	GMoveOnlyCallback<int (int)> member(&object, &CapacityObject::getValue);
+	GEQUAL(6, member(1));
+
+	member = GMoveOnlyCallback<int (int)>(&addOne);
+	GEQUAL(2, member(1));
+}
+
+
+}
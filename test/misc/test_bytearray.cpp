@@ -2,6 +2,7 @@
 
 #include "cpgf/metautility/gmetabytearray.h"
 #include "cpgf/gvariant.h"
+#include "cpgf/gexception.h"
 
 #include <memory>
 
@@ -113,6 +114,35 @@ GTEST(TestByteArray)
     testByteArray(byteArray.get());
 }
 
+GTEST(TestByteArrayBufferExport)
+{
+	GMetaByteArray byteArray(8);
+
+	byteArray.addBufferExport();
+	GEQUAL(byteArray.getBufferExportCount(), 1);
+
+	GBEGIN_EXCEPTION
+		byteArray.setLength(16);
+	GEND_EXCEPTION(const GException &)
+	GEQUAL(byteArray.getLength(), 8);
+
+	byteArray.setPosition(8);
+	GBEGIN_EXCEPTION
+		byteArray.writeInt32(1);
+	GEND_EXCEPTION(const GException &)
+	GEQUAL(byteArray.getLength(), 8);
+
+	// writing inside the length doesn't move the memory
+	byteArray.setPosition(0);
+	byteArray.writeInt32(1);
+	byteArray.setLength(8);
+
+	byteArray.releaseBufferExport();
+	GEQUAL(byteArray.getBufferExportCount(), 0);
+	byteArray.setLength(16);
+	GEQUAL(byteArray.getLength(), 16);
+}
+
 
 
 } }
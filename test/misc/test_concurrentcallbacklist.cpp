@@ -0,0 +1,247 @@
+#include "test_misc_common.h"
+
+#include "cpgf/gconcurrentcallbacklist.h"
+
+#include <thread>
+#include <atomic>
+#include <vector>
+
+
+using namespace cpgf;
+
+
+namespace Test_ConcurrentCallbackList { namespace {
+
+typedef GConcurrentCallbackList<void (int)> CallbackListType;
+
+int sum = 0;
+
+void addToSum(int n)
+{
+	sum += n;
+}
+
+void addTwiceToSum(int n)
+{
+	sum += n * 2;
+}
+
+GTEST(TestConcurrentCallbackList_Basic)
+{
+	CallbackListType callbackList;
+	GCHECK(callbackList.empty());
+
+	callbackList.add(&addToSum);
+	callbackList.add(&addTwiceToSum);
+	GEQUAL(2, callbackList.getCount());
+
+	sum = 0;
+	callbackList(5);
+	GEQUAL(15, sum);
+
+	callbackList.remove(&addToSum);
+	GEQUAL(1, callbackList.getCount());
+	sum = 0;
+	callbackList.dispatch(5);
+	GEQUAL(10, sum);
+
+	callbackList.clear();
+	GCHECK(callbackList.empty());
+	sum = 0;
+	callbackList(5);
+	GEQUAL(0, sum);
+}
+
+struct ReentrantListener
+{
+	CallbackListType * callbackList;
+	int callCount;
+
+	void onEvent(int /*n*/) {
+		++this->callCount;
+		// Both changes are seen by the next dispatch only.
+		this->callbackList->remove(makeCallback(this, &ReentrantListener::onEvent));
+		this->callbackList->add(&addToSum);
+	}
+};
+
+GTEST(TestConcurrentCallbackList_ModifyInCallback)
+{
+	CallbackListType callbackList;
+	ReentrantListener listener = { &callbackList, 0 };
+	callbackList.add(makeCallback(&listener, &ReentrantListener::onEvent));
+
+	sum = 0;
+	callbackList(1);
+	GEQUAL(1, listener.callCount);
+	GEQUAL(0, sum);
+	GEQUAL(1, callbackList.getCount());
+
+	callbackList(1);
+	GEQUAL(1, listener.callCount);
+	GEQUAL(1, sum);
+}
+
+std::atomic<int> threadCounter(0);
+
+struct CounterAdder
+{
+	int value;
+
+	void operator() () const {
+		threadCounter += this->value;
+	}
+
+	bool operator == (const CounterAdder & other) const {
+		return this->value == other.value;
+	}
+};
+
+GTEST(TestConcurrentCallbackList_Threads)
+{
+	GConcurrentCallbackList<void ()> callbackList;
+	threadCounter = 0;
+	callbackList.add(CounterAdder{ 1 });
+
+	std::atomic<bool> stop(false);
+	std::vector<std::thread> dispatchers;
+	for(int i = 0; i < 2; ++i) {
+		dispatchers.push_back(std::thread([&callbackList, &stop]() {
+			while(! stop) {
+				callbackList();
+			}
+		}));
+	}
+
+	// Add and remove while the other threads dispatch.
+	for(int i = 0; i < 1000; ++i) {
+		callbackList.add(CounterAdder{ i + 2 });
+		callbackList.remove(CounterAdder{ i + 2 });
+	}
+
+	stop = true;
+	for(std::thread & thread : dispatchers) {
+		thread.join();
+	}
+
+	GEQUAL(1, callbackList.getCount());
+	const int previous = threadCounter;
+	callbackList();
+	GEQUAL(previous + 1, (int)threadCounter);
+}
+
+std::atomic<int> liveTrackedCount(0);
+
+// Counts its live copies, so the test can see whether retired snapshots are freed.
+struct TrackedAdder
+{
+	int value;
+
+	explicit TrackedAdder(int value) : value(value) {
+		++liveTrackedCount;
+	}
+
+	TrackedAdder(const TrackedAdder & other) : value(other.value) {
+		++liveTrackedCount;
+	}
+
+	~TrackedAdder() {
+		--liveTrackedCount;
+	}
+
+	void operator() () const {
+		threadCounter += this->value;
+	}
+
+	bool operator == (const TrackedAdder & other) const {
+		return this->value == other.value;
+	}
+};
+
+GTEST(TestConcurrentCallbackList_OverlappingDispatchFreesRetired)
+{
+	GConcurrentCallbackList<void ()> callbackList;
+	liveTrackedCount = 0;
+	callbackList.add(CounterAdder{ 1 });
+
+	// Several dispatching threads overlap, so most modifications see a running dispatch
+	// and have to keep the replaced snapshots.
+	std::atomic<bool> stop(false);
+	std::vector<std::thread> dispatchers;
+	for(int i = 0; i < 4; ++i) {
+		dispatchers.push_back(std::thread([&callbackList, &stop]() {
+			while(! stop) {
+				callbackList();
+			}
+		}));
+	}
+
+	std::vector<std::thread> modifiers;
+	for(int i = 0; i < 2; ++i) {
+		modifiers.push_back(std::thread([&callbackList, i]() {
+			for(int k = 0; k < 2000; ++k) {
+				const int value = 2 + i * 10000 + k;
+				callbackList.add(TrackedAdder(value));
+				callbackList.remove(TrackedAdder(value));
+			}
+		}));
+	}
+	for(std::thread & thread : modifiers) {
+		thread.join();
+	}
+
+	stop = true;
+	for(std::thread & thread : dispatchers) {
+		thread.join();
+	}
+
+	// Dispatching doesn't free the retired snapshots, collect does once no dispatch is running.
+	GEQUAL(1, callbackList.getCount());
+	callbackList.collect();
+	GEQUAL(0, (int)liveTrackedCount);
+}
+
+// Dispatches and modifies the list from the destructor.
+struct ReentrantDestroyer
+{
+	GConcurrentCallbackList<void ()> * callbackList;
+	int * destroyedCount;
+
+	~ReentrantDestroyer() {
+		if(this->callbackList != nullptr) {
+			(*this->callbackList)();
+			this->callbackList->remove(CounterAdder{ 999 });
+			++*this->destroyedCount;
+		}
+	}
+
+	void operator() () const {
+	}
+
+	bool operator == (const ReentrantDestroyer & other) const {
+		return this->callbackList == other.callbackList;
+	}
+};
+
+GTEST(TestConcurrentCallbackList_CallbackDestructorUsesList)
+{
+	GConcurrentCallbackList<void ()> callbackList;
+	int destroyedCount = 0;
+
+	{
+		ReentrantDestroyer destroyer = { &callbackList, &destroyedCount };
+		callbackList.add(destroyer);
+		destroyer.callbackList = nullptr;
+	}
+	const int countAfterAdd = destroyedCount;
+
+	// The snapshots holding the callback are freed after the mutex is released,
+	// so the destructors don't dead lock on it.
+	callbackList.clear();
+	callbackList.collect();
+	GCHECK(destroyedCount > countAfterAdd);
+	GEQUAL(0, callbackList.getCount());
+}
+
+
+} }
@@ -2,6 +2,12 @@
 
 #include "cpgf/gmemorypool.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+
 
 using namespace cpgf;
 
@@ -55,6 +61,90 @@ GTEST(TestMemoryPool)
 	GEQUAL(0, counter);
 }
 
+GTEST(TestMemoryPool_FreeOnOtherThread)
+{
+	const size_t blockSize = 1000;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	void * block = nullptr;
+	bool blockFreed = false;
+	void * reusedBlock = nullptr;
+
+	std::thread owner([&]() {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			block = GMemoryPool::getInstance()->allocate(blockSize);
+			condition.notify_all();
+			condition.wait(lock, [&]() { return blockFreed; });
+		}
+		// The block freed on the main thread goes back to the pool of this thread.
+		reusedBlock = GMemoryPool::getInstance()->allocate(blockSize);
+		GMemoryPool::getInstance()->free(reusedBlock, blockSize);
+	});
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [&]() { return block != nullptr; });
+		GMemoryPool::getInstance()->free(block, blockSize);
+		blockFreed = true;
+		condition.notify_all();
+	}
+	owner.join();
+
+	GEQUAL(block, reusedBlock);
+}
+
+GTEST(TestMemoryPool_Threads)
+{
+	const int threadCount = 4;
+	const int blockCount = 20000;
+
+	// Each thread allocates blocks and frees the blocks allocated by the previous thread.
+	std::mutex mutex;
+	std::vector<std::vector<int *> > blockLists(threadCount);
+	std::atomic<int> errorCount(0);
+
+	std::vector<std::thread> threads;
+	for(int t = 0; t < threadCount; ++t) {
+		threads.push_back(std::thread([&, t]() {
+			for(int i = 0; i < blockCount; ++i) {
+				int * p = static_cast<int *>(GMemoryPool::getInstance()->allocate(sizeof(int) * 4));
+				p[0] = t;
+				p[3] = i;
+
+				int * other = nullptr;
+				{
+					std::lock_guard<std::mutex> lockGuard(mutex);
+					blockLists[t].push_back(p);
+					std::vector<int *> & otherList = blockLists[(t + 1) % threadCount];
+					if(! otherList.empty()) {
+						other = otherList.back();
+						otherList.pop_back();
+					}
+				}
+				if(other != nullptr) {
+					if(other[0] != (t + 1) % threadCount) {
+						++errorCount;
+					}
+					GMemoryPool::getInstance()->free(other, sizeof(int) * 4);
+				}
+			}
+		}));
+	}
+	for(std::thread & thread : threads) {
+		thread.join();
+	}
+
+	for(std::vector<int *> & blockList : blockLists) {
+		for(int * p : blockList) {
+			GMemoryPool::getInstance()->free(p, sizeof(int) * 4);
+		}
+	}
+
+	GEQUAL(0, (int)errorCount);
+}
+
 
 
 
@@ -0,0 +1,118 @@
+#include "test_misc_common.h"
+
+#include "cpgf/gmetaprofile.h"
+
+#include <string>
+
+
+using namespace cpgf;
+
+
+namespace Test_MetaProfile { namespace {
+
+GTEST(TestMetaProfile_Count)
+{
+	resetMetaProfile();
+	GEQUAL(0u, getMetaProfileCount(mpcGlueData));
+
+	metaProfileCount(mpcGlueData);
+	metaProfileCount(mpcGlueData);
+	GEQUAL(2u, getMetaProfileCount(mpcGlueData));
+	GEQUAL(0u, getMetaProfileCount(mpcLuaUserData));
+
+	resetMetaProfile();
+	GEQUAL(0u, getMetaProfileCount(mpcGlueData));
+}
+
+GTEST(TestMetaProfile_CountItem)
+{
+	resetMetaProfile();
+
+	metaProfileCountItem(mpcMethodInvoke, "add");
+	metaProfileCountItem(mpcMethodInvoke, "add");
+	metaProfileCountItem(mpcMethodInvoke, "remove");
+	GEQUAL(3u, getMetaProfileCount(mpcMethodInvoke));
+	GEQUAL(2u, getMetaProfileItemCount(mpcMethodInvoke, "add"));
+	GEQUAL(1u, getMetaProfileItemCount(mpcMethodInvoke, "remove"));
+	GEQUAL(0u, getMetaProfileItemCount(mpcMethodInvoke, "clear"));
+	GEQUAL(0u, getMetaProfileItemCount(mpcObjectCreate, "add"));
+
+	resetMetaProfile();
+	GEQUAL(0u, getMetaProfileItemCount(mpcMethodInvoke, "add"));
+}
+
+GTEST(TestMetaProfile_Dump)
+{
+	resetMetaProfile();
+
+	metaProfileCountItem(mpcObjectCreate, "Small");
+	metaProfileCountItem(mpcObjectCreate, "Large");
+	metaProfileCountItem(mpcObjectCreate, "Large");
+
+	const std::string report = dumpMetaProfile();
+	const std::string categoryName = getMetaProfileCategoryName(mpcObjectCreate);
+	GCHECK(report.find(categoryName + ": 3\n") != std::string::npos);
+	GCHECK(report.find("    Large: 2\n") != std::string::npos);
+	GCHECK(report.find("    Large: 2\n") < report.find("    Small: 1\n"));
+
+	resetMetaProfile();
+}
+
+GTEST(TestMetaProfile_Sample)
+{
+	resetMetaProfile();
+	const uint32_t previousInterval = getMetaProfileSampleInterval();
+
+	GMetaProfileSampleStat stat;
+
+	setMetaProfileSampleInterval(1);
+	for(int i = 0; i < 3; ++i) {
+		GMetaProfileSampler sampler(mptResolve);
+		GCHECK(sampler.isSampling());
+		sampler.finish("Foo::bar");
+		GCHECK(! sampler.isSampling());
+	}
+	GCHECK(getMetaProfileSampleStat(mptResolve, "Foo::bar", &stat));
+	GEQUAL(3u, stat.sampleCount);
+	GEQUAL(3u, stat.estimatedCallCount);
+	GCHECK(! getMetaProfileSampleStat(mptMethodInvoke, "Foo::bar", &stat));
+
+	// Each timing is sampled independently, on average once per interval.
+	setMetaProfileSampleInterval(4);
+	const int callCount = 8000;
+	int sampledCount = 0;
+	for(int i = 0; i < callCount; ++i) {
+		GMetaProfileSampler outerSampler(mptBindingInvoke);
+		GMetaProfileSampler innerSampler(mptMethodInvoke);
+		sampledCount += (outerSampler.isSampling() ? 1 : 0);
+		innerSampler.finish("Foo::bar");
+		outerSampler.finish("Foo::bar");
+	}
+	GCHECK(sampledCount > callCount / 4 * 9 / 10 && sampledCount < callCount / 4 * 11 / 10);
+	GCHECK(getMetaProfileSampleStat(mptMethodInvoke, "Foo::bar", &stat));
+	GCHECK(stat.sampleCount > callCount / 4 * 9 / 10 && stat.sampleCount < callCount / 4 * 11 / 10);
+	GEQUAL(stat.sampleCount * 4, stat.estimatedCallCount);
+
+	// The gap between samples varies, so a call repeating every interval calls isn't always the one sampled.
+	int sampledPeriodicCount = 0;
+	for(int i = 0; i < callCount; ++i) {
+		GMetaProfileSampler sampler(mptResolve);
+		if(i % 4 == 0) {
+			sampledPeriodicCount += (sampler.isSampling() ? 1 : 0);
+		}
+	}
+	GCHECK(sampledPeriodicCount > 0 && sampledPeriodicCount < callCount / 4 / 2);
+
+	setMetaProfileSampleInterval(0);
+	GMetaProfileSampler disabledSampler(mptResolve);
+	GCHECK(! disabledSampler.isSampling());
+
+	const std::string report = dumpMetaProfile();
+	GCHECK(report.find(std::string(getMetaProfileTimingName(mptMethodInvoke)) + ":\n    Foo::bar: total ") != std::string::npos);
+
+	setMetaProfileSampleInterval(previousInterval);
+	resetMetaProfile();
+}
+
+
+} }
@@ -0,0 +1,144 @@
+#include "test_reflection_common.h"
+#include "cpgf/gmetaannotationindex.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace cpgf;
+
+
+namespace Test_AnnotationIndex { namespace {
+
+class TestAnnotationIndexA
+{
+public:
+	int width;
+	int height;
+	string name;
+
+	void draw() {}
+};
+
+class TestAnnotationIndexB
+{
+public:
+	class Inner
+	{
+	public:
+		int depth;
+	};
+
+public:
+	int count;
+};
+
+G_AUTO_RUN_BEFORE_MAIN()
+{
+	GDefineMetaClass<TestAnnotationIndexA>
+		::define("TestAnnotationIndexA")
+		._annotation("indexTestSerialize")
+			._element("format", "text")
+		._field("width", &TestAnnotationIndexA::width)
+			._annotation("indexTestSerialize")
+				._element("format", "binary")
+		._field("height", &TestAnnotationIndexA::height)
+			._annotation("indexTestSerialize")
+				._element("format", "text")
+				._element("version", 2)
+		._field("name", &TestAnnotationIndexA::name)
+			._annotation("indexTestScript")
+				._element("version", 2)
+		._method("draw", &TestAnnotationIndexA::draw)
+			._annotation("indexTestSerialize")
+				._element("format", "text")
+	;
+
+	GDefineMetaClass<TestAnnotationIndexB>
+		::define("TestAnnotationIndexB")
+		._field("count", &TestAnnotationIndexB::count)
+			._annotation("indexTestSerialize")
+				._element("format", "binary")
+		._class(
+			GDefineMetaClass<TestAnnotationIndexB::Inner>::declare("Inner")
+				._field("depth", &TestAnnotationIndexB::Inner::depth)
+					._annotation("indexTestSerialize")
+						._element("format", "text")
+		)
+	;
+}
+
+bool hasItem(const vector<const GMetaItem *> & items, const char * name)
+{
+	for(const GMetaItem * item : items) {
+		if(item->getName() == name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+GTEST(AnnotationIndex_GetEntries)
+{
+	GMetaAnnotationIndex index;
+
+	const GMetaAnnotationIndex::EntryListType & entries = index.getEntries("indexTestSerialize");
+	GEQUAL(6u, entries.size());
+	for(const GMetaAnnotationIndexEntry & entry : entries) {
+		GCHECK(entry.annotation->getMetaItem() == entry.item);
+		GEQUAL(string("indexTestSerialize"), entry.annotation->getName());
+	}
+
+	GEQUAL(1u, index.getEntries("indexTestScript").size());
+	GEQUAL(string("name"), index.getEntries("indexTestScript")[0].item->getName());
+	GEQUAL(0u, index.getEntries("indexTestNotExist").size());
+}
+
+GTEST(AnnotationIndex_FindItems)
+{
+	GMetaAnnotationIndex index;
+	vector<const GMetaItem *> items;
+
+	index.findItems("indexTestSerialize", mcatField, &items);
+	GEQUAL(4u, items.size());
+	GCHECK(hasItem(items, "depth"));
+	GCHECK(! hasItem(items, "name"));
+
+	items.clear();
+	index.findItems("indexTestSerialize", "format", GAnnotationValue("text"), mcatField, &items);
+	GEQUAL(2u, items.size());
+	GCHECK(hasItem(items, "height"));
+	GCHECK(hasItem(items, "depth"));
+
+	items.clear();
+	index.findItems("indexTestSerialize", "format", GAnnotationValue("text"), mcatCount, &items);
+	GEQUAL(4u, items.size());
+	GCHECK(hasItem(items, "TestAnnotationIndexA"));
+	GCHECK(hasItem(items, "draw"));
+
+	items.clear();
+	index.findItems("indexTestSerialize", "version", GAnnotationValue(2), mcatCount, &items);
+	GEQUAL(1u, items.size());
+	GCHECK(hasItem(items, "height"));
+
+	items.clear();
+	index.findItems("indexTestSerialize", "format", GAnnotationValue(2), mcatCount, &items);
+	GEQUAL(0u, items.size());
+}
+
+GTEST(AnnotationIndex_RootClass)
+{
+	GMetaAnnotationIndex index(findMetaClass("TestAnnotationIndexB"));
+	vector<const GMetaItem *> items;
+
+	index.findItems("indexTestSerialize", mcatCount, &items);
+	GEQUAL(2u, items.size());
+	GCHECK(hasItem(items, "count"));
+	GCHECK(hasItem(items, "depth"));
+
+	index.rebuild();
+	GEQUAL(2u, index.getEntries("indexTestSerialize").size());
+}
+
+
+} }
@@ -49,6 +49,26 @@ class XE : public XC, public XD
 	long double e;
 };
 
+class YA
+{
+	int a;
+};
+
+class YB
+{
+	double b;
+};
+
+class YC : public YA, public YB
+{
+	char c;
+};
+
+class YD : public YC, virtual public XA
+{
+	short d;
+};
+
 
 G_AUTO_RUN_BEFORE_MAIN()
 {
@@ -73,6 +93,22 @@ G_AUTO_RUN_BEFORE_MAIN()
 	GDefineMetaClass<XE, XC, XD>
 		::define(MM(XE))
 	;
+
+	GDefineMetaClass<YA>
+		::define(MM(YA))
+	;
+
+	GDefineMetaClass<YB>
+		::define(MM(YB))
+	;
+
+	GDefineMetaClass<YC, YA, YB>
+		::define(MM(YC))
+	;
+
+	GDefineMetaClass<YD, YC, XA>
+		::define(MM(YD))
+	;
 }
 
 
@@ -110,6 +146,65 @@ GTEST(API_TestTraveller)
 	GCHECK(nextClass == NULL);
 }
 
+GTEST(Lib_TestBaseOffset)
+{
+	const GMetaClass * metaClass = findMetaClass(MM(YC));
+	ptrdiff_t offset;
+	YC yc;
+
+	GCHECK(metaClass->getBaseOffset(0, &offset));
+	GEQUAL(reinterpret_cast<char *>(static_cast<YA *>(&yc)) - reinterpret_cast<char *>(&yc), offset);
+	GCHECK(metaClass->getBaseOffset(1, &offset));
+	GEQUAL(reinterpret_cast<char *>(static_cast<YB *>(&yc)) - reinterpret_cast<char *>(&yc), offset);
+
+	metaClass = findMetaClass(MM(XC));
+	GCHECK(! metaClass->getBaseOffset(0, &offset));
+	GCHECK(! metaClass->getBaseOffset(1, &offset));
+}
+
+GTEST(API_TestLinearization)
+{
+	GScopedInterface<IMetaService> service(createDefaultMetaService());
+	GScopedInterface<IMetaClass> metaClass(service->findClassByName(MM(YD)));
+	GCHECK(metaClass);
+
+	GMetaClassLinearization linearization(metaClass.get());
+	GEQUAL(5u, linearization.getCount());
+
+	YD yd;
+	void * instance = &yd;
+
+	GCHECK(linearization.getDerivedAt(0) == NULL);
+	GEQUAL(instance, linearization.getInstanceAt(0, instance));
+
+	GEQUAL(string(MM(YC)), string(linearization.getClassAt(1)->getName()));
+	GEQUAL(static_cast<void *>(static_cast<YC *>(&yd)), linearization.getInstanceAt(1, instance));
+
+	GEQUAL(string(MM(XA)), string(linearization.getClassAt(2)->getName()));
+	GEQUAL(static_cast<void *>(static_cast<XA *>(&yd)), linearization.getInstanceAt(2, instance));
+
+	GEQUAL(string(MM(YA)), string(linearization.getClassAt(3)->getName()));
+	GEQUAL(static_cast<void *>(static_cast<YA *>(&yd)), linearization.getInstanceAt(3, instance));
+	GCHECK(linearization.getDerivedAt(3) == linearization.getClassAt(1));
+
+	GEQUAL(string(MM(YB)), string(linearization.getClassAt(4)->getName()));
+	GEQUAL(static_cast<void *>(static_cast<YB *>(&yd)), linearization.getInstanceAt(4, instance));
+
+	GCHECK(linearization.getInstanceAt(4, NULL) == NULL);
+
+	GMetaClassTraveller traveller(&linearization, instance);
+	void * nextInstance;
+	IMetaClass * nextDerived;
+	for(size_t i = 0; i < linearization.getCount(); ++i) {
+		GScopedInterface<IMetaClass> nextClass(traveller.next(&nextInstance, &nextDerived));
+		GScopedInterface<IMetaClass> derived(nextDerived);
+		GCHECK(nextClass.get() == linearization.getClassAt(i));
+		GCHECK(derived.get() == linearization.getDerivedAt(i));
+		GEQUAL(linearization.getInstanceAt(i, instance), nextInstance);
+	}
+	GCHECK(traveller.next(&nextInstance) == NULL);
+}
+
 
 
 
@@ -20,6 +20,10 @@ public:
 		bs1 = 1, bs2 = 3, bs3 = 5, bs4 = 7, bs5 = 0x1fffffff,
 	};
 
+	enum EnumThird {
+		ts1 = 2, ts2 = -1, ts3 = 2
+	};
+
 
 }; // class CLASS
 
@@ -43,6 +47,11 @@ G_AUTO_RUN_BEFORE_MAIN()
 			._element("bs3", CLASS::bs3)
 			._element("bs4", CLASS::bs4)
 			._element("bs5", CLASS::bs5)
+
+		._enum<CLASS::EnumThird>("EnumThird")
+			._element("ts1", CLASS::ts1)
+			._element("ts2", CLASS::ts2)
+			._element("ts3", CLASS::ts3)
 	;
 }
 
@@ -262,6 +271,63 @@ GTEST(API_FindKey)
 }
 
 
+GTEST(Lib_GetIntValue)
+{
+	const GMetaClass * metaClass = findMetaClass(NAME_CLASS);
+	GCHECK(metaClass);
+
+	const GMetaEnum * en;
+
+	ENUM(EnumSecond);
+	GEQUAL(en->getIntValue(0), CLASS::bs1);
+	GEQUAL(en->getIntValue(4), CLASS::bs5);
+	GEQUAL(en->getIntValue(5), 0);
+
+	ENUM(EnumThird);
+	GEQUAL(en->getIntValue(1), CLASS::ts2);
+}
+
+
+GTEST(Lib_FindValue)
+{
+	const GMetaClass * metaClass = findMetaClass(NAME_CLASS);
+	GCHECK(metaClass);
+
+	const GMetaEnum * en;
+
+	ENUM(EnumSecond);
+	GEQUAL(en->findValue(CLASS::bs1), 0);
+	GEQUAL(en->findValue(CLASS::bs3), 2);
+	GEQUAL(en->findValue(CLASS::bs5), 4);
+	GEQUAL(en->findValue(2), -1);
+	GEQUAL(en->findValue(100), -1);
+
+	ENUM(EnumThird);
+	GEQUAL(en->findValue(CLASS::ts1), 0);
+	GEQUAL(en->findValue(CLASS::ts2), 1);
+}
+
+
+GTEST(API_FindValue)
+{
+	GScopedInterface<IMetaService> service(createDefaultMetaService());
+	GCHECK(service);
+
+	GScopedInterface<IMetaClass> metaClass(service->findClassByName(NAME_CLASS));
+	GCHECK(metaClass);
+
+	GScopedInterface<IMetaEnum> en;
+
+	ENUM(EnumSecond);
+	GEQUAL(en->getIntValue(3), CLASS::bs4);
+	GEQUAL(en->findValue(CLASS::bs4), 3);
+	GEQUAL(en->findValue(2), -1);
+
+	ENUM(EnumThird);
+	GEQUAL(en->findValue(CLASS::ts3), 0);
+}
+
+
 
 
 
@@ -0,0 +1,127 @@
+#include "test_reflection_common.h"
+
+#define CLASS TestClass_MemberTable
+#define NAME_CLASS GPP_STRINGIZE(CLASS)
+
+
+using namespace std;
+using namespace cpgf;
+
+namespace Test_MemberTable { namespace {
+
+class CLASS {
+public:
+	CLASS() : value(0), text() {}
+	CLASS(int value, const string & text) : value(value), text(text) {}
+
+	int getValue() const {
+		return value;
+	}
+
+	void add(int n) {
+		value += n;
+	}
+
+	void add(int a, int b) {
+		value += a + b;
+	}
+
+	const string & getText() const {
+		return text;
+	}
+
+	static int twice(int n) {
+		return n * 2;
+	}
+
+public:
+	int value;
+	string text;
+	static int staticValue;
+};
+
+int CLASS::staticValue = 5;
+
+template <typename D>
+void buildMetaClass_MemberTable(D _d)
+{
+	typedef typename D::ClassType ClassType;
+
+	static constexpr GMetaMemberDescriptor members[] = {
+		metaTableConstructor<ClassType, void * ()>(),
+		metaTableConstructor<ClassType, void * (int, const string &), GMetaPolicyCopyAllConstReference>(),
+		metaTableMethod<ClassType, decltype(&ClassType::getValue), &ClassType::getValue>("getValue"),
+		metaTableMethod<ClassType, void (ClassType::*)(int), &ClassType::add>("add"),
+		metaTableMethod<ClassType, void (ClassType::*)(int, int), &ClassType::add>("add"),
+		metaTableMethod<ClassType, decltype(&ClassType::getText), &ClassType::getText, GMetaPolicyCopyAllConstReference>("getText"),
+		metaTableMethod<ClassType, decltype(&ClassType::twice), &ClassType::twice>("twice"),
+		metaTableField<decltype(&ClassType::value), &ClassType::value>("value"),
+		metaTableField<decltype(&ClassType::text), &ClassType::text>("text"),
+		metaTableField<decltype(&ClassType::staticValue), &ClassType::staticValue>("staticValue"),
+	};
+
+	_d._members(members);
+	_d._method("getValueByChain", &ClassType::getValue);
+}
+
+G_AUTO_RUN_BEFORE_MAIN()
+{
+	GDefineMetaClass<CLASS> define = GDefineMetaClass<CLASS>::define(NAME_CLASS);
+	buildMetaClass_MemberTable(define);
+}
+
+
+GTEST(MemberTable_Items)
+{
+	const GMetaClass * metaClass = findMetaClass(NAME_CLASS);
+	GCHECK(metaClass);
+
+	GEQUAL(2u, metaClass->getConstructorCount());
+	GEQUAL(6u, metaClass->getMethodCount());
+	GEQUAL(3u, metaClass->getFieldCount());
+
+	GCHECK(metaClass->getMethod("getValueByChain"));
+	GCHECK(metaClass->getMethod("twice")->isStatic());
+	GCHECK(metaClass->getField("staticValue")->isStatic());
+	GCHECK(metaClass->getMethodAt(0)->getOwnerItem() == metaClass);
+}
+
+GTEST(MemberTable_Invoke)
+{
+	const GMetaClass * metaClass = findMetaClass(NAME_CLASS);
+	GCHECK(metaClass);
+
+	CLASS * obj = static_cast<CLASS *>(metaClass->getConstructorByParamCount(2)->invoke(3, string("abc")));
+
+	GEQUAL(3, fromVariant<int>(metaClass->getMethod("getValue")->invoke(obj)));
+	GEQUAL(string("abc"), fromVariant<string>(metaClass->getMethod("getText")->invoke(obj)));
+
+	const GMetaMethod * add1 = nullptr;
+	const GMetaMethod * add2 = nullptr;
+	for(size_t i = 0; i < metaClass->getMethodCount(); ++i) {
+		const GMetaMethod * method = metaClass->getMethodAt(i);
+		if(method->getName() == "add") {
+			if(method->getParamCount() == 1) {
+				add1 = method;
+			}
+			else {
+				add2 = method;
+			}
+		}
+	}
+	GCHECK(add1 != nullptr && add2 != nullptr);
+	add1->invoke(obj, 2);
+	add2->invoke(obj, 4, 5);
+	GEQUAL(14, obj->value);
+
+	GEQUAL(8, fromVariant<int>(metaClass->getMethod("twice")->invoke(nullptr, 4)));
+
+	metaClass->getField("value")->set(obj, 20);
+	GEQUAL(20, fromVariant<int>(metaClass->getField("value")->get(obj)));
+	GEQUAL(5, fromVariant<int>(metaClass->getField("staticValue")->get(nullptr)));
+
+	metaClass->destroyInstance(obj);
+}
+
+
+} }
@@ -151,6 +151,7 @@ G_AUTO_RUN_BEFORE_MAIN()
 		._method("methodExplicitThis", &methodExplicitThis, GMetaPolicyExplicitThis())
 		._method("methodExplicitThisSum", &methodExplicitThisSum, GMetaPolicyExplicitThis())
 		._method("methodFunctor", GCallback<int(CLASS *, int, const string &)>(methodFunctor()), MakePolicy<GMetaRuleCopyConstReference<2>, GMetaRuleExplicitThis>())
+		._method("methodReleaseScriptLock", &CLASS::methodGetInt, GMetaPolicyReleaseScriptLock())
 	;
 }
 
@@ -998,5 +999,27 @@ GTEST(Lib_PassParamByValueAndRef)
 
 
 
-} }
+GTEST(API_ReleaseScriptLock)
+{
+	GScopedInterface<IMetaService> service(createDefaultMetaService());
+	GCHECK(service);
+
+	GScopedInterface<IMetaClass> metaClass(service->findClassByName(NAME_CLASS));
+	GCHECK(metaClass);
+
+	GScopedInterface<IMetaMethod> method;
 
+	METHOD(methodGetInt);
+	GCHECK(! method->isReleaseScriptLock());
+
+	METHOD(methodReleaseScriptLock);
+	GCHECK(method->isReleaseScriptLock());
+
+	CLASS obj;
+	obj.fieldMethodInt = 5;
+	GEQUAL(5, fromVariant<int>(metaInvokeMethod(method.get(), &obj)));
+}
+
+
+
+} }
@@ -75,6 +75,72 @@ void testInvokeScriptFunction(TestScriptContext * context)
 #include "../bind_testcase.h"
 
 
+template <typename T>
+void doTestInvokeScriptFunctionBatch(T * binding, TestScriptContext * context)
+{
+	if(context->isLua()) {
+		QDO(function funcMulAdd(a, b, c) return a * b + c end)
+		QDO(function funcLenBatch(a) return string.len(a) end)
+	}
+	if(context->isV8() || context->isSpiderMonkey()) {
+		QDO(function funcMulAdd(a, b, c) { return a * b + c; })
+		QDO(function funcLenBatch(a) { return a.length; })
+	}
+	if(context->isPython()) {
+		QDO(def funcMulAdd(a, b, c): return a * b + c)
+		QDO(def funcLenBatch(a): return len(a))
+	}
+
+	const size_t batchCount = 100;
+	int a[batchCount];
+	double b[batchCount];
+	int c[batchCount];
+	for(size_t i = 0; i < batchCount; ++i) {
+		a[i] = (int)i;
+		b[i] = 2;
+		c[i] = 5;
+	}
+
+	GScriptValue results[batchCount];
+	GScopedInterface<IScriptFunction> funcMulAdd(scriptGetValue(binding, "funcMulAdd").toScriptFunction());
+	invokeScriptFunctionBatch(funcMulAdd.get(), results, batchCount, a, b, c);
+	for(size_t i = 0; i < batchCount; ++i) {
+		GEQUAL(fromVariant<int>(results[i].getValue()), (int)i * 2 + 5);
+	}
+
+	// Results can be ignored.
+	invokeScriptFunctionBatch(funcMulAdd.get(), nullptr, batchCount, a, b, c);
+
+	const char * strings[] = { "a", "abc", "", "abcdef" };
+	GScopedInterface<IScriptFunction> funcLen(scriptGetValue(binding, "funcLenBatch").toScriptFunction());
+	invokeScriptFunctionBatch(funcLen.get(), results, 4, strings);
+	GEQUAL(fromVariant<int>(results[0].getValue()), 1);
+	GEQUAL(fromVariant<int>(results[1].getValue()), 3);
+	GEQUAL(fromVariant<int>(results[2].getValue()), 0);
+	GEQUAL(fromVariant<int>(results[3].getValue()), 6);
+
+	// The function is still callable one by one after the batches.
+	GEQUAL(fromVariant<int>(invokeScriptFunction(funcMulAdd.get(), 3, 4, 1).getValue()), 13);
+}
+
+void testInvokeScriptFunctionBatch(TestScriptContext * context)
+{
+	GScriptObject * bindingLib = context->getBindingLib();
+	IScriptObject * bindingApi = context->getBindingApi();
+
+	if(bindingLib) {
+		doTestInvokeScriptFunctionBatch(bindingLib, context);
+	}
+	
+	if(bindingApi) {
+		doTestInvokeScriptFunctionBatch(bindingApi, context);
+	}
+}
+
+#define CASE testInvokeScriptFunctionBatch
+#include "../bind_testcase.h"
+
+
 template <typename T>
 void doTestInvokeCppFunction(T * binding, TestScriptContext * context)
 {
@@ -0,0 +1,42 @@
+#include "../testscriptbind.h"
+
+#include "cpgf/gmetaprofile.h"
+
+#include <string>
+
+
+namespace {
+
+
+#if G_ENABLE_META_PROFILE
+
+// The binding counts the invoked methods by the qualified name,
+// so methods with the same name in different classes are not mixed up.
+void testMetaProfileMethodInvokeCount(TestScriptContext * context)
+{
+	GScopedInterface<IMetaClass> metaClass(context->getService()->findClassByName(REG_NAME_TestObject));
+	GScopedInterface<IMetaMethod> method(metaClass->getMethod("add"));
+	const std::string qualifiedName = method->getQualifiedName();
+	method.reset(metaClass->getMethod("methodConst"));
+	const std::string overloadedQualifiedName = method->getQualifiedName();
+
+	QNEWOBJ(a, TestObject())
+
+	resetMetaProfile();
+	QDO(a.add(1))
+	QDO(a.add(2))
+	QDO(a.methodConst())
+	GEQUAL(2u, getMetaProfileItemCount(mpcMethodInvoke, qualifiedName.c_str()));
+	GEQUAL(1u, getMetaProfileItemCount(mpcMethodInvoke, overloadedQualifiedName.c_str()));
+	GEQUAL(0u, getMetaProfileItemCount(mpcMethodInvoke, "add"));
+
+	resetMetaProfile();
+}
+
+#define CASE testMetaProfileMethodInvokeCount
+#include "../bind_testcase.h"
+
+#endif
+
+
+}
@@ -0,0 +1,88 @@
+#include "../testscriptbind.h"
+#include "../testscriptbindmetadata6.h"
+
+
+namespace {
+
+string isSame(TestScriptContext * context, const string & a, const string & b)
+{
+	if(context->isLua()) {
+		return "rawequal(" + a + ", " + b + ")";
+	}
+	if(context->isPython()) {
+		return "(" + a + " is " + b + ")";
+	}
+
+	return "(" + a + " === " + b + ")";
+}
+
+void testObjectIdentity(TestScriptContext * context)
+{
+	QNEWOBJ(a, TestObject())
+	QDO(b = a.self())
+	QDO(c = a.self())
+	DO("scriptAssert(" + isSame(context, "b", "c") + ")")
+	// a is created by the constructor, b is returned by a method, they are the same C++ object and class.
+	DO("scriptAssert(" + isSame(context, "a", "b") + ")")
+
+	// The cv is a part of the identity.
+	QDO(d = a.selfConst())
+	QDO(e = a.selfConst())
+	DO("scriptAssert(" + isSame(context, "d", "e") + ")")
+	DO("scriptNot(" + isSame(context, "b", "d") + ")")
+	QERR(d.value = 1) // d is const object
+
+	QDO(f = a.pointerData())
+	QDO(g = a.pointerData())
+	DO("scriptAssert(" + isSame(context, "f", "g") + ")")
+
+	if(context->isLua()) {
+		// The finalized objects leave the cache, and new objects at the same addresses get new script objects.
+		DO("for i = 1, 20 do local t = TestObject() t.value = i end collectgarbage()")
+		QNEWOBJ(h, TestObject())
+		QDO(h.value = 5)
+		QDO(i = h.self())
+		QASSERT(i.value == 5)
+		DO("scriptAssert(" + isSame(context, "h", "i") + ")")
+	}
+}
+
+
+#define CASE testObjectIdentity
+#include "../bind_testcase.h"
+
+
+void testObjectIdentityTakesOwnership(TestScriptContext * context)
+{
+	TestReusedAddressObject::instanceCount = 0;
+
+	QDO(a = TestReusedAddressObject.getUnowned())
+	QDO(TestReusedAddressObject.deleteUnowned())
+	GEQUAL(0, TestReusedAddressObject::instanceCount);
+
+	// The owned object is at the address of the deleted one, which may still be cached,
+	// the script must take the ownership anyway.
+	QDO(b = TestReusedAddressObject.createOwned())
+	GEQUAL(1, TestReusedAddressObject::instanceCount);
+
+	if(context->isLua()) {
+		QDO(a = nil)
+		QDO(b = nil)
+		QDO(collectgarbage("collect"))
+		QDO(collectgarbage("collect"))
+		GEQUAL(0, TestReusedAddressObject::instanceCount);
+	}
+
+	if(context->isPython()) {
+		QDO(a = None)
+		QDO(b = None)
+		GEQUAL(0, TestReusedAddressObject::instanceCount);
+	}
+}
+
+
+#define CASE testObjectIdentityTakesOwnership
+#include "../bind_testcase.h"
+
+
+}
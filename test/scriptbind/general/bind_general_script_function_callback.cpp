@@ -57,6 +57,66 @@ void testScriptFunctionCallback(TestScriptContext * context)
 
 
 
+string makeRecursiveFunc(TestScriptContext * context)
+{
+	if(context->isLua()) {
+		return "function frecursive(n) return testRecursiveCallback(frecursive, n) end";
+	}
+	if(context->isV8() || context->isSpiderMonkey()) {
+		return "function frecursive(n) { return testRecursiveCallback(frecursive, n); }";
+	}
+	if(context->isPython()) {
+		return "def frecursive(n): return testRecursiveCallback(frecursive, n)";
+	}
+
+	return "";
+}
+
+template <typename T>
+void doTestScriptFunctionRecursiveCallback(T * binding, TestScriptContext * context)
+{
+	GScriptCallStackStat stat;
+
+	DO(makeRecursiveFunc(context))
+	QDO(a = frecursive(5))
+	QASSERT(a == 15)
+
+	// script -> testRecursiveCallback(5) -> script -> ... -> testRecursiveCallback(0)
+	binding->getContext()->getCallStackStat(&stat);
+	GEQUAL(0u, stat.depth);
+	GEQUAL(6u, stat.maxDepth);
+	GEQUAL(0u, stat.usedBytes);
+	GCHECK(stat.peakUsedBytes > 0);
+	GCHECK(stat.reservedBytes >= stat.peakUsedBytes);
+
+	// The arena is rewound after each call, so calling again doesn't reserve more memory.
+	const uint32_t reservedBytes = stat.reservedBytes;
+	QDO(b = frecursive(5))
+	QASSERT(b == 15)
+	binding->getContext()->getCallStackStat(&stat);
+	GEQUAL(0u, stat.depth);
+	GEQUAL(reservedBytes, stat.reservedBytes);
+}
+
+void testScriptFunctionRecursiveCallback(TestScriptContext * context)
+{
+	GScriptObject * bindingLib = context->getBindingLib();
+	IScriptObject * bindingApi = context->getBindingApi();
+
+	if(bindingLib) {
+		doTestScriptFunctionRecursiveCallback(bindingLib, context);
+	}
+
+	if(bindingApi) {
+		doTestScriptFunctionRecursiveCallback(bindingApi, context);
+	}
+}
+
+#define CASE testScriptFunctionRecursiveCallback
+#include "../bind_testcase.h"
+
+
+
 template <typename T>
 void doTestScriptFunctionProperty(T * binding, TestScriptContext * context)
 {
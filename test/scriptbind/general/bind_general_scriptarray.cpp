@@ -1,6 +1,9 @@
 #include "../testscriptbind.h"
 
+#include "cpgf/gexception.h"
+
 #include <string>
+#include <vector>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -218,5 +221,77 @@ void testArray2DScriptArray(TestScriptContext * context)
 #include "../bind_testcase.h"
 
 
+template <typename T>
+void doTestArrayFundamentalValues(T * binding, TestScriptContext * context)
+{
+	doCreateScriptArray(context, "a", "99, 98, 97");
+
+	GScriptValue scriptArrayValue(scriptGetAsScriptArray(binding, "a"));
+	GScopedInterface<IScriptArray> scriptArray(scriptArrayValue.toScriptArray());
+
+	vector<int> intValues;
+	scriptGetScriptArrayValues(scriptArray.get(), &intValues);
+	GEQUAL(3, intValues.size());
+	GEQUAL(99, intValues[0]);
+	GEQUAL(97, intValues[2]);
+
+	const vector<double> doubleValues { 1.5, 2.5, 3.5, 4.5 };
+	scriptSetScriptArrayValues(scriptArray.get(), 1, doubleValues);
+	GEQUAL(5, scriptArray->getLength());
+	DOASSERT(doCreateScriptArrayIndex(context, "a", 0) + " == 99");
+	DOASSERT(doCreateScriptArrayIndex(context, "a", 1) + " == 1.5");
+	DOASSERT(doCreateScriptArrayIndex(context, "a", 4) + " == 4.5");
+
+	float floatValues[8];
+	GEQUAL(3, scriptGetScriptArrayValues(scriptArray.get(), 2, floatValues, 8));
+	GEQUAL(2.5f, floatValues[0]);
+	GEQUAL(4.5f, floatValues[2]);
+
+	// Setting beyond the end would leave a hole, which a Lua sequence can't have.
+	GBEGIN_EXCEPTION
+		scriptSetScriptArrayValues(scriptArray.get(), 6, doubleValues);
+	GEND_EXCEPTION(const GException &)
+	GEQUAL(5, scriptArray->getLength());
+
+	const long long bigValue = 0x123456789LL;
+	scriptSetScriptArrayValues(scriptArray.get(), 5, &bigValue, 1);
+	long long bigValueBack = 0;
+	GEQUAL(1, scriptGetScriptArrayValues(scriptArray.get(), 5, &bigValueBack, 1));
+	GEQUAL(bigValue, bigValueBack);
+}
+
+void testArrayFundamentalValues(TestScriptContext * context)
+{
+	if(context->getBindingLib()) {
+		doTestArrayFundamentalValues(context->getBindingLib(), context);
+	}
+	
+	if(context->getBindingApi()) {
+		doTestArrayFundamentalValues(context->getBindingApi(), context);
+	}
+}
+
+#define CASE testArrayFundamentalValues
+#include "../bind_testcase.h"
+
+
+void testArrayFundamentalValuesReserved(TestScriptContext * context)
+{
+	if(context->getBindingLib()) {
+		const int values[] = { 5, 6, 7, 8 };
+		GScriptValue scriptArrayValue(scriptCreateScriptArray(context->getBindingLib(), "a", 4));
+		GScopedInterface<IScriptArray> scriptArray(scriptArrayValue.toScriptArray());
+
+		scriptSetScriptArrayValues(scriptArray.get(), 0, values, 4);
+		GEQUAL(4, scriptArray->getLength());
+		DOASSERT(doCreateScriptArrayIndex(context, "a", 0) + " == 5");
+		DOASSERT(doCreateScriptArrayIndex(context, "a", 3) + " == 8");
+	}
+}
+
+#define CASE testArrayFundamentalValuesReserved
+#include "../bind_testcase.h"
+
+
 }
 
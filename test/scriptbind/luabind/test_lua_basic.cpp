@@ -55,5 +55,64 @@ void OverloadMethodIndirectInvoke(TestScriptContext * context)
 #include "../testcase_lua.h"
 
 
+// A method with fundamental parameters is invoked directly only if each argument is in the
+// category of its parameter, the other arguments are converted by the ranked invoking.
+void FundamentalParameterCategory(TestScriptContext * context)
+{
+	QDO(a = TestObject())
+	QDO(a.value = 1)
+	QASSERT(a.add(2) == 3)
+	QASSERT(a.add(2.0) == 3)
+	QASSERT(a.add(true) == 2)
+	QASSERT(a.add(false) == 1)
+
+	QDO(scriptAssert(true))
+	QDO(scriptNot(false))
+	QDO(scriptAssert(1))
+	QDO(scriptNot(0))
+}
+
+#define CASE FundamentalParameterCategory
+#include "../testcase_lua.h"
+
+
+void ByteArrayAccessor(TestScriptContext * context)
+{
+	QDO(cpgf._import("cpgf", "builtin.collections.bytearray"))
+
+	QDO(a = cpgf.createByteArray(16))
+	QASSERT(#a == 16)
+
+	QDO(a:setInt32(4, 38))
+	QASSERT(a:getInt32(4) == 38)
+	QASSERT(a.getPosition() == 0)
+	QDO(a.setPosition(4))
+	QASSERT(a.readInt32() == 38)
+
+	QDO(a.writeFloat64(1.5))
+	QASSERT(a:getFloat64(8) == 1.5)
+
+	QERR(a:getInt32(14))
+}
+
+#define CASE ByteArrayAccessor
+#include "../testcase_lua.h"
+
+
+void EnumUnknownKey(TestScriptContext * context)
+{
+	QASSERT(TestEnum.teLua == 2)
+	QERR(a = TestEnum.notExistingKey)
+	QERR(a = TestEnum[true])
+
+	QNEWOBJ(obj, BasicA())
+	QASSERT(obj.BasicEnum.b == 2)
+	QERR(a = obj.BasicEnum.notExistingKey)
+}
+
+#define CASE EnumUnknownKey
+#include "../testcase_lua.h"
+
+
 
 }
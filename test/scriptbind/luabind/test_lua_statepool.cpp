@@ -0,0 +1,80 @@
+#include "../testscriptbind.h"
+
+#if ENABLE_LUA
+
+#include "cpgf/scriptbind/gluastatepool.h"
+
+#include <thread>
+#include <atomic>
+#include <vector>
+
+
+namespace {
+
+
+GTEST(Lua_StatePool)
+{
+	GScopedInterface<IMetaService> service(createDefaultMetaService());
+	IMetaService * metaService = service.get();
+	GLuaStatePool pool(metaService, [metaService](GScriptObject * scriptObject) {
+		bindBasicData(scriptObject, metaService);
+	});
+
+	{
+		GLuaPooledStateGuard state(&pool);
+		GCHECK(luaL_dostring(state->getLuaState(), "a = TestObject(5) assert(a.value == 5) TestObject = nil") == 0);
+	}
+	GEQUAL(1, pool.getTotalCount());
+	GEQUAL(1, pool.getIdleCount());
+
+	{
+		GLuaPooledStateGuard state(&pool);
+		GEQUAL(0, pool.getIdleCount());
+		GCHECK(luaL_dostring(state->getLuaState(), "assert(a == nil) b = TestObject(6) assert(b.value == 6)") == 0);
+	}
+
+	pool.reserve(3);
+	GEQUAL(3, pool.getTotalCount());
+	GEQUAL(3, pool.getIdleCount());
+}
+
+GTEST(Lua_StatePool_Threads)
+{
+	GScopedInterface<IMetaService> service(createDefaultMetaService());
+	IMetaService * metaService = service.get();
+	GLuaStatePool pool(metaService, [metaService](GScriptObject * scriptObject) {
+		bindBasicData(scriptObject, metaService);
+	});
+
+	const int threadCount = 4;
+	std::atomic<int> failedCount(0);
+	std::vector<std::thread> threads;
+	for(int t = 0; t < threadCount; ++t) {
+		threads.push_back(std::thread([&pool, &failedCount, t]() {
+			for(int i = 0; i < 50; ++i) {
+				GLuaPooledStateGuard state(&pool);
+				char code[256];
+				sprintf(code,
+					"assert(a == nil) a = TestObject(%d) b = a.add(1) assert(a.value == %d) assert(b == %d) a.value = 0",
+					t * 1000 + i, t * 1000 + i, t * 1000 + i + 1
+				);
+				if(luaL_dostring(state->getLuaState(), code) != 0) {
+					++failedCount;
+				}
+			}
+		}));
+	}
+	for(std::thread & thread : threads) {
+		thread.join();
+	}
+
+	GEQUAL(0, (int)failedCount);
+	GCHECK(pool.getTotalCount() <= (size_t)threadCount);
+	GEQUAL(pool.getTotalCount(), pool.getIdleCount());
+}
+
+
+}
+
+
+#endif
@@ -55,5 +55,52 @@ void OverloadMethodIndirectInvoke(TestScriptContext * context)
 #include "../testcase_python.h"
 
 
+void ByteArrayBuffer(TestScriptContext * context)
+{
+	QDO(import struct)
+	QDO(cpgf._import("cpgf", "builtin.collections.bytearray"))
+
+	QDO(a = cpgf.createByteArray(16))
+	QASSERT(len(memoryview(a)) == 16)
+
+	QDO(struct.pack_into("i", a, 4, 38))
+	QASSERT(struct.unpack_from("i", a, 4)[0] == 38)
+	QDO(a.setPosition(4))
+	QASSERT(a.readInt32() == 38)
+
+	QDO(a.writeFloat64(1.5))
+	QASSERT(struct.unpack_from("d", a, 8)[0] == 1.5)
+
+	QDO(v = memoryview(a))
+	QERR(a.length = 32)
+	QERR(a.setLength(32))
+	QERR(a.writeInt32(1))
+	QASSERT(a.length == 16)
+	QDO(del v)
+	QDO(a.setLength(32))
+	QASSERT(a.length == 32)
+}
+
+#define CASE ByteArrayBuffer
+#include "../testcase_python.h"
+
+
+// testReleaseScriptLockConcat releases the GIL, so the other thread calls into the same context
+// while the parameters of the first call are still in use.
+void ReleaseScriptLockThreads(TestScriptContext * context)
+{
+	QDO(import threading)
+	QDO(errors = [])
+	DO("def releaseLockWorker(n):\n\tfor i in range(50):\n\t\ts = testReleaseScriptLockConcat('thread%d-' % n, str(i))\n\t\tif s != 'thread%d-%d' % (n, i): errors.append(s)")
+	QDO(threads = [ threading.Thread(target = releaseLockWorker, args = (n,)) for n in range(2) ])
+	QDO(for t in threads: t.start())
+	QDO(for t in threads: t.join())
+	QASSERT(len(errors) == 0)
+}
+
+#define CASE ReleaseScriptLockThreads
+#include "../testcase_python.h"
+
+
 
 }
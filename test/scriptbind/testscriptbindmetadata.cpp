@@ -113,6 +113,7 @@ void bindBasicInfo(T * script, cpgf::IMetaService * service)
 	bindClass(script, service, "testscript::ScriptOverride", "ScriptOverride");
 
 	bindClass(script, service, "testscript::TestObjectLeak", "TestObjectLeak");
+	bindClass(script, service, "testscript::TestReusedAddressObject", "TestReusedAddressObject");
 
 	bindClass(script, service, REG_NAME_BasicA, "BasicA");
 	
@@ -145,6 +146,8 @@ void bindBasicInfo(T * script, cpgf::IMetaService * service)
 	bindMethod(script, service, "scriptAssert", "scriptAssert");
 	bindMethod(script, service, "scriptNot", "scriptNot");
 	bindMethod(script, service, "testExecAddCallback", "testExecAddCallback");
+	bindMethod(script, service, "testRecursiveCallback", "testRecursiveCallback");
+	bindMethod(script, service, "testReleaseScriptLockConcat", "testReleaseScriptLockConcat");
 	
 	bindMethod(script, service, "writeNumberToByteArray", "writeNumberToByteArray");
 	bindMethod(script, service, "writeNumberToByteArrayMemory", "writeNumberToByteArrayMemory");
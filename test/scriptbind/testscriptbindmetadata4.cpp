@@ -5,6 +5,8 @@
 #include "cpgf/metautility/gmetabytearray.h"
 
 #include <iostream>
+#include <thread>
+#include <chrono>
 
 
 using namespace cpgf;
@@ -54,6 +56,22 @@ int testExecAddCallback()
 	return n;
 }
 
+// Return n + (n - 1) + ... + 1, the script function calls back testRecursiveCallback with n - 1.
+int testRecursiveCallback(IScriptFunction * scriptFunction, int n)
+{
+	if(n <= 0) {
+		return 0;
+	}
+	return n + fromVariant<int>(invokeScriptFunction(scriptFunction, n - 1).getValue());
+}
+
+// Registered with GMetaPolicyReleaseScriptLock, the sleep lets other script threads run meanwhile.
+std::string testReleaseScriptLockConcat(const std::string & a, const std::string & b)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	return a + b;
+}
+
 bool testDefaultParam(int type, int i, std::string s, TestObject obj)
 {
 	switch(type) {
@@ -111,6 +129,8 @@ void TestScriptBindMetaData4()
 		._method("testAddCallback2", &testAddCallback2)
 		._method("testAddCallback", &testAddCallback)
 		._method("testExecAddCallback", &testExecAddCallback)
+		._method("testRecursiveCallback", &testRecursiveCallback)
+		._method("testReleaseScriptLockConcat", &testReleaseScriptLockConcat, GMetaPolicyReleaseScriptLock())
 		
 		._method("writeNumberToByteArray", &writeNumberToByteArray)
 		._method("writeNumberToByteArrayMemory", &writeNumberToByteArrayMemory)
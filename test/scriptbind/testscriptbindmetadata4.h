@@ -53,6 +53,8 @@ int testAdd2(int a, int b);
 int testAddN(const cpgf::GMetaVariadicParam * params);
 int testAddCallback(cpgf::IScriptFunction * scriptFunction);
 int testExecAddCallback();
+int testRecursiveCallback(cpgf::IScriptFunction * scriptFunction, int n);
+std::string testReleaseScriptLockConcat(const std::string & a, const std::string & b);
 
 
 
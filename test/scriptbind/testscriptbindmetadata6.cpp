@@ -2,11 +2,26 @@
 #include "bind_common.h"
 #include "cpgf/gmetadefine.h"
 
+#include <new>
+#include <cstddef>
+
 using namespace cpgf;
 using namespace std;
 
 namespace testscript {
 
+namespace {
+
+const size_t reusedAddressSize = 64;
+static_assert(sizeof(TestReusedAddressObject) <= reusedAddressSize, "reusedAddressSize is too small");
+
+alignas(std::max_align_t) char reusedAddressStorage[reusedAddressSize];
+bool reusedAddressInUse = false;
+
+TestReusedAddressObject * unownedReusedAddressObject = nullptr;
+
+} // unnamed namespace
+
 int TestObjectLeak::instanceCount = 0;
 
 TestObjectLeak::TestObjectLeak()
@@ -19,12 +34,78 @@ TestObjectLeak::~TestObjectLeak()
 	--instanceCount;
 }
 
+int TestReusedAddressObject::instanceCount = 0;
+
+void * TestReusedAddressObject::operator new(size_t size)
+{
+	if(reusedAddressInUse) {
+		return ::operator new(size);
+	}
+	reusedAddressInUse = true;
+	return reusedAddressStorage;
+}
+
+void TestReusedAddressObject::operator delete(void * p)
+{
+	if(p == reusedAddressStorage) {
+		reusedAddressInUse = false;
+	}
+	else {
+		::operator delete(p);
+	}
+}
+
+void * TestReusedAddressObject::operator new(size_t /*size*/, void * p)
+{
+	return p;
+}
+
+void TestReusedAddressObject::operator delete(void * /*p*/, void * /*place*/)
+{
+}
+
+TestReusedAddressObject * TestReusedAddressObject::getUnowned()
+{
+	if(unownedReusedAddressObject == nullptr) {
+		unownedReusedAddressObject = new TestReusedAddressObject();
+	}
+	return unownedReusedAddressObject;
+}
+
+void TestReusedAddressObject::deleteUnowned()
+{
+	delete unownedReusedAddressObject;
+	unownedReusedAddressObject = nullptr;
+}
+
+TestReusedAddressObject * TestReusedAddressObject::createOwned()
+{
+	return new TestReusedAddressObject();
+}
+
+TestReusedAddressObject::TestReusedAddressObject()
+{
+	++instanceCount;
+}
+
+TestReusedAddressObject::~TestReusedAddressObject()
+{
+	--instanceCount;
+}
+
 void TestScriptBindMetaData6()
 {
 	GDefineMetaClass<TestObjectLeak>
 		::define("testscript::TestObjectLeak")
 		._constructor<void * ()>()
 	;
+
+	GDefineMetaClass<TestReusedAddressObject>
+		::define("testscript::TestReusedAddressObject")
+		._method("getUnowned", &TestReusedAddressObject::getUnowned)
+		._method("deleteUnowned", &TestReusedAddressObject::deleteUnowned)
+		._method("createOwned", &TestReusedAddressObject::createOwned, GMetaPolicyTransferResultOwnership())
+	;
 }
 
 }
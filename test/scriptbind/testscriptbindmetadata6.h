@@ -29,6 +29,31 @@ public:
 	~TestObjectLeak();
 };
 
+// All instances are allocated at the same address while it's free,
+// so a new object can be returned at the address of a deleted one.
+class TestReusedAddressObject
+{
+public:
+	static int instanceCount;
+
+public:
+	static void * operator new(size_t size);
+	static void operator delete(void * p);
+	// The meta class constructs objects in place.
+	static void * operator new(size_t size, void * p);
+	static void operator delete(void * p, void * place);
+
+	// The object returned by getUnowned is not owned by script, deleteUnowned deletes it.
+	static TestReusedAddressObject * getUnowned();
+	static void deleteUnowned();
+	// The object returned by createOwned is owned by script.
+	static TestReusedAddressObject * createOwned();
+
+public:
+	TestReusedAddressObject();
+	~TestReusedAddressObject();
+};
+
 
 }
 
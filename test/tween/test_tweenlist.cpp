@@ -0,0 +1,149 @@
+#include "test_tween_common.h"
+#include "cpgf/tween/gtweenlist.h"
+#include "cpgf/tween/gtimeline.h"
+#include "cpgf/accessor/gaccessor.h"
+
+#include <vector>
+
+
+using namespace std;
+using namespace cpgf;
+
+namespace {
+
+GTEST(TweenList_easeOncePerTick)
+{
+	int easeCount = 0;
+	float values[4] = {};
+
+	GTweenList tweenList;
+	GTween & tween = tweenList.tween()
+		.ease([&easeCount](const GTweenEaseParam * param) -> GTweenNumber {
+			++easeCount;
+			return param->current / param->total;
+		})
+		.duration(10.0f)
+	;
+	for(int i = 0; i < 4; ++i) {
+		tween.target(createAccessor(nullptr, &values[i], &values[i]), 100.0f * (i + 1));
+	}
+
+	tweenList.tick(5.0f);
+	GEQUAL(1, easeCount);
+	GEQUAL(50.0f, values[0]);
+	GEQUAL(200.0f, values[3]);
+
+	tweenList.tick(5.0f);
+	GEQUAL(2, easeCount);
+	GEQUAL(100.0f, values[0]);
+	GEQUAL(400.0f, values[3]);
+}
+
+struct TweenTestObject
+{
+	float x;
+	float y;
+};
+
+GTEST(TweenList_removeForInstance)
+{
+	TweenTestObject objects[3] = {};
+
+	GTweenList tweenList;
+	GTween * tweens[3];
+	for(int i = 0; i < 3; ++i) {
+		tweens[i] = &tweenList.tween()
+			.target(createAccessor(&objects[i], &TweenTestObject::x, &TweenTestObject::x), 100.0f)
+			.target(createAccessor(&objects[i], &TweenTestObject::y, &TweenTestObject::y), 100.0f)
+			.duration(10.0f)
+		;
+	}
+	// A tween animating an object and a free value.
+	float value = 0;
+	tweenList.tween()
+		.target(createAccessor(&objects[1], &TweenTestObject::y, &TweenTestObject::y), 100.0f)
+		.target(createAccessor(nullptr, &value, &value), 100.0f)
+		.duration(10.0f)
+	;
+	GEQUAL(4, tweenList.getTweenableCount());
+
+	tweenList.removeForInstance(&objects[1]);
+	GEQUAL(3, tweenList.getTweenableCount());
+
+	tweenList.remove(*tweens[2]);
+	GEQUAL(2, tweenList.getTweenableCount());
+	// Not in the list any more.
+	tweenList.remove(*tweens[2]);
+	GEQUAL(2, tweenList.getTweenableCount());
+
+	tweenList.tick(5.0f);
+	GEQUAL(50.0f, objects[0].x);
+	GEQUAL(50.0f, objects[0].y);
+	GEQUAL(0.0f, objects[1].x);
+	GEQUAL(0.0f, objects[1].y);
+	GEQUAL(0.0f, objects[2].x);
+	GEQUAL(50.0f, value);
+
+	tweenList.removeForInstance(&objects[0]);
+	GEQUAL(1, tweenList.getTweenableCount());
+	tweenList.tick(5.0f);
+	GEQUAL(50.0f, objects[0].x);
+	GEQUAL(100.0f, value);
+	GEQUAL(0, tweenList.getTweenableCount());
+}
+
+GTEST(TweenList_removeForInstanceInTimeline)
+{
+	TweenTestObject objects[2] = {};
+
+	GTweenList tweenList;
+	GTimeline & timeline = tweenList.timeline();
+	for(int i = 0; i < 2; ++i) {
+		timeline.append(timeline.tween()
+			.target(createAccessor(&objects[i], &TweenTestObject::x, &TweenTestObject::x), 100.0f)
+			.duration(10.0f)
+		);
+	}
+	GEQUAL(1, tweenList.getTweenableCount());
+	GEQUAL(2, timeline.getTweenableCount());
+
+	tweenList.removeForInstance(&objects[0]);
+	GEQUAL(1, timeline.getTweenableCount());
+	GEQUAL(1, tweenList.getTweenableCount());
+
+	tweenList.tick(15.0f);
+	GEQUAL(0.0f, objects[0].x);
+	GEQUAL(50.0f, objects[1].x);
+
+	tweenList.removeForInstance(&objects[1]);
+	GEQUAL(0, tweenList.getTweenableCount());
+}
+
+GTEST(TweenList_removeInCallback)
+{
+	vector<float> values(10);
+	GTweenList tweenList;
+	vector<GTween *> tweens;
+	for(size_t i = 0; i < values.size(); ++i) {
+		tweens.push_back(&tweenList.tween().target(createAccessor(nullptr, &values[i], &values[i]), 100.0f).duration(10.0f));
+	}
+	// Remove a tween before and a tween after the one being ticked.
+	tweens[5]->onUpdate([&]() {
+		tweenList.remove(*tweens[2]);
+		tweenList.remove(*tweens[8]);
+		tweens[5]->onUpdate(GTweenCallback());
+	});
+
+	tweenList.tick(5.0f);
+	GEQUAL(8, tweenList.getTweenableCount());
+	GEQUAL(50.0f, values[2]);
+	GEQUAL(0.0f, values[8]);
+
+	tweenList.tick(5.0f);
+	GEQUAL(0, tweenList.getTweenableCount());
+	GEQUAL(50.0f, values[2]);
+	GEQUAL(100.0f, values[9]);
+}
+
+
+}
@@ -0,0 +1,74 @@
+#include "test_tween_common.h"
+#include "cpgf/tween/gtweenscheduler.h"
+#include "cpgf/tween/gtweenlist.h"
+#include "cpgf/accessor/gaccessor.h"
+
+#include <vector>
+#include <thread>
+
+
+using namespace std;
+using namespace cpgf;
+
+namespace {
+
+const size_t listCount = 8;
+const size_t tweenCount = 20;
+
+void addTweens(GTweenList * tweenList, vector<float> & values, size_t listIndex, vector<size_t> * completeOrder, vector<std::thread::id> * callbackThreads)
+{
+	for(size_t i = 0; i < values.size(); ++i) {
+		const size_t id = listIndex * tweenCount + i;
+		tweenList->tween()
+			.target(createAccessor(nullptr, &values[i], &values[i]), 100.0f)
+			.duration(2.0f + (float)(i % 5))
+			.onComplete([=]() {
+				completeOrder->push_back(id);
+				callbackThreads->push_back(std::this_thread::get_id());
+			})
+		;
+	}
+}
+
+void runScheduler(int threadCount, bool parallel, vector<size_t> * completeOrder, vector<std::thread::id> * callbackThreads)
+{
+	vector<vector<float> > values(listCount, vector<float>(tweenCount));
+	vector<GTweenList> tweenLists(listCount);
+
+	GTweenScheduler scheduler(threadCount);
+	for(size_t i = 0; i < listCount; ++i) {
+		tweenLists[i].tickInParallel(parallel);
+		addTweens(&tweenLists[i], values[i], i, completeOrder, callbackThreads);
+		scheduler.add(&tweenLists[i]);
+	}
+
+	for(int frame = 0; frame < 10; ++frame) {
+		scheduler.tick(1.0f);
+	}
+
+	for(size_t i = 0; i < listCount; ++i) {
+		GEQUAL(0, tweenLists[i].getTweenableCount());
+		GEQUAL(100.0f, values[i][0]);
+	}
+}
+
+GTEST(TweenScheduler_parallel)
+{
+	vector<size_t> serialOrder;
+	vector<std::thread::id> serialThreads;
+	runScheduler(0, false, &serialOrder, &serialThreads);
+	GEQUAL(listCount * tweenCount, serialOrder.size());
+
+	vector<size_t> parallelOrder;
+	vector<std::thread::id> parallelThreads;
+	runScheduler(3, true, &parallelOrder, &parallelThreads);
+
+	// The callbacks are called on this thread, in the same order as ticking the lists one by one.
+	GCHECK(serialOrder == parallelOrder);
+	for(const std::thread::id & id : parallelThreads) {
+		GCHECK(id == std::this_thread::get_id());
+	}
+}
+
+
+}
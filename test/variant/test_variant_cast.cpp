@@ -191,6 +191,60 @@ GTEST(TestVariant_CastVtStringToStdWideStringReference)
 	GCHECK(*stringPointer == L"abc");
 }
 
+enum TestFundamentalEnum { tfeA = 3 };
+
+template <typename To, typename From>
+bool checkFundamentalCast(const From value)
+{
+	const GVariant v(value);
+	return canFromVariant<To>(v) && fromVariant<To>(v) == (To)value;
+}
+
+template <typename To>
+bool checkFundamentalCastTo()
+{
+	return checkFundamentalCast<To>(true)
+		&& checkFundamentalCast<To>('a')
+		&& checkFundamentalCast<To>(L'b')
+		&& checkFundamentalCast<To>((signed char)-5)
+		&& checkFundamentalCast<To>((unsigned char)200)
+		&& checkFundamentalCast<To>((signed short)-300)
+		&& checkFundamentalCast<To>((unsigned short)60000)
+		&& checkFundamentalCast<To>((signed int)-70000)
+		&& checkFundamentalCast<To>((unsigned int)4000000000u)
+		&& checkFundamentalCast<To>((signed long)-80000)
+		&& checkFundamentalCast<To>((unsigned long)90000)
+		&& checkFundamentalCast<To>((signed long long)-5000000000ll)
+		&& checkFundamentalCast<To>((unsigned long long)0xfedcba9876543210ull)
+		&& checkFundamentalCast<To>(1.5f)
+		&& checkFundamentalCast<To>(2.5)
+		&& checkFundamentalCast<To>((long double)3.5)
+	;
+}
+
+GTEST(TestVariant_CastFundamental)
+{
+	GCHECK(checkFundamentalCastTo<bool>());
+	GCHECK(checkFundamentalCastTo<char>());
+	GCHECK(checkFundamentalCastTo<wchar_t>());
+	GCHECK(checkFundamentalCastTo<signed char>());
+	GCHECK(checkFundamentalCastTo<unsigned char>());
+	GCHECK(checkFundamentalCastTo<signed short>());
+	GCHECK(checkFundamentalCastTo<unsigned short>());
+	GCHECK(checkFundamentalCastTo<signed int>());
+	GCHECK(checkFundamentalCastTo<unsigned int>());
+	GCHECK(checkFundamentalCastTo<signed long>());
+	GCHECK(checkFundamentalCastTo<unsigned long>());
+	GCHECK(checkFundamentalCastTo<signed long long>());
+	GCHECK(checkFundamentalCastTo<unsigned long long>());
+	GCHECK(checkFundamentalCastTo<float>());
+	GCHECK(checkFundamentalCastTo<double>());
+	GCHECK(checkFundamentalCastTo<long double>());
+
+	GEQUAL(tfeA, fromVariant<TestFundamentalEnum>(GVariant(3.0)));
+	GEQUAL(3, fromVariant<const int>(GVariant((unsigned char)3)));
+}
+
 
 
 } }
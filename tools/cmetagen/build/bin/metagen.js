@@ -34,6 +34,10 @@ var config = {
 			+ cppInclude("../../../../include")
 			+ cppInclude("../../src")
 	,
+
+	// precompiledHeader is a clang PCH of the includes shared by all files, such as clang and cpgf headers.
+	// Build it with "clang -cc1 -emit-pch" and the same clangOptions. The path is relative to the project file.
+	// precompiledHeader : "metagen.pch",
 	
 	files : [
 		"project.h",
@@ -53,6 +57,18 @@ var config = {
 	force : false,
 	
 	stopOnCompileError : false,
+
+	// Register the methods, fields and constructors from a static table instead of a chain of _method/_field calls.
+	// It compiles and registers faster. Methods with default parameters are still chained.
+	// memberTable : true,
+
+	// How many files are parsed at the same time, 0 to use all hardware threads.
+	// It can be overridden by --jobs=N or -jN in the command line.
+	jobs : 1,
+
+	// The file remembering the hash of each generated file, unchanged files are skipped.
+	// Default is metagen.cache in headerOutputPath.
+	// cacheFile : "metagen.cache",
 	
 	fileCallback : onFileCallback,
 	mainCallback : onMainCallback,
@@ -13,8 +13,10 @@
 #include "util.h"
 #include "constants.h"
 #include "commandlineparser.h"
+#include "generatecache.h"
 
 #include "cpgf/gexception.h"
+#include "cpgf/gscopedptr.h"
 
 #include "Poco/Glob.h"
 #include "Poco/File.h"
@@ -26,6 +28,10 @@
 
 #include <iostream>
 #include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 using namespace std;
 using namespace cpgf;
@@ -33,7 +39,25 @@ using namespace cpgf;
 namespace metagen {
 
 
+class SourceFileTask
+{
+public:
+	SourceFileTask(const std::string & fileName, const std::string & absoluteFileName)
+		: fileName(fileName), sourceFile(absoluteFileName), hash(), context(), error() {
+	}
+
+public:
+	std::string fileName;
+	CppSourceFile sourceFile;
+	std::string hash;
+	// Keeps the clang AST alive until the file is built.
+	GScopedPointer<CppContext> context;
+	std::exception_ptr error;
+};
+
+
 Application::Application()
+	: project(), generateCache(), creationFunctionNameList()
 {
 }
 
@@ -68,7 +92,17 @@ void Application::doRun(int argc, char * argv[])
 	CommandLineParser commandLineParser(&this->project);
 	commandLineParser.parse(argc, argv);
 
-	this->processFiles();
+	this->generateCache.reset(new GenerateCache(&this->project));
+	this->generateCache->load();
+	try {
+		this->processFiles();
+	}
+	catch(...) {
+		// Keep the files generated before the error.
+		this->generateCache->save();
+		throw;
+	}
+	this->generateCache->save();
 
 	getLogger().info("Generating main register file...");
 	globFiles(this->project.getHeaderOutputPath(), "*" + this->project.getHeaderFileExtension(),
@@ -79,14 +113,29 @@ void Application::doRun(int argc, char * argv[])
 
 void Application::processFiles()
 {
+	TaskListType taskList;
 	for(StringArrayType::const_iterator it = this->project.getFiles().begin();
 		it != this->project.getFiles().end();
 		++it) {
-		this->processOnePath(Poco::Path(*it).makeAbsolute(Poco::Path(this->project.getSourceRootPath())).toString());
+		this->processOnePath(Poco::Path(*it).makeAbsolute(Poco::Path(this->project.getSourceRootPath())).toString(), &taskList);
+	}
+
+	const size_t jobCount = this->project.getJobCount();
+	if(jobCount > 1 && taskList.size() > 1) {
+		this->processTasksInParallel(taskList, jobCount);
+	}
+	else {
+		for(TaskListType::iterator it = taskList.begin(); it != taskList.end(); ++it) {
+			getLogger().info(Poco::format("Generate for fileName %s...", (*it)->fileName));
+			this->parseTask(it->get());
+			this->buildTask(it->get());
+			it->reset();
+			getLogger().print("done.\n");
+		}
 	}
 }
 
-void Application::processOnePath(const std::string & path)
+void Application::processOnePath(const std::string & path, TaskListType * taskList)
 {
 	set<string> fileSet;
 	string absolutePath = this->project.getAbsoluteFileName(path);
@@ -100,43 +149,150 @@ void Application::processOnePath(const std::string & path)
 			continue;
 		}
 		else {
-			this->processOneFile(*it);
+			SourceFileTask * task = this->createTask(*it);
+			if(task != NULL) {
+				taskList->push_back(std::unique_ptr<SourceFileTask>(task));
+			}
 		}
 	}
 }
 
-void Application::processOneFile(const std::string & fileName)
+// Returns NULL if the file doesn't need to be generated.
+SourceFileTask * Application::createTask(const std::string & fileName)
 {
 	string absoluteFileName = this->project.getAbsoluteFileName(fileName);
-	CppSourceFile sourceFile(absoluteFileName);
+	std::unique_ptr<SourceFileTask> task(new SourceFileTask(fileName, absoluteFileName));
 
-	this->project.processFileByScript(&sourceFile);
+	this->project.processFileByScript(&task->sourceFile);
 
-	if(sourceFile.shouldSkipBind()) {
+	if(task->sourceFile.shouldSkipBind()) {
 		getLogger().info(Poco::format("File %s is skipped by script.\n", fileName));
-		return;
+		return NULL;
 	}
 
 	if(isFileAutoGenerated(fileName)) {
 		getLogger().info(Poco::format("File %s is auto generated, skipped.\n", fileName));
-		return;
+		return NULL;
+	}
+
+	task->hash = this->generateCache->computeHash(task->sourceFile);
+	if(! this->project.doesForce()
+		&& this->generateCache->isUpToDate(absoluteFileName, task->hash)
+		&& Poco::File(this->project.getOutputHeaderFileName(fileName)).exists()) {
+		getLogger().info(Poco::format("File %s is up to date, skipped.\n", fileName));
+		return NULL;
+	}
+
+	return task.release();
+}
+
+// Only parses with clang, so it can run on any thread.
+void Application::parseTask(SourceFileTask * task)
+{
+	task->context.reset(new CppContext(&this->project));
+	task->context->process(task->sourceFile);
+}
+
+// Invokes the script callbacks and writes the files, it must run on the main thread.
+void Application::buildTask(SourceFileTask * task)
+{
+	// The output files are only written if the content changes, to not trigger recompiling them.
+	BuilderContext builderContext(&this->project, task->sourceFile, false);
+	builderContext.process(task->context.get());
+
+	this->generateCache->update(task->sourceFile.getFileName(), task->hash);
+}
+
+// The files are parsed on jobCount threads, each with its own clang compiler instance.
+// They are built on this thread in the same order as a sequential run, so the script
+// callbacks are never invoked concurrently and the output doesn't depend on the job count.
+// To bound the memory used by the parsed ASTs, the parsing can only be jobCount * 2 files
+// ahead of the building.
+void Application::processTasksInParallel(const TaskListType & taskList, size_t jobCount)
+{
+	const size_t taskCount = taskList.size();
+	const size_t maxPendingCount = jobCount * 2;
+
+	std::mutex taskMutex;
+	std::condition_variable taskCondition;
+	size_t nextIndex = 0;
+	size_t builtCount = 0;
+	std::vector<char> parsedFlags(taskCount, 0);
+	bool stopped = false;
+
+	std::vector<std::thread> threadList;
+	for(size_t i = 0; i < jobCount; ++i) {
+		threadList.push_back(std::thread([&]() {
+			for(;;) {
+				size_t index;
+				{
+					std::unique_lock<std::mutex> lock(taskMutex);
+					taskCondition.wait(lock, [&]() {
+						return stopped || nextIndex >= taskCount || nextIndex < builtCount + maxPendingCount;
+					});
+					if(stopped || nextIndex >= taskCount) {
+						return;
+					}
+					index = nextIndex++;
+				}
+
+				SourceFileTask * task = taskList[index].get();
+				try {
+					this->parseTask(task);
+				}
+				catch(...) {
+					task->error = std::current_exception();
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(taskMutex);
+					parsedFlags[index] = 1;
+				}
+				taskCondition.notify_all();
+			}
+		}));
 	}
 
-	string outputHeaderFileName = this->project.getOutputHeaderFileName(fileName);
-	bool shouldUpdate = shouldTargetFileBeUpdated(fileName, outputHeaderFileName);
-	if(shouldUpdate || this->project.doesForce()) {
-		getLogger().info(Poco::format("Generate for fileName %s...", fileName));
+	std::exception_ptr error;
+	for(size_t i = 0; i < taskCount && ! error; ++i) {
+		{
+			std::unique_lock<std::mutex> lock(taskMutex);
+			taskCondition.wait(lock, [&]() { return parsedFlags[i] != 0; });
+		}
 
-		CppContext context(&this->project);
-		context.process(sourceFile);
+		SourceFileTask * task = taskList[i].get();
+		if(task->error) {
+			error = task->error;
+		}
+		else {
+			try {
+				this->buildTask(task);
+				getLogger().info(Poco::format("Generate for fileName %s...done.\n", task->fileName));
+			}
+			catch(...) {
+				error = std::current_exception();
+			}
+		}
+		task->context.reset();
 
-		BuilderContext builderContext(&this->project, sourceFile, shouldUpdate);
-		builderContext.process(&context);
+		{
+			std::lock_guard<std::mutex> lock(taskMutex);
+			++builtCount;
+		}
+		taskCondition.notify_all();
+	}
 
-		getLogger().print("done.\n");
+	{
+		std::lock_guard<std::mutex> lock(taskMutex);
+		stopped = true;
 	}
-	else {
-		getLogger().info(Poco::format("File %s is up to date, skipped.\n", fileName));
+	taskCondition.notify_all();
+	for(std::vector<std::thread>::iterator it = threadList.begin(); it != threadList.end(); ++it) {
+		it->join();
+	}
+
+	if(error) {
+		std::rethrow_exception(error);
 	}
 }
 
@@ -3,18 +3,25 @@
 
 #include "project.h"
 
+#include "cpgf/gscopedptr.h"
+
 #include <string>
 #include <set>
+#include <vector>
+#include <memory>
 
 namespace metagen {
 
 class BuilderSection;
 class BuilderContext;
+class SourceFileTask;
+class GenerateCache;
 
 class Application
 {
 private:
 	typedef std::set<std::string> CreationFunctionNameListType;
+	typedef std::vector<std::unique_ptr<SourceFileTask> > TaskListType;
 
 public:
 	Application();
@@ -25,14 +32,18 @@ public:
 private:
 	void doRun(int argc, char * argv[]);
 	void processFiles();
-	void processOnePath(const std::string & path);
-	void processOneFile(const std::string & fileName);
+	void processOnePath(const std::string & path, TaskListType * taskList);
+	SourceFileTask * createTask(const std::string & fileName);
+	void parseTask(SourceFileTask * task);
+	void buildTask(SourceFileTask * task);
+	void processTasksInParallel(const TaskListType & taskList, size_t jobCount);
 
 	void loadCreationFunctionsFromFile(const std::string & fileName);
 	void onGenerateCreationFunction(const std::string & creationFunctionName);
 
 private:	
 	Project project;
+	cpgf::GScopedPointer<GenerateCache> generateCache;
 	CreationFunctionNameListType creationFunctionNameList;
 };
 
@@ -199,7 +199,7 @@ public:
 		projectOptionMap->insert(make_pair(fieldName, projectOption));
 
 		this->optionSet->addOption(
-			Option(fieldName, "", "")
+			Option(fieldName, fieldName == scriptFieldJobs ? "j" : "", "")
 				.required(false)
 				.repeatable(false)
 				.argument("argument")
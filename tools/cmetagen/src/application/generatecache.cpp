@@ -0,0 +1,134 @@
+#include "generatecache.h"
+
+#include "model/cppsourcefile.h"
+#include "project.h"
+#include "logger.h"
+#include "util.h"
+
+#include "Poco/SHA1Engine.h"
+#include "Poco/DigestEngine.h"
+#include "Poco/File.h"
+#include "Poco/Path.h"
+#include "Poco/Format.h"
+
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+namespace metagen {
+
+namespace {
+
+// Increase it when the generated code changes, so all files are generated again.
+const string cacheFileMark = "cmetagen cache 1";
+
+string hashString(const string & s)
+{
+	Poco::SHA1Engine engine;
+	engine.update(s);
+	return Poco::DigestEngine::digestToHex(engine.digest());
+}
+
+void appendStringList(string * text, const vector<string> & stringList)
+{
+	for(vector<string>::const_iterator it = stringList.begin(); it != stringList.end(); ++it) {
+		text->append(*it);
+		text->push_back('\n');
+	}
+	text->push_back('\0');
+}
+
+} // unnamed namespace
+
+
+GenerateCache::GenerateCache(const Project * project)
+	:
+		rootPath(project->getProjectRootPath()),
+		cacheFileName(project->getCacheFileName()),
+		configurationHash(hashString(project->getConfigurationText())),
+		hashMap(),
+		changed(false)
+{
+}
+
+void GenerateCache::load()
+{
+	ifstream file(this->cacheFileName.c_str());
+	string line;
+	if(! getline(file, line) || line != cacheFileMark) {
+		return;
+	}
+	if(! getline(file, line) || line != this->configurationHash) {
+		getLogger().info("Project configuration is changed, all files will be generated.\n");
+		return;
+	}
+
+	while(getline(file, line)) {
+		const size_t pos = line.find(' ');
+		if(pos != string::npos) {
+			this->hashMap[line.substr(pos + 1)] = line.substr(0, pos);
+		}
+	}
+}
+
+void GenerateCache::save()
+{
+	if(! this->changed) {
+		return;
+	}
+
+	Poco::File(Poco::Path(this->cacheFileName).parent()).createDirectories();
+
+	string content;
+	content.append(cacheFileMark + "\n");
+	content.append(this->configurationHash + "\n");
+	for(HashMapType::const_iterator it = this->hashMap.begin(); it != this->hashMap.end(); ++it) {
+		content.append(it->second + " " + it->first + "\n");
+	}
+
+	if(! writeStringToFile(this->cacheFileName, content)) {
+		getLogger().warn(Poco::format("Can't write cache file %s.\n", this->cacheFileName));
+	}
+	this->changed = false;
+}
+
+std::string GenerateCache::computeHash(const CppSourceFile & sourceFile) const
+{
+	string text;
+	readStringFromFile(sourceFile.getFileName(), &text);
+	text.push_back('\0');
+	appendStringList(&text, sourceFile.getIncludeList());
+	appendStringList(&text, sourceFile.getMetaIncludeList());
+	text.append(this->configurationHash);
+
+	return hashString(text);
+}
+
+bool GenerateCache::isUpToDate(const std::string & fileName, const std::string & hash) const
+{
+	HashMapType::const_iterator it = this->hashMap.find(this->makeKey(fileName));
+	return it != this->hashMap.end() && it->second == hash;
+}
+
+void GenerateCache::update(const std::string & fileName, const std::string & hash)
+{
+	string & value = this->hashMap[this->makeKey(fileName)];
+	if(value != hash) {
+		value = hash;
+		this->changed = true;
+	}
+}
+
+// The files in the project are relative, so the cache is still valid if the project is checked out to another place.
+std::string GenerateCache::makeKey(const std::string & fileName) const
+{
+	if(! this->rootPath.empty() && fileName.compare(0, this->rootPath.size(), this->rootPath) == 0) {
+		return fileName.substr(this->rootPath.size());
+	}
+	return fileName;
+}
+
+
+} // namespace metagen
+
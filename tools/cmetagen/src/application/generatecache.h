@@ -0,0 +1,46 @@
+#ifndef CPGF_GENERATECACHE_H
+#define CPGF_GENERATECACHE_H
+
+#include <string>
+#include <map>
+
+namespace metagen {
+
+class Project;
+class CppSourceFile;
+
+// Remembers a hash of each source file generated last time, so a file which is not changed
+// is skipped without parsing, even if its time stamp changed or the files are checked out again.
+// The hash covers the file content, the includes added by the script and the project configuration.
+// Changes in the headers included by the file are not detected, use --force for them.
+class GenerateCache
+{
+private:
+	typedef std::map<std::string, std::string> HashMapType;
+
+public:
+	explicit GenerateCache(const Project * project);
+
+	void load();
+	void save();
+
+	std::string computeHash(const CppSourceFile & sourceFile) const;
+	bool isUpToDate(const std::string & fileName, const std::string & hash) const;
+	void update(const std::string & fileName, const std::string & hash);
+
+private:
+	std::string makeKey(const std::string & fileName) const;
+
+private:
+	std::string rootPath;
+	std::string cacheFileName;
+	std::string configurationHash;
+	HashMapType hashMap;
+	bool changed;
+};
+
+
+} // namespace metagen
+
+
+#endif
@@ -7,6 +7,7 @@
 #include "model/cppconstructor.h"
 #include "model/cppcontainer.h"
 #include "model/cppclass.h"
+#include "project.h"
 
 #include "Poco/Format.h"
 
@@ -46,6 +47,16 @@ void BuilderConstructor::doWriterReflection(BuilderWriter * writer)
 	if(static_cast<const CppClass *>(cppConstructor->getParent())->isAbstract()) {
 		return;
 	}
+
+	if(writer->getProject()->shouldUseMemberTable()) {
+		writer->getParentMemberTableCodeBlock(cppConstructor)->appendLine(Poco::format("cpgf::metaTableConstructor<%s, void * (%s)%s>(),",
+			getReflectionClassName(writer->getProject(), true),
+			cppConstructor->getTextOfParamList(itoWithArgType),
+			getInvokablePolicyTypeText(cppConstructor, true)
+		));
+		return;
+	}
+
 	CodeBlock * codeBlock = writer->getParentReflectionCodeBlock(cppConstructor);
 	this->doWriterReflectionCode(writer, codeBlock);
 }
@@ -57,6 +57,17 @@ void BuilderField::doWriteMetaData(BuilderWriter * writer)
 void BuilderField::doWriteReflection(BuilderWriter * writer)
 {
 	const CppField * cppField = this->getCppField();
+
+	if(this->getProject()->shouldUseMemberTable()) {
+		const string address = Poco::format("&%s%s", getReflectionScope(cppField, false), cppField->getName());
+		writer->getParentMemberTableCodeBlock(cppField)->appendLine(Poco::format("cpgf::metaTableField<decltype(%s), %s>(\"%s\"),",
+			address,
+			address,
+			cppField->getName()
+		));
+		return;
+	}
+
 	CodeBlock * codeBlock = writer->getParentReflectionCodeBlock(cppField);
 
 	std::string s = Poco::format("%s(\"%s\", &%s%s);",
@@ -28,16 +28,21 @@ bool BuilderInvokable::doCanBind() const
 
 std::string getInvokablePolicyText(const CppInvokable * cppInvokable, bool prefixWithComma)
 {
-	CppPolicy cppPolicy;
-
-	cppInvokable->getPolicy(&cppPolicy);
-
-	string s = cppPolicy.getTextOfMakePolicy(prefixWithComma);
+	string s = getInvokablePolicyTypeText(cppInvokable, prefixWithComma);
 	if(! s.empty()) {
 		s.append("()");
 	}
 	return s;
 }
 
+std::string getInvokablePolicyTypeText(const CppInvokable * cppInvokable, bool prefixWithComma)
+{
+	CppPolicy cppPolicy;
+
+	cppInvokable->getPolicy(&cppPolicy);
+
+	return cppPolicy.getTextOfMakePolicy(prefixWithComma);
+}
+
 
 } // namespace metagen
@@ -22,6 +22,8 @@ protected:
 };
 
 std::string getInvokablePolicyText(const CppInvokable * cppInvokable, bool prefixWithComma);
+// The policy type without (), empty if there is no policy.
+std::string getInvokablePolicyTypeText(const CppInvokable * cppInvokable, bool prefixWithComma);
 
 } // namespace metagen
 
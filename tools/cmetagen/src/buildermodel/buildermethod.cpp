@@ -17,6 +17,8 @@ namespace metagen {
 
 
 void writeMethodReflection(const CppMethod * cppMethod, BuilderWriter * writer);
+bool canWriteMethodMemberTableEntry(const CppMethod * cppMethod, BuilderWriter * writer);
+void writeMethodMemberTableEntry(const CppMethod * cppMethod, BuilderWriter * writer);
 void writeMethodDefaultParameterReflection(const CppMethod * cppMethod, CodeBlock * codeBlock);
 void writeMethodReflectionCode(const CppMethod * cppMethod, BuilderWriter * writer, CodeBlock * codeBlock,
 										   const string & methodName);
@@ -62,10 +64,56 @@ void BuilderMethod::doWriteMetaData(BuilderWriter * writer)
 
 void writeMethodReflection(const CppMethod * cppMethod, BuilderWriter * writer)
 {
+	if(canWriteMethodMemberTableEntry(cppMethod, writer)) {
+		writeMethodMemberTableEntry(cppMethod, writer);
+		return;
+	}
+
 	CodeBlock * codeBlock = writer->getParentReflectionCodeBlock(cppMethod);
 	writeMethodReflectionCode(cppMethod, writer, codeBlock, cppMethod->getName());
 }
 
+// Default parameters are added by the chain, and the function type must be known to select an overload.
+bool canWriteMethodMemberTableEntry(const CppMethod * cppMethod, BuilderWriter * writer)
+{
+	if(! writer->getProject()->shouldUseMemberTable()) {
+		return false;
+	}
+
+	const size_t arity = cppMethod->getArity();
+	if(arity > 0 && cppMethod->paramHasDefaultValue(arity - 1)) {
+		return false;
+	}
+
+	if(cppMethod->isOverloaded() && cppMethod->hasTemplateDependentParam()) {
+		return false;
+	}
+
+	return true;
+}
+
+void writeMethodMemberTableEntry(const CppMethod * cppMethod, BuilderWriter * writer)
+{
+	CodeBlock * codeBlock = writer->getParentMemberTableCodeBlock(cppMethod);
+
+	const string address = Poco::format("&%s%s", getReflectionScope(cppMethod, false), cppMethod->getName());
+	string functionType;
+	if(cppMethod->isOverloaded()) {
+		functionType = cppMethod->getTextOfPointeredType(true);
+	}
+	else {
+		functionType = Poco::format("decltype(%s)", address);
+	}
+
+	codeBlock->appendLine(Poco::format("cpgf::metaTableMethod<%s, %s, %s%s>(\"%s\"),",
+		getReflectionClassName(writer->getProject(), true),
+		functionType,
+		address,
+		getInvokablePolicyTypeText(cppMethod, true),
+		cppMethod->getName()
+	));
+}
+
 void writeMethodClassWrapper(const CppMethod * cppMethod, BuilderWriter * writer, const CppContainer * container)
 {
 	CodeBlock * codeBlock = writer->getClassWrapperCodeBlock(cppMethod, container);
@@ -24,6 +24,7 @@ const std::string CodeBlockName_FunctionHeader("fheader");
 const std::string CodeBlockName_FunctionBody("fbody");
 const std::string CodeBlockName_ClassBody("cbody");
 const std::string CodeBlockName_Customize("customize");
+const std::string CodeBlockName_MemberTable("membertable");
 
 std::string getTextOfVisibility(ItemVisibility visibility);
 
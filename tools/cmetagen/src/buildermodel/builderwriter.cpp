@@ -150,6 +150,18 @@ CodeBlock * BuilderWriter::getContainerReflectionCodeBlock(const CppContainer *
 	return this->getReflectionBodyBlock(section->getCodeBlock())->getNamedBlock(ItemNames[cppContainer->getCategory()], cbsTailEmptyLine);
 }
 
+CodeBlock * BuilderWriter::getParentMemberTableCodeBlock(const CppItem * cppItem)
+{
+	BuilderSection * section = this->getReflectionContainerSection(cppItem->getParent(), cppItem);
+	CodeBlock * tableBlock = this->getReflectionBodyBlock(section->getCodeBlock())->getNamedBlock(CodeBlockName_MemberTable, cbsTailEmptyLine);
+
+	tableBlock->appendUniqueLine("static constexpr cpgf::GMetaMemberDescriptor _m3mBeRs[] =");
+	CodeBlock * entryBlock = tableBlock->getNamedBlock(CodeBlockName_MemberTable, cbsBracketWithSemicolon | cbsIndent);
+	tableBlock->appendUniqueLine(this->getReflectionAction("_members") + "(_m3mBeRs);");
+
+	return entryBlock;
+}
+
 CodeBlock * BuilderWriter::getClassWrapperCodeBlock(const CppItem * cppItem, const CppContainer * container)
 {
 	BuilderSection * section = this->getClassWrapperSection(container);
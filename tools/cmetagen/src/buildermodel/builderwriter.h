@@ -41,6 +41,8 @@ public: // auxiliary functions used by BuilderItem's
 	CodeBlock * createBitFieldWrapperCodeBlock(const CppItem * cppItem);
 	CodeBlock * getParentReflectionCodeBlock(const CppItem * cppItem, BuilderSection ** outSection = NULL);
 	CodeBlock * getContainerReflectionCodeBlock(const CppContainer * cppContainer);
+	// The entries of the static member table in the reflection function, one entry per line.
+	CodeBlock * getParentMemberTableCodeBlock(const CppItem * cppItem);
 	
 	CodeBlock * getClassWrapperCodeBlock(const CppItem * cppItem, const CppContainer * container);
 	CodeBlock * getClassWrapperParentReflectionCodeBlock(const CppItem * cppItem, const CppContainer * container);
@@ -23,6 +23,7 @@ const std::string scriptFieldTemplateInstantiations("templateInstantiations");
 const std::string scriptFieldFileCallback("fileCallback");
 const std::string scriptFieldMainCallback("mainCallback");
 const std::string scriptFieldHeaderReplaceCallback("headerReplaceCallback");
+const std::string scriptFieldJobs("jobs");
 
 } // namespace metagen
 
@@ -1,12 +1,14 @@
 #include "logger.h"
 
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
 namespace metagen {
 
 Logger logger;
+mutex logMutex;
 
 const Logger & getLogger()
 {
@@ -30,11 +32,14 @@ void Logger::warn(const std::string & message) const
 
 void Logger::error(const std::string & message) const
 {
+	lock_guard<mutex> lockGuard(logMutex);
 	cerr << message;
 }
 
 void Logger::doLog(LogLevel /*level*/, const std::string & message) const
 {
+	// The parsing threads may log at the same time.
+	lock_guard<mutex> lockGuard(logMutex);
 	cout << message;
 }
 
@@ -42,6 +42,7 @@ void buildMetaClass_metagen_Project(D_d & _d)
     _d.CPGF_MD_TEMPLATE _field("sourceRootPath", &D_d::ClassType::sourceRootPath);
     _d.CPGF_MD_TEMPLATE _field("files", &D_d::ClassType::files);
     _d.CPGF_MD_TEMPLATE _field("clangOptions", &D_d::ClassType::clangOptions);
+    _d.CPGF_MD_TEMPLATE _field("precompiledHeader", &D_d::ClassType::precompiledHeader);
     _d.CPGF_MD_TEMPLATE _field("cppNamespace", &D_d::ClassType::cppNamespace);
     _d.CPGF_MD_TEMPLATE _field("maxItemCountPerFile", &D_d::ClassType::maxItemCountPerFile);
     _d.CPGF_MD_TEMPLATE _field("headerIncludePrefix", &D_d::ClassType::headerIncludePrefix);
@@ -62,11 +63,14 @@ void buildMetaClass_metagen_Project(D_d & _d)
     _d.CPGF_MD_TEMPLATE _field("metaNamespace", &D_d::ClassType::metaNamespace);
     _d.CPGF_MD_TEMPLATE _field("wrapOperator", &D_d::ClassType::wrapOperator);
     _d.CPGF_MD_TEMPLATE _field("wrapBitFields", &D_d::ClassType::wrapBitFields);
+    _d.CPGF_MD_TEMPLATE _field("memberTable", &D_d::ClassType::memberTable);
     _d.CPGF_MD_TEMPLATE _field("allowPublic", &D_d::ClassType::allowPublic);
     _d.CPGF_MD_TEMPLATE _field("allowProtected", &D_d::ClassType::allowProtected);
     _d.CPGF_MD_TEMPLATE _field("allowPrivate", &D_d::ClassType::allowPrivate);
     _d.CPGF_MD_TEMPLATE _field("force", &D_d::ClassType::force);
     _d.CPGF_MD_TEMPLATE _field("stopOnCompileError", &D_d::ClassType::stopOnCompileError);
+    _d.CPGF_MD_TEMPLATE _field("jobs", &D_d::ClassType::jobs);
+    _d.CPGF_MD_TEMPLATE _field("cacheFile", &D_d::ClassType::cacheFile);
     _d.CPGF_MD_TEMPLATE _field("fileCallback", &D_d::ClassType::fileCallback);
     _d.CPGF_MD_TEMPLATE _field("mainCallback", &D_d::ClassType::mainCallback);
     _d.CPGF_MD_TEMPLATE _field("headerReplaceCallback", &D_d::ClassType::headerReplaceCallback);
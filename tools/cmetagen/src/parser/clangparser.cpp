@@ -117,6 +117,10 @@ void ParserLibClang::setupClang(const CppSourceFile & sourceFile)
 	if(! this->project->getClangOptions().empty()) {
 		splitCommandLine(&commands, this->project->getClangOptions().c_str());
 	}
+	if(! this->project->getPrecompiledHeader().empty()) {
+		commands.push_back("-include-pch");
+		commands.push_back(this->project->getAbsoluteFileName(this->project->getPrecompiledHeader()));
+	}
 	for(vector<string>::const_iterator it = sourceFile.getIncludeList().begin();
 		it != sourceFile.getIncludeList().end();
 		++it) {
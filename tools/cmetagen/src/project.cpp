@@ -66,6 +66,7 @@
 #pragma warning(disable: 4127)
 #endif
 
+#include <thread>
 
 using namespace std;
 using namespace cpgf;
@@ -393,6 +394,7 @@ Project::Project()
 		sourceRootPath(""),
 
 		clangOptions(),
+		precompiledHeader(),
 
 		cppNamespace("metadata"),
 		
@@ -421,6 +423,7 @@ Project::Project()
 		
 		wrapOperator(true),
 		wrapBitFields(true),
+		memberTable(false),
 
 		allowPublic(true),
 		allowProtected(false),
@@ -430,6 +433,10 @@ Project::Project()
 
 		stopOnCompileError(false),
 
+		jobs(1),
+
+		cacheFile(),
+
 		templateInstantiationRepository(new BuilderTemplateInstantiationRepository),
 
 		implement(new ProjectImplement)
@@ -460,6 +467,19 @@ const std::string & Project::getClangOptions() const
 	return this->clangOptions;
 }
 
+const std::string & Project::getPrecompiledHeader() const
+{
+	return this->precompiledHeader;
+}
+
+std::string Project::getCacheFileName() const
+{
+	if(! this->cacheFile.empty()) {
+		return this->getAbsoluteFileName(this->cacheFile);
+	}
+	return this->getAbsoluteFileName(normalizePath(this->getHeaderOutputPath()) + "metagen.cache");
+}
+
 const std::string & Project::getCppNamespace() const
 {
 	return this->cppNamespace;
@@ -558,6 +578,11 @@ bool Project::shouldWrapBitFields() const
 	return this->wrapBitFields;
 }
 
+bool Project::shouldUseMemberTable() const
+{
+	return this->memberTable;
+}
+
 bool Project::doesAllowPublic() const
 {
 	return this->allowPublic;
@@ -583,6 +608,16 @@ bool Project::shouldStopOnCompileError() const
 	return this->stopOnCompileError;
 }
 
+size_t Project::getJobCount() const
+{
+	if(this->jobs > 0) {
+		return (size_t)this->jobs;
+	}
+
+	const unsigned int threadCount = std::thread::hardware_concurrency();
+	return threadCount > 0 ? threadCount : 1;
+}
+
 const BuilderTemplateInstantiationRepository * Project::getTemplateInstantiationRepository() const
 {
 	return this->templateInstantiationRepository.get();
@@ -638,6 +673,35 @@ std::string Project::getOutputSourceFileName(const std::string & sourceFileName,
 	return this->doGetOutputFileName(sourceFileName, fileIndex, true);
 }
 
+std::string Project::getConfigurationText() const
+{
+	string text;
+	readStringFromFile(this->projectFileName, &text);
+
+	// The files are not included, the cache is per file.
+	// jobs, force and cacheFile don't change the generated code.
+	const string options[] = {
+		this->getProjectID(), this->getSourceRootPath(), this->getClangOptions(), this->getPrecompiledHeader(),
+		this->getCppNamespace(), Poco::format("%z", this->getMaxItemCountPerFile()),
+		this->getHeaderIncludePrefix(), this->getHeaderFileExtension(), this->getSourceFileExtension(),
+		this->getHeaderOutputPath(), this->getSourceOutputPath(), this->getTargetFilePrefix(),
+		Poco::format("%b", this->shouldIncludeExtensionInFileName()),
+		this->getReflectionFunctionPrefix(), this->getCreationFunctionPrefix(), this->getMetaDefineParamName(),
+		this->getClassWrapperPostfix(), this->getClassWrapperSuperPrefix(),
+		this->getMainRegisterFunctionName(), this->getMainRegisterFileName(),
+		Poco::format("%b", this->shouldAutoRegisterToGlobal()), this->getMetaNamespace(),
+		Poco::format("%b %b %b", this->shouldWrapOperator(), this->shouldWrapBitFields(), this->shouldUseMemberTable()),
+		Poco::format("%b %b %b", this->doesAllowPublic(), this->doesAllowProtected(), this->doesAllowPrivate()),
+		Poco::format("%b", this->shouldStopOnCompileError())
+	};
+	for(size_t i = 0; i < sizeof(options) / sizeof(options[0]); ++i) {
+		text.push_back('\0');
+		text.append(options[i]);
+	}
+
+	return text;
+}
+
 void Project::processFileByScript(CppSourceFile * sourceFile) const
 {
 	if(this->fileCallback) {
@@ -52,6 +52,8 @@ public:
 
 	const StringArrayType & getFiles() const;
 	const std::string & getClangOptions() const;
+	const std::string & getPrecompiledHeader() const;
+	std::string getCacheFileName() const;
 
 	const std::string & getCppNamespace() const;
 
@@ -79,6 +81,7 @@ public:
 	
 	bool shouldWrapOperator() const;
 	bool shouldWrapBitFields() const;
+	bool shouldUseMemberTable() const;
 
 	bool doesAllowPublic() const;
 	bool doesAllowProtected() const;
@@ -87,6 +90,9 @@ public:
 	bool doesForce() const;
 
 	bool shouldStopOnCompileError() const;
+
+	// At least 1. jobs <= 0 means the number of the hardware threads.
+	size_t getJobCount() const;
 	
 	const BuilderTemplateInstantiationRepository * getTemplateInstantiationRepository() const;
 
@@ -103,6 +109,9 @@ public:
 	std::string getOutputHeaderFileName(const std::string & sourceFileName) const;
 	std::string getOutputSourceFileName(const std::string & sourceFileName, int fileIndex) const;
 
+	// All the options which affect the generated code, and the project file content.
+	std::string getConfigurationText() const;
+
 	void processFileByScript(CppSourceFile * sourceFile) const;
 	void processBuilderItemByScript(BuilderItem * builderItem) const;
 	std::string replaceHeaderByScript(const std::string & fileName) const;
@@ -124,6 +133,8 @@ private:
 
 	StringArrayType files;
 	std::string clangOptions;
+	// A clang precompiled header of the includes common to all files, passed with -include-pch.
+	std::string precompiledHeader;
 
 	std::string cppNamespace;
 	
@@ -151,6 +162,9 @@ private:
 
 	bool wrapOperator;
 	bool wrapBitFields;
+	// Register the methods, fields and constructors from a static cpgf::GMetaMemberDescriptor table
+	// instead of a chain of _method/_field/_constructor, see cpgf/gmetamembertable.h
+	bool memberTable;
 
 	bool allowPublic;
 	bool allowProtected;
@@ -160,6 +174,13 @@ private:
 
 	bool stopOnCompileError;
 
+	// The number of files parsed at the same time.
+	int jobs;
+
+	// The file to remember which source files are generated, see GenerateCache.
+	// Default is metagen.cache in headerOutputPath.
+	std::string cacheFile;
+
 	// prototype: bool (filename); return false to skip the file
 	cpgf::GSharedInterface<cpgf::IScriptFunction> fileCallback;
 
@@ -6,7 +6,6 @@
 #include "Poco/StringTokenizer.h"
 #include "Poco/RegularExpression.h"
 #include "Poco/Path.h"
-#include "Poco/File.h"
 #include "Poco/Glob.h"
 
 #include <iostream>
@@ -117,19 +116,6 @@ bool writeStringToFile(const std::string & fileName, const std::string & content
 	return true;
 }
 
-bool shouldTargetFileBeUpdated(const std::string & sourceFileName, const std::string & targetFileName)
-{
-	Poco::File targetFile(targetFileName);
-
-	if(! targetFile.exists()) {
-		return true;
-	}
-
-	Poco::File sourceFile(sourceFileName);
-	
-	return sourceFile.getLastModified() >= targetFile.getLastModified();
-}
-
 bool isFileContentSameToString(const std::string & fileName, const std::string & s)
 {
 	string content;
@@ -28,7 +28,6 @@ std::string normalizePath(const std::string & path);
 std::string makeRelativePath(const std::string & base, const std::string & path);
 bool readStringFromFile(const std::string & fileName, std::string * outContent);
 bool writeStringToFile(const std::string & fileName, const std::string & content);
-bool shouldTargetFileBeUpdated(const std::string & sourceFileName, const std::string & targetFileName);
 
 bool isFileAutoGenerated(const std::string & fileName);
 